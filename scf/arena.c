@@ -0,0 +1,79 @@
+#include "scf/arena.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+// block header rounded up so the first allocation is aligned too
+#define XYZ_SCF_ARENA_HEADER                               \
+  ((sizeof(XYZ_SCFArenaBlock) + XYZ_SCF_ARENA_ALIGN - 1) & \
+   ~(size_t)(XYZ_SCF_ARENA_ALIGN - 1))
+
+void XYZ_SCFArenaInit(XYZ_SCFArena* arena, size_t size_hint) {
+  SDL_assert(arena != NULL && "XYZ_SCFArenaInit: arena cannot be NULL");
+  *arena = (XYZ_SCFArena){
+      .head = NULL,
+      .next_size = SDL_max(size_hint, XYZ_SCF_ARENA_MIN_BLOCK),
+  };
+}
+
+void* XYZ_SCFArenaAlloc(XYZ_SCFArena* arena, size_t size) {
+  SDL_assert(arena != NULL && "XYZ_SCFArenaAlloc: arena cannot be NULL");
+  size = (size + XYZ_SCF_ARENA_ALIGN - 1) & ~(size_t)(XYZ_SCF_ARENA_ALIGN - 1);
+
+  XYZ_SCFArenaBlock* block = arena->head;
+  if (block == NULL || block->size - block->used < size) {
+    // blocks double in size so a document only needs a handful of them
+    size_t block_size = SDL_max(arena->next_size, size);
+    block = SDL_malloc(XYZ_SCF_ARENA_HEADER + block_size);
+    if (block == NULL) {
+      return NULL;
+    }
+
+    block->next = arena->head;
+    block->size = block_size;
+    block->used = 0;
+    arena->head = block;
+    arena->next_size = block_size * 2;
+  }
+
+  Uint8* ptr = (Uint8*)block + XYZ_SCF_ARENA_HEADER + block->used;
+  block->used += size;
+  SDL_memset(ptr, 0, size);
+  return ptr;
+}
+
+void XYZ_SCFArenaMerge(XYZ_SCFArena* arena, XYZ_SCFArena* other) {
+  SDL_assert(arena != NULL && "XYZ_SCFArenaMerge: arena cannot be NULL");
+  SDL_assert(other != NULL && "XYZ_SCFArenaMerge: other cannot be NULL");
+  if (other->head == NULL) {
+    return;
+  }
+
+  if (arena->head == NULL) {
+    arena->head = other->head;
+    other->head = NULL;
+    return;
+  }
+
+  // keep allocating from the current head, the new blocks go right after it
+  XYZ_SCFArenaBlock* tail = other->head;
+  while (tail->next != NULL) {
+    tail = tail->next;
+  }
+  tail->next = arena->head->next;
+  arena->head->next = other->head;
+  other->head = NULL;
+}
+
+void XYZ_SCFArenaDestroy(XYZ_SCFArena* arena) {
+  SDL_assert(arena != NULL && "XYZ_SCFArenaDestroy: arena cannot be NULL");
+  XYZ_SCFArenaBlock* cur = arena->head;
+  XYZ_SCFArenaBlock* tmp = NULL;
+  while (cur != NULL) {
+    tmp = cur->next;
+    SDL_free(cur);
+    cur = tmp;
+  }
+  arena->head = NULL;
+}
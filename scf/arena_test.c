@@ -0,0 +1,64 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/arena.h>
+
+static void arena_alloc(void** state) {
+  (void)state;
+
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  assert_null(arena.head);
+
+  Uint8* a = XYZ_SCFArenaAlloc(&arena, 3);
+  Uint8* b = XYZ_SCFArenaAlloc(&arena, 40);
+  assert_non_null(a);
+  assert_non_null(b);
+  assert_int_equal((uintptr_t)a % XYZ_SCF_ARENA_ALIGN, 0);
+  assert_int_equal((uintptr_t)b % XYZ_SCF_ARENA_ALIGN, 0);
+  assert_ptr_equal(b, a + XYZ_SCF_ARENA_ALIGN);
+  assert_int_equal(b[39], 0);
+  assert_null(arena.head->next);
+
+  XYZ_SCFArenaDestroy(&arena);
+  assert_null(arena.head);
+}
+
+static void arena_grow(void** state) {
+  (void)state;
+
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+
+  // allocations bigger than a block get a block of their own
+  assert_non_null(XYZ_SCFArenaAlloc(&arena, 16));
+  assert_non_null(XYZ_SCFArenaAlloc(&arena, XYZ_SCF_ARENA_MIN_BLOCK * 3));
+  assert_non_null(arena.head->next);
+  assert_true(arena.head->size >= XYZ_SCF_ARENA_MIN_BLOCK * 3);
+
+  // and block sizes keep doubling, 640k take a handful of blocks
+  size_t blocks = 0;
+  for (Sint32 i = 0; i < 10000; i++) {
+    assert_non_null(XYZ_SCFArenaAlloc(&arena, 64));
+  }
+  for (XYZ_SCFArenaBlock* cur = arena.head; cur != NULL; cur = cur->next) {
+    blocks++;
+  }
+  assert_true(blocks <= 8);
+
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(arena_alloc),
+      cmocka_unit_test(arena_grow),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,99 @@
+#include <scf/scf.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_COUNT (256 * 1024)
+#define BENCH_ROUNDS 5
+
+// BENCH_COUNT floats, either as the keys of a block or as one array
+char* generate(bool array, size_t* out_len);
+// sum of the floats of a document made by generate
+float sum(XYZ_SCFTable* root, bool array);
+// best of BENCH_ROUNDS parses and reads of the document made by generate
+void run(const char* name, bool array);
+
+char* generate(bool array, size_t* out_len) {
+  size_t cap = (size_t)BENCH_COUNT * 24 + 64;
+  char* data = SDL_malloc(cap);
+  if (data == NULL) {
+    return NULL;
+  }
+
+  size_t len = SDL_snprintf(data, cap, array ? "values = [" : "values {");
+  for (Sint32 i = 0; i < BENCH_COUNT; i++) {
+    float value = (float)(i % 1000) * 0.125f;
+    len += array ? SDL_snprintf(data + len, cap - len, " %.3f", value)
+                 : SDL_snprintf(data + len, cap - len, " v%d = %.3f", i, value);
+  }
+  len += SDL_snprintf(data + len, cap - len, array ? " ]\n" : " }\n");
+  *out_len = len;
+  return data;
+}
+
+float sum(XYZ_SCFTable* root, bool array) {
+  float total = 0.0f;
+  if (array) {
+    const float* values = NULL;
+    size_t count = 0;
+    if (XYZ_SCFTableGetF32Array(root, "values", &values, &count)) {
+      for (size_t i = 0; i < count; i++) {
+        total += values[i];
+      }
+    }
+    return total;
+  }
+
+  XYZ_SCFTable* values = NULL;
+  if (XYZ_SCFTableGetTable(root, "values", &values)) {
+    XYZ_SCFCursor cursor = XYZ_SCFTableCursor(values);
+    while (XYZ_SCFCursorNext(&cursor)) {
+      total += cursor.pair->value.as_f32;
+    }
+  }
+  return total;
+}
+
+void run(const char* name, bool array) {
+  size_t len = 0;
+  char* data = generate(array, &len);
+  if (data == NULL) {
+    return;
+  }
+
+  double parse = 0.0;
+  double read = 0.0;
+  float total = 0.0f;
+  for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    XYZ_SCFDocument* doc = XYZ_SCFParseDocument(data, len, 0);
+    double parsed = bench_elapsed(start);
+    if (doc == NULL) {
+      SDL_Log("parse failed: %s", SDL_GetError());
+      break;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    total = sum(doc->root, array);
+    double summed = bench_elapsed(start);
+    XYZ_SCFDocumentDestroy(doc);
+
+    parse = round == 0 ? parsed : SDL_min(parse, parsed);
+    read = round == 0 ? summed : SDL_min(read, summed);
+  }
+
+  SDL_Log("%-6s %8.1f KB: parse %8.2f ms, read %8.3f ms (sum %.1f)", name,
+          len / 1024.0, parse * 1e3, read * 1e3, total);
+  SDL_free(data);
+}
+
+int main(void) {
+  run("keys", false);
+  run("array", true);
+  XYZ_SCFAtomsQuit();
+  return 0;
+}
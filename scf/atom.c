@@ -0,0 +1,233 @@
+#include "scf/atom.h"
+#include "scf/arena.h"
+#include "scf/table.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+#define XYZ_SCF_ATOM_BLOCK 1024  // entries per block
+#define XYZ_SCF_ATOM_MAX_BLOCKS (XYZ_SCF_ATOM_MAX / XYZ_SCF_ATOM_BLOCK)
+#define XYZ_SCF_ATOM_MIN_SLOTS 256
+#define XYZ_SCF_ATOM_ARENA_HINT 16384
+
+typedef struct {
+  const char* key;
+  Uint32 key_len;
+  Uint32 hash;
+} atom_entry;
+
+// slot of the index, atom is only set once hash and the entry are there
+typedef struct {
+  Uint32 hash;
+  SDL_AtomicU32 atom;
+} atom_slot;
+
+// open addressing index over the entries
+typedef struct {
+  Uint32 slot_count;
+  atom_slot slots[];
+} atom_index;
+
+typedef struct {
+  // taken to add atoms only, lookups go through the published index
+  SDL_SpinLock lock;
+
+  // keys, entry blocks and every index so far, none moves or goes away
+  // before XYZ_SCFAtomsQuit so all of them can be read without the lock
+  XYZ_SCFArena arena;
+  atom_entry* blocks[XYZ_SCF_ATOM_MAX_BLOCKS];
+  Uint32 count;
+  size_t bytes;
+
+  // atom_index*, only accessed atomically
+  void* index;
+} atom_table;
+
+static atom_table atoms;
+
+// entry of an atom handed out before
+atom_entry* atom_entry_of(XYZ_SCFAtom atom);
+// slot of key in index, either holding its atom or the empty one it would
+// go to; NULL before the first atom. Safe without the lock
+atom_slot* atom_lookup(atom_index* index,
+                       const char* key,
+                       size_t key_len,
+                       Uint32 hash);
+// publish a twice as large index, readers may still be in the old one
+atom_index* atom_grow_index(atom_index* index);
+// copy key and give it the next atom
+XYZ_SCFAtom atom_add(const char* key, size_t key_len, Uint32 hash);
+
+XYZ_SCFAtom XYZ_SCFAtomIntern(const char* key, size_t key_len, Uint32 hash) {
+  SDL_assert(key != NULL && "XYZ_SCFAtomIntern: key cannot be NULL");
+
+  XYZ_SCFAtom atom = XYZ_SCFAtomFind(key, key_len, hash);
+  if (atom != XYZ_SCF_NO_ATOM) {
+    return atom;
+  }
+
+  // another thread may have added it since, look again under the lock
+  SDL_LockSpinlock(&atoms.lock);
+  atom = XYZ_SCFAtomFind(key, key_len, hash);
+  if (atom == XYZ_SCF_NO_ATOM) {
+    atom = atom_add(key, key_len, hash);
+  }
+  SDL_UnlockSpinlock(&atoms.lock);
+  return atom;
+}
+
+XYZ_SCFAtom XYZ_SCFAtomFind(const char* key, size_t key_len, Uint32 hash) {
+  SDL_assert(key != NULL && "XYZ_SCFAtomFind: key cannot be NULL");
+
+  atom_slot* slot =
+      atom_lookup(SDL_GetAtomicPointer(&atoms.index), key, key_len, hash);
+  return slot != NULL ? SDL_GetAtomicU32(&slot->atom) : XYZ_SCF_NO_ATOM;
+}
+
+const char* XYZ_SCFAtomKey(XYZ_SCFAtom atom, Uint32* key_len, Uint32* hash) {
+  SDL_assert(atom != XYZ_SCF_NO_ATOM && "XYZ_SCFAtomKey: atom cannot be none");
+
+  atom_entry* entry = atom_entry_of(atom);
+  if (key_len != NULL) {
+    *key_len = entry->key_len;
+  }
+  if (hash != NULL) {
+    *hash = entry->hash;
+  }
+  return entry->key;
+}
+
+Uint32 XYZ_SCFAtomCount(void) {
+  SDL_LockSpinlock(&atoms.lock);
+  Uint32 count = atoms.count;
+  SDL_UnlockSpinlock(&atoms.lock);
+  return count;
+}
+
+size_t XYZ_SCFAtomBytes(void) {
+  SDL_LockSpinlock(&atoms.lock);
+  size_t bytes = atoms.bytes;
+  SDL_UnlockSpinlock(&atoms.lock);
+  return bytes;
+}
+
+void XYZ_SCFAtomsQuit(void) {
+  SDL_LockSpinlock(&atoms.lock);
+  SDL_SetAtomicPointer(&atoms.index, NULL);
+  XYZ_SCFArenaDestroy(&atoms.arena);
+  SDL_memset(atoms.blocks, 0, sizeof(atoms.blocks));
+  atoms.count = 0;
+  atoms.bytes = 0;
+  SDL_UnlockSpinlock(&atoms.lock);
+}
+
+atom_entry* atom_entry_of(XYZ_SCFAtom atom) {
+  Uint32 index = atom - 1;
+  return &atoms.blocks[index / XYZ_SCF_ATOM_BLOCK]
+                      [index % XYZ_SCF_ATOM_BLOCK];
+}
+
+atom_slot* atom_lookup(atom_index* index,
+                       const char* key,
+                       size_t key_len,
+                       Uint32 hash) {
+  if (index == NULL) {
+    return NULL;
+  }
+
+  Uint32 mask = index->slot_count - 1;
+  for (Uint32 i = hash & mask;; i = (i + 1) & mask) {
+    atom_slot* slot = &index->slots[i];
+    XYZ_SCFAtom atom = SDL_GetAtomicU32(&slot->atom);
+    if (atom == XYZ_SCF_NO_ATOM) {
+      return slot;
+    }
+
+    if (slot->hash == hash) {
+      atom_entry* entry = atom_entry_of(atom);
+      if (entry->key_len == key_len &&
+          SDL_memcmp(entry->key, key, key_len) == 0) {
+        return slot;
+      }
+    }
+  }
+}
+
+atom_index* atom_grow_index(atom_index* index) {
+  Uint32 old_count = index != NULL ? index->slot_count : 0;
+  Uint32 slot_count = SDL_max(old_count * 2, XYZ_SCF_ATOM_MIN_SLOTS);
+  size_t size = sizeof(atom_index) + slot_count * sizeof(atom_slot);
+  atom_index* grown = XYZ_SCFArenaAlloc(&atoms.arena, size);
+  if (grown == NULL) {
+    return NULL;
+  }
+  grown->slot_count = slot_count;
+
+  // every atom is distinct, each one goes to the first free slot
+  Uint32 mask = slot_count - 1;
+  for (Uint32 i = 0; i < old_count; i++) {
+    atom_slot* slot = &index->slots[i];
+    if (SDL_GetAtomicU32(&slot->atom) == XYZ_SCF_NO_ATOM) {
+      continue;
+    }
+
+    Uint32 j = slot->hash & mask;
+    while (SDL_GetAtomicU32(&grown->slots[j].atom) != XYZ_SCF_NO_ATOM) {
+      j = (j + 1) & mask;
+    }
+    grown->slots[j] = *slot;
+  }
+
+  // the old index stays in the arena for readers that are still in it
+  atoms.bytes += size;
+  SDL_SetAtomicPointer(&atoms.index, grown);
+  return grown;
+}
+
+XYZ_SCFAtom atom_add(const char* key, size_t key_len, Uint32 hash) {
+  if (atoms.count == XYZ_SCF_ATOM_MAX) {
+    SDL_SetError("too many atoms");
+    return XYZ_SCF_NO_ATOM;
+  }
+
+  if (atoms.arena.next_size == 0) {
+    XYZ_SCFArenaInit(&atoms.arena, XYZ_SCF_ATOM_ARENA_HINT);
+  }
+
+  atom_index* index = SDL_GetAtomicPointer(&atoms.index);
+  if (index == NULL || (atoms.count + 1) * 2 > index->slot_count) {
+    index = atom_grow_index(index);
+    if (index == NULL) {
+      return XYZ_SCF_NO_ATOM;
+    }
+  }
+
+  Uint32 block = atoms.count / XYZ_SCF_ATOM_BLOCK;
+  if (atoms.blocks[block] == NULL) {
+    size_t size = XYZ_SCF_ATOM_BLOCK * sizeof(atom_entry);
+    atoms.blocks[block] = XYZ_SCFArenaAlloc(&atoms.arena, size);
+    if (atoms.blocks[block] == NULL) {
+      return XYZ_SCF_NO_ATOM;
+    }
+    atoms.bytes += size;
+  }
+
+  char* copy = XYZ_SCFArenaAlloc(&atoms.arena, key_len + 1);
+  if (copy == NULL) {
+    return XYZ_SCF_NO_ATOM;
+  }
+  SDL_memcpy(copy, key, key_len);
+  copy[key_len] = '\0';
+  atoms.bytes += key_len + 1;
+
+  XYZ_SCFAtom atom = ++atoms.count;
+  *atom_entry_of(atom) = (atom_entry){copy, (Uint32)key_len, hash};
+
+  // readers see the atom only once its entry and the slot hash are there
+  atom_slot* slot = atom_lookup(index, key, key_len, hash);
+  slot->hash = hash;
+  SDL_SetAtomicU32(&slot->atom, atom);
+  return atom;
+}
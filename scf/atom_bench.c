@@ -0,0 +1,95 @@
+#include <scf/scf.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_SIZE (4 * 1024 * 1024)
+#define BENCH_DOCS 8
+#define BENCH_ROUNDS 5
+
+// bytes the keys of table would take copied into a document arena
+size_t key_bytes(XYZ_SCFTable* table);
+// best of BENCH_ROUNDS comparisons of two documents parsed with flags
+double compare(const char* data, size_t len, Uint32 flags);
+
+size_t key_bytes(XYZ_SCFTable* table) {
+  size_t bytes = 0;
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    size_t len = cursor.pair->key_len + XYZ_SCF_ARENA_ALIGN;
+    bytes += len & ~(size_t)(XYZ_SCF_ARENA_ALIGN - 1);
+    if (cursor.pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+      bytes += key_bytes(cursor.pair->value.as_table);
+    }
+  }
+  return bytes;
+}
+
+double compare(const char* data, size_t len, Uint32 flags) {
+  XYZ_SCFDocument* a = XYZ_SCFParseDocument(data, len, flags);
+  XYZ_SCFDocument* b = XYZ_SCFParseDocument(data, len, flags);
+  if (a == NULL || b == NULL) {
+    SDL_Log("parse failed: %s", SDL_GetError());
+    return 0.0;
+  }
+
+  double best = 0.0;
+  for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    bool equal = XYZ_SCFTableEqual(a->root, b->root);
+    double elapsed = bench_elapsed(start);
+    if (!equal) {
+      SDL_Log("documents differ");
+    }
+    best = round == 0 ? elapsed : SDL_min(best, elapsed);
+  }
+
+  XYZ_SCFDocumentDestroy(b);
+  XYZ_SCFDocumentDestroy(a);
+  return best;
+}
+
+int main(void) {
+  size_t len = 0;
+  char* data = bench_generate_config(BENCH_SIZE, &len);
+  if (data == NULL) {
+    return 1;
+  }
+
+  // the same settings loaded over and over, as with reloads and layers
+  XYZ_SCFDocument* docs[BENCH_DOCS] = {0};
+  size_t copied = 0;
+  Uint64 start = SDL_GetPerformanceCounter();
+  for (Sint32 i = 0; i < BENCH_DOCS; i++) {
+    docs[i] = XYZ_SCFParseDocument(data, len, XYZ_SCF_PARSE_INTERN_KEYS);
+    if (docs[i] == NULL) {
+      SDL_Log("parse failed: %s", SDL_GetError());
+      return 1;
+    }
+  }
+  double parsed = bench_elapsed(start);
+  for (Sint32 i = 0; i < BENCH_DOCS; i++) {
+    copied += key_bytes(docs[i]->root);
+    XYZ_SCFDocumentDestroy(docs[i]);
+  }
+
+  SDL_Log("%d documents of %.1f MB: %8.1f MB/s, keys copied %8.1f KB, "
+          "interned %6.1f KB (%u atoms)",
+          BENCH_DOCS, len / 1048576.0,
+          BENCH_DOCS * len / 1048576.0 / parsed, copied / 1024.0,
+          XYZ_SCFAtomBytes() / 1024.0, XYZ_SCFAtomCount());
+
+  // same comparison on views, where every key match compares the strings
+  double atoms = compare(data, len, XYZ_SCF_PARSE_INTERN_KEYS);
+  double views = compare(data, len, XYZ_SCF_PARSE_ZERO_COPY);
+  SDL_Log("equal: atoms %8.2f ms, strings %8.2f ms", atoms * 1e3,
+          views * 1e3);
+
+  SDL_free(data);
+  XYZ_SCFAtomsQuit();
+  return 0;
+}
@@ -0,0 +1,181 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/atom.h>
+#include <scf/scf.h>
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_thread.h>
+
+#define THREAD_COUNT 4
+#define THREAD_KEYS 4000
+
+static XYZ_SCFAtom intern(const char* key) {
+  size_t len = SDL_strlen(key);
+  return XYZ_SCFAtomIntern(key, len, XYZ_SCFHashKey(key, len));
+}
+
+static void atom_intern(void** state) {
+  (void)state;
+
+  Uint32 count = XYZ_SCFAtomCount();
+  XYZ_SCFAtom width = intern("width");
+  XYZ_SCFAtom height = intern("height");
+  assert_int_not_equal(width, XYZ_SCF_NO_ATOM);
+  assert_int_not_equal(height, XYZ_SCF_NO_ATOM);
+  assert_int_not_equal(width, height);
+  assert_int_equal(intern("width"), width);
+  assert_int_equal(XYZ_SCFAtomCount(), count + 2);
+
+  // keys need not be null terminated, the interned copy is
+  assert_int_equal(XYZ_SCFAtomIntern("widths", 5, XYZ_SCFHashKey("width", 5)),
+                   width);
+  Uint32 key_len = 0;
+  Uint32 hash = 0;
+  const char* key = XYZ_SCFAtomKey(width, &key_len, &hash);
+  assert_string_equal(key, "width");
+  assert_int_equal(key_len, 5);
+  assert_int_equal(hash, XYZ_SCFHashKey("width", 5));
+
+  assert_int_equal(XYZ_SCFAtomFind("height", 6, XYZ_SCFHashKey("height", 6)),
+                   height);
+  assert_int_equal(XYZ_SCFAtomFind("depth", 5, XYZ_SCFHashKey("depth", 5)),
+                   XYZ_SCF_NO_ATOM);
+  assert_int_equal(XYZ_SCFAtomCount(), count + 2);
+}
+
+static void atom_grow(void** state) {
+  (void)state;
+
+  // enough keys for the index to grow and a second block of entries
+  XYZ_SCFAtom atoms[3000];
+  char key[32];
+  for (Sint32 i = 0; i < 3000; i++) {
+    SDL_snprintf(key, sizeof(key), "key_%d", i);
+    atoms[i] = intern(key);
+    assert_int_not_equal(atoms[i], XYZ_SCF_NO_ATOM);
+  }
+
+  for (Sint32 i = 0; i < 3000; i++) {
+    SDL_snprintf(key, sizeof(key), "key_%d", i);
+    assert_int_equal(intern(key), atoms[i]);
+    assert_string_equal(XYZ_SCFAtomKey(atoms[i], NULL, NULL), key);
+  }
+  assert_true(XYZ_SCFAtomBytes() > 3000 * sizeof("key_0"));
+}
+
+typedef struct {
+  Sint32 first;  // of the keys, each thread starts at a different one
+  XYZ_SCFAtom atoms[THREAD_KEYS];
+} intern_job;
+
+static int intern_keys(void* data) {
+  intern_job* job = data;
+  char key[32];
+  for (Sint32 i = 0; i < THREAD_KEYS; i++) {
+    Sint32 at = (job->first + i) % THREAD_KEYS;
+    SDL_snprintf(key, sizeof(key), "thread_%d", at);
+    job->atoms[at] = intern(key);
+  }
+  return 0;
+}
+
+static void atom_threads(void** state) {
+  (void)state;
+
+  // threads look keys up while others add them and grow the index
+  static intern_job jobs[THREAD_COUNT];
+  SDL_Thread* threads[THREAD_COUNT];
+  for (Sint32 i = 0; i < THREAD_COUNT; i++) {
+    jobs[i].first = i * THREAD_KEYS / THREAD_COUNT;
+    threads[i] = SDL_CreateThread(intern_keys, "intern_keys", &jobs[i]);
+    assert_non_null(threads[i]);
+  }
+  for (Sint32 i = 0; i < THREAD_COUNT; i++) {
+    SDL_WaitThread(threads[i], NULL);
+  }
+
+  char key[32];
+  for (Sint32 i = 0; i < THREAD_KEYS; i++) {
+    SDL_snprintf(key, sizeof(key), "thread_%d", i);
+    assert_int_not_equal(jobs[0].atoms[i], XYZ_SCF_NO_ATOM);
+    assert_string_equal(XYZ_SCFAtomKey(jobs[0].atoms[i], NULL, NULL), key);
+    for (Sint32 j = 1; j < THREAD_COUNT; j++) {
+      assert_int_equal(jobs[j].atoms[i], jobs[0].atoms[i]);
+    }
+  }
+}
+
+static void atom_documents(void** state) {
+  (void)state;
+
+  const char* src = "video { width = 1280 height = 720 } name = \"hero\"";
+  Uint32 flags = XYZ_SCF_PARSE_INTERN_KEYS;
+  XYZ_SCFDocument* a = XYZ_SCFParseDocument(src, SDL_strlen(src), flags);
+  XYZ_SCFDocument* b = XYZ_SCFParseDocument(src, SDL_strlen(src), flags);
+  assert_non_null(a);
+  assert_non_null(b);
+
+  // both documents share the interned keys
+  XYZ_SCFPair* pa = &a->root->pairs[0];
+  XYZ_SCFPair* pb = &b->root->pairs[0];
+  assert_true(pa->flags & XYZ_SCF_PAIR_FLAG_KEY_ATOM);
+  assert_int_not_equal(pa->key_atom, XYZ_SCF_NO_ATOM);
+  assert_int_equal(pa->key_atom, pb->key_atom);
+  assert_ptr_equal(pa->key, pb->key);
+  assert_true(XYZ_SCFTableEqual(a->root, b->root));
+
+  XYZ_SCFAtom name = intern("name");
+  XYZ_SCFPair* pair = XYZ_SCFTableFindAtom(b->root, name);
+  assert_non_null(pair);
+  assert_string_equal(pair->value.as_string, "hero");
+  assert_null(XYZ_SCFTableFindAtom(b->root, intern("missing")));
+
+  // tables mixing interned and copied keys still find each other
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = 3};
+  assert_true(XYZ_SCFTableSet(table, "name", value));
+  assert_non_null(XYZ_SCFTableFindAtom(table, name));
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+
+  // zero copy documents keep their keys in the data, even when asked to
+  // intern them
+  XYZ_SCFDocument* view = XYZ_SCFParseDocument(
+      src, SDL_strlen(src), XYZ_SCF_PARSE_ZERO_COPY | flags);
+  assert_non_null(view);
+  assert_int_equal(view->root->pairs[0].key_atom, XYZ_SCF_NO_ATOM);
+  assert_true(XYZ_SCFTableEqual(a->root, view->root));
+  assert_non_null(XYZ_SCFTableFindAtom(view->root, name));
+
+  // and keys are copied unless asked otherwise
+  XYZ_SCFDocument* copy = XYZ_SCFParseDocument(src, SDL_strlen(src), 0);
+  assert_non_null(copy);
+  assert_int_equal(copy->root->pairs[0].key_atom, XYZ_SCF_NO_ATOM);
+  assert_false(copy->root->pairs[0].flags & XYZ_SCF_PAIR_FLAG_KEY_ATOM);
+  assert_true(XYZ_SCFTableEqual(a->root, copy->root));
+  assert_non_null(XYZ_SCFTableFindAtom(copy->root, name));
+
+  XYZ_SCFDocumentDestroy(copy);
+  XYZ_SCFDocumentDestroy(view);
+  XYZ_SCFDocumentDestroy(b);
+  XYZ_SCFDocumentDestroy(a);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(atom_intern),
+      cmocka_unit_test(atom_grow),
+      cmocka_unit_test(atom_threads),
+      cmocka_unit_test(atom_documents),
+  };
+
+  int failed = cmocka_run_group_tests(tests, NULL, NULL);
+  XYZ_SCFAtomsQuit();
+  return failed;
+}
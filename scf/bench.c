@@ -0,0 +1,55 @@
+#include "bench.h"
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+// one top level block, about 1k of text
+#define BENCH_BLOCK_MAX 2048
+
+size_t bench_block(char* dst, size_t cap, Sint32 n);
+
+char* bench_generate_config(size_t target_len, size_t* out_len) {
+  char* data = SDL_malloc(target_len + BENCH_BLOCK_MAX + 1);
+  if (data == NULL) {
+    return NULL;
+  }
+
+  size_t len = 0;
+  for (Sint32 n = 0; len < target_len; n++) {
+    len += bench_block(data + len, BENCH_BLOCK_MAX, n);
+  }
+  data[len] = '\0';
+  *out_len = len;
+  return data;
+}
+
+double bench_elapsed(Uint64 start) {
+  Uint64 now = SDL_GetPerformanceCounter();
+  return (double)(now - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+size_t bench_block(char* dst, size_t cap, Sint32 n) {
+  return SDL_snprintf(
+      dst, cap,
+      "level_%d {\n"
+      "    name = \"Level %d: the long and winding road to the castle\"\n"
+      "    enabled = true\n"
+      "    difficulty = %d\n"
+      "    gravity = -9.81\n"
+      "    spawn {\n"
+      "        x = %d\n"
+      "        y = %d\n"
+      "        angle = 0.25\n"
+      "    }\n"
+      "    music {\n"
+      "        track = \"music/level_%d/theme_loop_extended_mix.ogg\"\n"
+      "        volume = 0.8\n"
+      "        fade_in = 1.5\n"
+      "    }\n"
+      "    description = \"Collect every gem before the timer runs out, "
+      "avoid the guards and find the hidden exit behind the waterfall.\"\n"
+      "    par_time = %d\n"
+      "    next = nil\n"
+      "}\n",
+      n, n, n % 10, n * 16, -n * 8, n, 60 + n % 120);
+}
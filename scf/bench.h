@@ -0,0 +1,18 @@
+#ifndef XYZ_SCF_BENCH_H
+#define XYZ_SCF_BENCH_H
+
+#include <SDL3/SDL_stdinc.h>
+
+/**
+ * Generates a synthetic config of about target_len bytes mixing nested
+ * blocks, indentation, integers, floats, words and long strings. The result
+ * is null terminated and must be released with SDL_free.
+ */
+char* bench_generate_config(size_t target_len, size_t* out_len);
+
+/**
+ * Seconds elapsed since start (a SDL_GetPerformanceCounter value).
+ */
+double bench_elapsed(Uint64 start);
+
+#endif /* XYZ_SCF_BENCH_H */
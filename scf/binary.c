@@ -0,0 +1,680 @@
+#include "scf/binary.h"
+#include "scf/table.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_stdinc.h>
+
+#define XYZ_SCF_BINARY_NONE SDL_UINT32_MAX
+
+// string pool being written, strings are deduplicated through an open
+// addressing index of pool offsets
+typedef struct {
+  char* data;
+  size_t len;
+  size_t cap;
+  Uint32* slots;
+  Uint32 slot_count;
+  Uint32 string_count;
+} bin_pool;
+
+// array pool being written, elements of each array start 4 byte aligned
+typedef struct {
+  Uint8* data;
+  size_t len;
+  size_t cap;
+} bin_items;
+
+// add the nodes table takes to count, parsing lazy blocks on the way; false
+// if one of them fails to parse
+bool bin_count_nodes(XYZ_SCFTable* table, Uint32* count);
+// write the pairs of table at nodes[at...], tables[i] keeps the table behind
+// every table node so its children can be laid out later
+bool bin_fill(XYZ_SCFTable* table,
+              XYZ_SCFBinaryNode* nodes,
+              XYZ_SCFTable** tables,
+              Uint32 at,
+              bin_pool* pool,
+              bin_items* items);
+// intern str in the pool, returns its offset or XYZ_SCF_BINARY_NONE
+Uint32 bin_pool_add(bin_pool* pool, const char* str, size_t len);
+bool bin_pool_grow_index(bin_pool* pool);
+void bin_pool_destroy(bin_pool* pool);
+// bytes per element of an array node of type, 0 if it is not an array
+Uint32 bin_item_size(Uint32 type);
+// pack the elements of array into items, strings go to pool; returns their
+// offset or XYZ_SCF_BINARY_NONE
+Uint32 bin_items_add(bin_items* items,
+                     bin_pool* pool,
+                     const XYZ_SCFValue* array);
+bool bin_check_string(const XYZ_SCFBinary* binary, Uint32 offset, Uint32 len);
+bool bin_check_array(const XYZ_SCFBinary* binary,
+                     const XYZ_SCFBinaryNode* node);
+// elements of the array at key, empty arrays match any type
+bool bin_get_array(XYZ_SCFBinaryTable table,
+                   const char* key,
+                   Uint32 type,
+                   const void** values,
+                   size_t* count);
+
+void* XYZ_SCFTableToBinary(XYZ_SCFTable* table, size_t* out_len) {
+  SDL_assert(table != NULL && "XYZ_SCFTableToBinary: table cannot be NULL");
+  SDL_assert(out_len != NULL && "XYZ_SCFTableToBinary: out_len cannot be NULL");
+
+  Uint32 node_count = 0;
+  if (!bin_count_nodes(table, &node_count)) {
+    return NULL;
+  }
+
+  size_t nodes_size = node_count * sizeof(XYZ_SCFBinaryNode);
+  XYZ_SCFBinaryNode* nodes = SDL_malloc(SDL_max(nodes_size, 1));
+  XYZ_SCFTable** tables = SDL_malloc(SDL_max(node_count, 1) * sizeof(void*));
+  bin_pool pool = {0};
+  bin_items items = {0};
+  void* image = NULL;
+  if (nodes == NULL || tables == NULL) {
+    goto done;
+  }
+  SDL_memset(tables, 0, SDL_max(node_count, 1) * sizeof(void*));
+
+  // breadth first: root pairs first, then the children of each table node
+  // right after everything laid out so far
+  Uint32 root_count = XYZ_SCFTableCount(table);
+  if (!bin_fill(table, nodes, tables, 0, &pool, &items)) {
+    goto done;
+  }
+
+  Uint32 next = root_count;
+  for (Uint32 i = 0; i < next; i++) {
+    if (tables[i] == NULL) {
+      continue;
+    }
+
+    nodes[i].as_first = next;
+    if (!bin_fill(tables[i], nodes, tables, next, &pool, &items)) {
+      goto done;
+    }
+    next += nodes[i].len;
+  }
+
+  size_t arrays_len = (items.len + 3) & ~(size_t)3;
+  XYZ_SCFBinaryHeader header = {
+      .magic = XYZ_SCF_BINARY_MAGIC,
+      .version = XYZ_SCF_BINARY_VERSION,
+      .node_count = node_count,
+      .nodes_offset = sizeof(XYZ_SCFBinaryHeader),
+      .strings_offset =
+          (Uint32)(sizeof(XYZ_SCFBinaryHeader) + nodes_size + arrays_len),
+      .strings_len = (Uint32)pool.len,
+      .root_count = root_count,
+      .arrays_offset = (Uint32)(sizeof(XYZ_SCFBinaryHeader) + nodes_size),
+      .arrays_len = (Uint32)items.len,
+  };
+
+  size_t len = header.strings_offset + ((pool.len + 3) & ~(size_t)3);
+  image = SDL_malloc(len);
+  if (image == NULL) {
+    goto done;
+  }
+  SDL_memset(image, 0, len);
+  SDL_memcpy(image, &header, sizeof(header));
+  SDL_memcpy((Uint8*)image + header.nodes_offset, nodes, nodes_size);
+  if (items.len > 0) {
+    SDL_memcpy((Uint8*)image + header.arrays_offset, items.data, items.len);
+  }
+  if (pool.len > 0) {
+    SDL_memcpy((Uint8*)image + header.strings_offset, pool.data, pool.len);
+  }
+  *out_len = len;
+
+done:
+  SDL_free(nodes);
+  SDL_free(tables);
+  SDL_free(items.data);
+  bin_pool_destroy(&pool);
+  return image;
+}
+
+bool XYZ_SCFTableWriteBinary(XYZ_SCFTable* table, SDL_IOStream* io) {
+  SDL_assert(table != NULL && "XYZ_SCFTableWriteBinary: table cannot be NULL");
+  SDL_assert(io != NULL && "XYZ_SCFTableWriteBinary: io cannot be NULL");
+
+  size_t len = 0;
+  void* image = XYZ_SCFTableToBinary(table, &len);
+  if (image == NULL) {
+    return false;
+  }
+
+  bool written = SDL_WriteIO(io, image, len) == len;
+  SDL_free(image);
+  return written;
+}
+
+bool XYZ_SCFBinaryOpen(XYZ_SCFBinary* binary, const void* data, size_t len) {
+  SDL_assert(binary != NULL && "XYZ_SCFBinaryOpen: binary cannot be NULL");
+  SDL_assert(data != NULL && "XYZ_SCFBinaryOpen: data cannot be NULL");
+
+  const XYZ_SCFBinaryHeader* header = data;
+  if (len < sizeof(XYZ_SCFBinaryHeader) || ((uintptr_t)data & 3) != 0) {
+    SDL_SetError("binary config too short or misaligned");
+    return false;
+  }
+
+  if (header->magic != XYZ_SCF_BINARY_MAGIC) {
+    SDL_SetError("not a binary config (or wrong byte order)");
+    return false;
+  }
+
+  if (header->version != XYZ_SCF_BINARY_VERSION) {
+    SDL_SetError("unsupported binary config version: %u", header->version);
+    return false;
+  }
+
+  Uint64 nodes_end = (Uint64)header->nodes_offset +
+                     (Uint64)header->node_count * sizeof(XYZ_SCFBinaryNode);
+  Uint64 arrays_end =
+      (Uint64)header->arrays_offset + (Uint64)header->arrays_len;
+  Uint64 strings_end =
+      (Uint64)header->strings_offset + (Uint64)header->strings_len;
+  if ((header->nodes_offset & 3) != 0 || nodes_end > len ||
+      (header->arrays_offset & 3) != 0 || arrays_end > len ||
+      strings_end > len || header->root_count > header->node_count) {
+    SDL_SetError("binary config is truncated");
+    return false;
+  }
+
+  *binary = (XYZ_SCFBinary){
+      .header = header,
+      .nodes = (const XYZ_SCFBinaryNode*)((const Uint8*)data +
+                                          header->nodes_offset),
+      .arrays = (const Uint8*)data + header->arrays_offset,
+      .strings = (const char*)data + header->strings_offset,
+  };
+
+  // check everything once so lookups can trust the image, children always
+  // come after their parent which also rules out cycles
+  for (Uint32 i = 0; i < header->node_count; i++) {
+    const XYZ_SCFBinaryNode* node = &binary->nodes[i];
+    if (!bin_check_string(binary, node->key, node->key_len)) {
+      SDL_SetError("binary config has a bad key at node %u", i);
+      return false;
+    }
+
+    bool valid = true;
+    switch (node->type) {
+      case XYZ_SCF_VALUE_TYPE_NIL:
+      case XYZ_SCF_VALUE_TYPE_BOOL:
+      case XYZ_SCF_VALUE_TYPE_I32:
+      case XYZ_SCF_VALUE_TYPE_F32:
+        break;
+      case XYZ_SCF_VALUE_TYPE_STRING:
+        valid = bin_check_string(binary, node->as_string, node->len);
+        break;
+      case XYZ_SCF_VALUE_TYPE_TABLE:
+        valid = node->len == 0 ||
+                (node->as_first > i && node->as_first <= header->node_count &&
+                 node->len <= header->node_count - node->as_first);
+        break;
+      case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+      case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+      case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+      case XYZ_SCF_VALUE_TYPE_STRING_ARRAY:
+        valid = bin_check_array(binary, node);
+        break;
+      default:
+        valid = false;
+    }
+
+    if (!valid) {
+      SDL_SetError("binary config has a bad value at node %u", i);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+XYZ_SCFBinaryTable XYZ_SCFBinaryRoot(const XYZ_SCFBinary* binary) {
+  SDL_assert(binary != NULL && "XYZ_SCFBinaryRoot: binary cannot be NULL");
+  return (XYZ_SCFBinaryTable){
+      .binary = binary,
+      .first = 0,
+      .count = binary->header->root_count,
+  };
+}
+
+const XYZ_SCFBinaryNode* XYZ_SCFBinaryFind(XYZ_SCFBinaryTable table,
+                                           const char* key) {
+  SDL_assert(table.binary != NULL &&
+             "XYZ_SCFBinaryFind: table has no binary");
+  SDL_assert(key != NULL && "XYZ_SCFBinaryFind: key cannot be NULL");
+
+  size_t key_len = SDL_strlen(key);
+  Uint32 hash = XYZ_SCFHashKey(key, key_len);
+  const XYZ_SCFBinaryNode* cur = table.binary->nodes + table.first;
+  const XYZ_SCFBinaryNode* end = cur + table.count;
+  for (; cur < end; cur++) {
+    if (cur->key_hash == hash && cur->key_len == key_len &&
+        SDL_memcmp(table.binary->strings + cur->key, key, key_len) == 0) {
+      return cur;
+    }
+  }
+  return NULL;
+}
+
+bool XYZ_SCFBinaryHas(XYZ_SCFBinaryTable table, const char* key) {
+  return XYZ_SCFBinaryFind(table, key) != NULL;
+}
+
+bool XYZ_SCFBinaryGetBool(XYZ_SCFBinaryTable table,
+                          const char* key,
+                          bool* value) {
+  SDL_assert(value != NULL && "XYZ_SCFBinaryGetBool: value cannot be NULL");
+  const XYZ_SCFBinaryNode* node = XYZ_SCFBinaryFind(table, key);
+  if (node == NULL) {
+    return false;
+  }
+
+  if (node->type != XYZ_SCF_VALUE_TYPE_BOOL) {
+    SDL_SetError("incompatible type for key: %s", key);
+    return false;
+  }
+
+  *value = node->as_bool != 0;
+  return true;
+}
+
+bool XYZ_SCFBinaryGetI32(XYZ_SCFBinaryTable table,
+                         const char* key,
+                         Sint32* value) {
+  SDL_assert(value != NULL && "XYZ_SCFBinaryGetI32: value cannot be NULL");
+  const XYZ_SCFBinaryNode* node = XYZ_SCFBinaryFind(table, key);
+  if (node == NULL) {
+    return false;
+  }
+
+  if (node->type != XYZ_SCF_VALUE_TYPE_I32) {
+    SDL_SetError("incompatible type for key: %s", key);
+    return false;
+  }
+
+  *value = node->as_i32;
+  return true;
+}
+
+bool XYZ_SCFBinaryGetF32(XYZ_SCFBinaryTable table,
+                         const char* key,
+                         float* value) {
+  SDL_assert(value != NULL && "XYZ_SCFBinaryGetF32: value cannot be NULL");
+  const XYZ_SCFBinaryNode* node = XYZ_SCFBinaryFind(table, key);
+  if (node == NULL) {
+    return false;
+  }
+
+  if (node->type != XYZ_SCF_VALUE_TYPE_F32) {
+    SDL_SetError("incompatible type for key: %s", key);
+    return false;
+  }
+
+  *value = node->as_f32;
+  return true;
+}
+
+bool XYZ_SCFBinaryGetString(XYZ_SCFBinaryTable table,
+                            const char* key,
+                            const char** value) {
+  SDL_assert(value != NULL && "XYZ_SCFBinaryGetString: value cannot be NULL");
+  const XYZ_SCFBinaryNode* node = XYZ_SCFBinaryFind(table, key);
+  if (node == NULL) {
+    return false;
+  }
+
+  if (node->type != XYZ_SCF_VALUE_TYPE_STRING) {
+    SDL_SetError("incompatible type for key: %s", key);
+    return false;
+  }
+
+  *value = table.binary->strings + node->as_string;
+  return true;
+}
+
+bool XYZ_SCFBinaryGetTable(XYZ_SCFBinaryTable table,
+                           const char* key,
+                           XYZ_SCFBinaryTable* value) {
+  SDL_assert(value != NULL && "XYZ_SCFBinaryGetTable: value cannot be NULL");
+  const XYZ_SCFBinaryNode* node = XYZ_SCFBinaryFind(table, key);
+  if (node == NULL) {
+    return false;
+  }
+
+  if (node->type != XYZ_SCF_VALUE_TYPE_TABLE) {
+    SDL_SetError("incompatible type for key: %s", key);
+    return false;
+  }
+
+  *value = (XYZ_SCFBinaryTable){
+      .binary = table.binary,
+      .first = node->as_first,
+      .count = node->len,
+  };
+  return true;
+}
+
+bool XYZ_SCFBinaryGetBoolArray(XYZ_SCFBinaryTable table,
+                               const char* key,
+                               const bool** values,
+                               size_t* count) {
+  return bin_get_array(table, key, XYZ_SCF_VALUE_TYPE_BOOL_ARRAY,
+                       (const void**)values, count);
+}
+
+bool XYZ_SCFBinaryGetI32Array(XYZ_SCFBinaryTable table,
+                              const char* key,
+                              const Sint32** values,
+                              size_t* count) {
+  return bin_get_array(table, key, XYZ_SCF_VALUE_TYPE_I32_ARRAY,
+                       (const void**)values, count);
+}
+
+bool XYZ_SCFBinaryGetF32Array(XYZ_SCFBinaryTable table,
+                              const char* key,
+                              const float** values,
+                              size_t* count) {
+  return bin_get_array(table, key, XYZ_SCF_VALUE_TYPE_F32_ARRAY,
+                       (const void**)values, count);
+}
+
+bool XYZ_SCFBinaryGetStringArray(XYZ_SCFBinaryTable table,
+                                 const char* key,
+                                 const char** values,
+                                 size_t cap,
+                                 size_t* count) {
+  SDL_assert((values != NULL || cap == 0) &&
+             "XYZ_SCFBinaryGetStringArray: values cannot be NULL");
+  const Uint32* items = NULL;
+  if (!bin_get_array(table, key, XYZ_SCF_VALUE_TYPE_STRING_ARRAY,
+                     (const void**)&items, count)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < SDL_min(cap, *count); i++) {
+    values[i] = table.binary->strings + items[i * 2];
+  }
+  return true;
+}
+
+bool bin_count_nodes(XYZ_SCFTable* table, Uint32* count) {
+  // a lazy block that fails to parse is not written as an empty one
+  if (!XYZ_SCFTableExpand(table)) {
+    return false;
+  }
+
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    (*count)++;
+    if (cursor.pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE &&
+        !bin_count_nodes(cursor.pair->value.as_table, count)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool bin_fill(XYZ_SCFTable* table,
+              XYZ_SCFBinaryNode* nodes,
+              XYZ_SCFTable** tables,
+              Uint32 at,
+              bin_pool* pool,
+              bin_items* items) {
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+  for (; XYZ_SCFCursorNext(&cursor); at++) {
+    const XYZ_SCFPair* cur = cursor.pair;
+    XYZ_SCFBinaryNode* node = &nodes[at];
+    SDL_memset(node, 0, sizeof(XYZ_SCFBinaryNode));
+    node->key = bin_pool_add(pool, cur->key, cur->key_len);
+    node->key_len = cur->key_len;
+    node->key_hash = cur->key_hash;
+    node->type = cur->value.type;
+    if (node->key == XYZ_SCF_BINARY_NONE) {
+      return false;
+    }
+
+    switch (cur->value.type) {
+      case XYZ_SCF_VALUE_TYPE_BOOL:
+        node->as_bool = cur->value.as_bool ? 1 : 0;
+        break;
+      case XYZ_SCF_VALUE_TYPE_I32:
+        node->as_i32 = cur->value.as_i32;
+        break;
+      case XYZ_SCF_VALUE_TYPE_F32:
+        node->as_f32 = cur->value.as_f32;
+        break;
+      case XYZ_SCF_VALUE_TYPE_STRING:
+        node->len = (Uint32)XYZ_SCFPairStringLen(cur);
+        node->as_string = bin_pool_add(pool, cur->value.as_string, node->len);
+        if (node->as_string == XYZ_SCF_BINARY_NONE) {
+          return false;
+        }
+        break;
+      case XYZ_SCF_VALUE_TYPE_TABLE:
+        // as_first is assigned once the children get laid out
+        tables[at] = cur->value.as_table;
+        node->len = XYZ_SCFTableCount(cur->value.as_table);
+        break;
+      case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+      case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+      case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+      case XYZ_SCF_VALUE_TYPE_STRING_ARRAY:
+        node->len = cur->value.count;
+        node->as_items = bin_items_add(items, pool, &cur->value);
+        if (node->as_items == XYZ_SCF_BINARY_NONE) {
+          return false;
+        }
+        break;
+      case XYZ_SCF_VALUE_TYPE_NIL:
+        break;
+    }
+  }
+  return true;
+}
+
+Uint32 bin_pool_add(bin_pool* pool, const char* str, size_t len) {
+  if ((pool->string_count + 1) * 2 > pool->slot_count &&
+      !bin_pool_grow_index(pool)) {
+    return XYZ_SCF_BINARY_NONE;
+  }
+
+  Uint32 hash = XYZ_SCFHashKey(str, len);
+  Uint32 mask = pool->slot_count - 1;
+  Uint32 i = hash & mask;
+  for (; pool->slots[i] != XYZ_SCF_BINARY_NONE; i = (i + 1) & mask) {
+    const char* other = pool->data + pool->slots[i];
+    if (SDL_strncmp(other, str, len) == 0 && other[len] == '\0') {
+      return pool->slots[i];
+    }
+  }
+
+  if (pool->len + len + 1 > pool->cap) {
+    size_t cap = SDL_max(pool->cap * 2, pool->len + len + 1);
+    cap = SDL_max(cap, 256);
+    char* data = SDL_realloc(pool->data, cap);
+    if (data == NULL) {
+      return XYZ_SCF_BINARY_NONE;
+    }
+    pool->data = data;
+    pool->cap = cap;
+  }
+
+  Uint32 offset = (Uint32)pool->len;
+  SDL_memcpy(pool->data + offset, str, len);
+  pool->data[offset + len] = '\0';
+  pool->len += len + 1;
+  pool->slots[i] = offset;
+  pool->string_count++;
+  return offset;
+}
+
+bool bin_pool_grow_index(bin_pool* pool) {
+  Uint32 slot_count = SDL_max(pool->slot_count * 2, 64);
+  Uint32* slots = SDL_malloc(slot_count * sizeof(Uint32));
+  if (slots == NULL) {
+    return false;
+  }
+  SDL_memset(slots, 0xFF, slot_count * sizeof(Uint32));
+
+  // re-insert every pooled string, the pool is a run of null terminated ones
+  Uint32 mask = slot_count - 1;
+  for (size_t offset = 0; offset < pool->len;) {
+    size_t len = SDL_strlen(pool->data + offset);
+    Uint32 i = XYZ_SCFHashKey(pool->data + offset, len) & mask;
+    while (slots[i] != XYZ_SCF_BINARY_NONE) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = (Uint32)offset;
+    offset += len + 1;
+  }
+
+  SDL_free(pool->slots);
+  pool->slots = slots;
+  pool->slot_count = slot_count;
+  return true;
+}
+
+void bin_pool_destroy(bin_pool* pool) {
+  SDL_free(pool->data);
+  SDL_free(pool->slots);
+  SDL_memset(pool, 0, sizeof(bin_pool));
+}
+
+bool bin_check_string(const XYZ_SCFBinary* binary, Uint32 offset, Uint32 len) {
+  Uint64 end = (Uint64)offset + len;
+  return end < binary->header->strings_len && binary->strings[end] == '\0';
+}
+
+Uint32 bin_item_size(Uint32 type) {
+  switch (type) {
+    case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+      return 1;
+    case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+      return sizeof(Sint32);
+    case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+      return sizeof(float);
+    case XYZ_SCF_VALUE_TYPE_STRING_ARRAY:
+      return 2 * sizeof(Uint32);
+    default:
+      return 0;
+  }
+}
+
+Uint32 bin_items_add(bin_items* items,
+                     bin_pool* pool,
+                     const XYZ_SCFValue* array) {
+  if (array->count == 0) {
+    return 0;
+  }
+
+  size_t offset = (items->len + 3) & ~(size_t)3;
+  size_t size = (size_t)array->count * bin_item_size(array->type);
+  if (offset + size > SDL_UINT32_MAX) {
+    SDL_SetError("binary config arrays are too large");
+    return XYZ_SCF_BINARY_NONE;
+  }
+
+  if (offset + size > items->cap) {
+    size_t cap = SDL_max(items->cap * 2, offset + size);
+    cap = SDL_max(cap, 256);
+    Uint8* data = SDL_realloc(items->data, cap);
+    if (data == NULL) {
+      return XYZ_SCF_BINARY_NONE;
+    }
+    items->data = data;
+    items->cap = cap;
+  }
+  SDL_memset(items->data + items->len, 0, offset - items->len);
+
+  Uint8* dst = items->data + offset;
+  for (Uint32 i = 0; i < array->count; i++) {
+    switch (array->type) {
+      case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+        dst[i] = array->as_bools[i] ? 1 : 0;
+        break;
+      case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+        SDL_memcpy(dst + i * sizeof(Sint32), &array->as_i32s[i],
+                   sizeof(Sint32));
+        break;
+      case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+        SDL_memcpy(dst + i * sizeof(float), &array->as_f32s[i],
+                   sizeof(float));
+        break;
+      case XYZ_SCF_VALUE_TYPE_STRING_ARRAY: {
+        const char* str = array->as_strings[i];
+        Uint32 string[2] = {0, (Uint32)SDL_strlen(str)};
+        string[0] = bin_pool_add(pool, str, string[1]);
+        if (string[0] == XYZ_SCF_BINARY_NONE) {
+          return XYZ_SCF_BINARY_NONE;
+        }
+        SDL_memcpy(dst + i * sizeof(string), string, sizeof(string));
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  items->len = offset + size;
+  return (Uint32)offset;
+}
+
+bool bin_check_array(const XYZ_SCFBinary* binary,
+                     const XYZ_SCFBinaryNode* node) {
+  if (node->len == 0) {
+    return true;
+  }
+
+  Uint64 end = (Uint64)node->as_items +
+               (Uint64)node->len * bin_item_size(node->type);
+  if ((node->as_items & 3) != 0 || end > binary->header->arrays_len) {
+    return false;
+  }
+
+  // bools are read as bool, strings must be in the pool like any other
+  const Uint8* bools = binary->arrays + node->as_items;
+  const Uint32* strings = (const Uint32*)bools;
+  for (Uint32 i = 0; i < node->len; i++) {
+    bool valid = true;
+    if (node->type == XYZ_SCF_VALUE_TYPE_BOOL_ARRAY) {
+      valid = bools[i] <= 1;
+    } else if (node->type == XYZ_SCF_VALUE_TYPE_STRING_ARRAY) {
+      valid = bin_check_string(binary, strings[i * 2], strings[i * 2 + 1]);
+    }
+
+    if (!valid) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool bin_get_array(XYZ_SCFBinaryTable table,
+                   const char* key,
+                   Uint32 type,
+                   const void** values,
+                   size_t* count) {
+  SDL_assert(values != NULL && "XYZ_SCFBinaryGetArray: values cannot be NULL");
+  SDL_assert(count != NULL && "XYZ_SCFBinaryGetArray: count cannot be NULL");
+  const XYZ_SCFBinaryNode* node = XYZ_SCFBinaryFind(table, key);
+  if (node == NULL) {
+    return false;
+  }
+
+  bool empty = bin_item_size(node->type) != 0 && node->len == 0;
+  if (node->type != type && !empty) {
+    SDL_SetError("incompatible type for key: %s", key);
+    return false;
+  }
+
+  *values = node->len > 0 ? table.binary->arrays + node->as_items : NULL;
+  *count = node->len;
+  return true;
+}
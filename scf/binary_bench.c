@@ -0,0 +1,95 @@
+#include <scf/scf.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_SIZE (5 * 1024 * 1024)
+#define BENCH_ROUNDS 5
+#define BENCH_TEXT_FILE "binary_bench.scf"
+#define BENCH_BINARY_FILE "binary_bench.scfb"
+
+bool write_file(const char* path, const void* data, size_t len);
+
+bool write_file(const char* path, const void* data, size_t len) {
+  SDL_IOStream* io = SDL_IOFromFile(path, "wb");
+  if (io == NULL) {
+    return false;
+  }
+  bool written = SDL_WriteIO(io, data, len) == len;
+  return SDL_CloseIO(io) && written;
+}
+
+int main(void) {
+  size_t len = 0;
+  char* data = bench_generate_config(BENCH_SIZE, &len);
+  if (data == NULL) {
+    return 1;
+  }
+
+  XYZ_SCFDocument* doc = XYZ_SCFParseDocument(data, len, 0);
+  size_t image_len = 0;
+  void* image = doc != NULL ? XYZ_SCFTableToBinary(doc->root, &image_len) : NULL;
+  if (image == NULL || !write_file(BENCH_TEXT_FILE, data, len) ||
+      !write_file(BENCH_BINARY_FILE, image, image_len)) {
+    SDL_Log("setup failed: %s", SDL_GetError());
+    return 1;
+  }
+  XYZ_SCFDocumentDestroy(doc);
+
+  double text_parse = 0.0;
+  double text_view = 0.0;
+  double text_load = 0.0;
+  double binary_open = 0.0;
+  double binary_load = 0.0;
+  for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    doc = XYZ_SCFParseDocument(data, len, 0);
+    double elapsed = bench_elapsed(start);
+    XYZ_SCFDocumentDestroy(doc);
+    text_parse = round == 0 ? elapsed : SDL_min(text_parse, elapsed);
+
+    start = SDL_GetPerformanceCounter();
+    doc = XYZ_SCFParseDocument(data, len, XYZ_SCF_PARSE_ZERO_COPY);
+    elapsed = bench_elapsed(start);
+    XYZ_SCFDocumentDestroy(doc);
+    text_view = round == 0 ? elapsed : SDL_min(text_view, elapsed);
+
+    start = SDL_GetPerformanceCounter();
+    doc = XYZ_SCFLoadFile(BENCH_TEXT_FILE, XYZ_SCF_PARSE_ZERO_COPY);
+    elapsed = bench_elapsed(start);
+    XYZ_SCFDocumentDestroy(doc);
+    text_load = round == 0 ? elapsed : SDL_min(text_load, elapsed);
+
+    XYZ_SCFBinary binary = {0};
+    start = SDL_GetPerformanceCounter();
+    XYZ_SCFBinaryOpen(&binary, image, image_len);
+    elapsed = bench_elapsed(start);
+    binary_open = round == 0 ? elapsed : SDL_min(binary_open, elapsed);
+
+    start = SDL_GetPerformanceCounter();
+    XYZ_SCFBinaryFile* file = XYZ_SCFLoadBinaryFile(BENCH_BINARY_FILE);
+    elapsed = bench_elapsed(start);
+    XYZ_SCFBinaryFileDestroy(file);
+    binary_load = round == 0 ? elapsed : SDL_min(binary_load, elapsed);
+  }
+
+  SDL_Log("text %.1f MB, binary %.1f MB", len / 1048576.0,
+          image_len / 1048576.0);
+  SDL_Log("text parse            %8.2f ms", text_parse * 1e3);
+  SDL_Log("text parse zero copy  %8.2f ms", text_view * 1e3);
+  SDL_Log("text load file        %8.2f ms", text_load * 1e3);
+  SDL_Log("binary open           %8.2f ms", binary_open * 1e3);
+  SDL_Log("binary load file      %8.2f ms", binary_load * 1e3);
+
+  SDL_RemovePath(BENCH_TEXT_FILE);
+  SDL_RemovePath(BENCH_BINARY_FILE);
+  SDL_free(image);
+  SDL_free(data);
+  return 0;
+}
@@ -0,0 +1,170 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/binary.h>
+#include <scf/parser.h>
+
+#include "test.h"
+
+static void binary_round_trip(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* table = test_parse(
+      "name = \"hero\" lives = 3 speed = 1.5 god = false none = nil "
+      "video { width = 1280 name = \"hero\" display { index = 2 } } "
+      "audio { } flags = [true false true] sizes = [640 1280 1920] "
+      "scales = [0.5 1.5] names = [\"hero\" \"villain\"] empty = []");
+
+  size_t len = 0;
+  void* image = XYZ_SCFTableToBinary(table, &len);
+  assert_non_null(image);
+
+  XYZ_SCFBinary binary = {0};
+  assert_true(XYZ_SCFBinaryOpen(&binary, image, len));
+
+  XYZ_SCFBinaryTable root = XYZ_SCFBinaryRoot(&binary);
+  assert_int_equal(root.count, 12);
+
+  const char* name = NULL;
+  Sint32 lives = 0;
+  float speed = 0.0f;
+  bool god = true;
+  assert_true(XYZ_SCFBinaryGetString(root, "name", &name));
+  assert_string_equal(name, "hero");
+  assert_true(XYZ_SCFBinaryGetI32(root, "lives", &lives));
+  assert_int_equal(lives, 3);
+  assert_true(XYZ_SCFBinaryGetF32(root, "speed", &speed));
+  assert_float_equal(speed, 1.5f, 0.0f);
+  assert_true(XYZ_SCFBinaryGetBool(root, "god", &god));
+  assert_false(god);
+  assert_true(XYZ_SCFBinaryHas(root, "none"));
+  assert_false(XYZ_SCFBinaryHas(root, "missing"));
+  assert_false(XYZ_SCFBinaryGetI32(root, "name", &lives));
+
+  XYZ_SCFBinaryTable video = {0};
+  XYZ_SCFBinaryTable display = {0};
+  XYZ_SCFBinaryTable audio = {0};
+  Sint32 index = 0;
+  const char* video_name = NULL;
+  assert_true(XYZ_SCFBinaryGetTable(root, "video", &video));
+  assert_true(XYZ_SCFBinaryGetTable(video, "display", &display));
+  assert_true(XYZ_SCFBinaryGetI32(display, "index", &index));
+  assert_int_equal(index, 2);
+  assert_true(XYZ_SCFBinaryGetTable(root, "audio", &audio));
+  assert_int_equal(audio.count, 0);
+
+  // repeated strings are pooled once
+  assert_true(XYZ_SCFBinaryGetString(video, "name", &video_name));
+  assert_ptr_equal(video_name, name);
+
+  const bool* flags = NULL;
+  const Sint32* sizes = NULL;
+  const float* scales = NULL;
+  const char* names[4] = {0};
+  size_t count = 0;
+  assert_true(XYZ_SCFBinaryGetBoolArray(root, "flags", &flags, &count));
+  assert_int_equal(count, 3);
+  assert_true(flags[0] && !flags[1] && flags[2]);
+  assert_true(XYZ_SCFBinaryGetI32Array(root, "sizes", &sizes, &count));
+  assert_int_equal(count, 3);
+  assert_int_equal(sizes[0], 640);
+  assert_int_equal(sizes[2], 1920);
+  assert_true(XYZ_SCFBinaryGetF32Array(root, "scales", &scales, &count));
+  assert_int_equal(count, 2);
+  assert_float_equal(scales[1], 1.5f, 0.0f);
+  assert_true(XYZ_SCFBinaryGetStringArray(root, "names", names,
+                                          SDL_arraysize(names), &count));
+  assert_int_equal(count, 2);
+  assert_ptr_equal(names[0], name);
+  assert_string_equal(names[1], "villain");
+  assert_false(XYZ_SCFBinaryGetI32Array(root, "scales", &sizes, &count));
+
+  // only as many strings as asked for, the count is the whole array
+  names[0] = NULL;
+  assert_true(XYZ_SCFBinaryGetStringArray(root, "names", NULL, 0, &count));
+  assert_int_equal(count, 2);
+  assert_null(names[0]);
+
+  // empty arrays are read by any getter
+  assert_true(XYZ_SCFBinaryGetF32Array(root, "empty", &scales, &count));
+  assert_null(scales);
+  assert_int_equal(count, 0);
+  assert_true(XYZ_SCFBinaryGetStringArray(root, "empty", names,
+                                          SDL_arraysize(names), &count));
+  assert_int_equal(count, 0);
+
+  SDL_free(image);
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+}
+
+static void binary_reject(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* table = test_parse("video { width = 1280 title = \"abc\" }");
+  size_t len = 0;
+  Uint8* image = XYZ_SCFTableToBinary(table, &len);
+  assert_non_null(image);
+
+  XYZ_SCFBinary binary = {0};
+  assert_false(XYZ_SCFBinaryOpen(&binary, image, len - 4));
+
+  image[0] ^= 0xFF;
+  assert_false(XYZ_SCFBinaryOpen(&binary, image, len));
+  image[0] ^= 0xFF;
+
+  // a child range pointing back at its parent
+  XYZ_SCFBinaryHeader* header = (XYZ_SCFBinaryHeader*)image;
+  XYZ_SCFBinaryNode* nodes = (XYZ_SCFBinaryNode*)(image + header->nodes_offset);
+  nodes[0].as_first = 0;
+  assert_false(XYZ_SCFBinaryOpen(&binary, image, len));
+
+  SDL_free(image);
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+
+  // array elements out of the array pool or that are not what they say
+  table = test_parse("flags = [true false] names = [\"a\" \"b\"]");
+  image = XYZ_SCFTableToBinary(table, &len);
+  assert_non_null(image);
+  assert_true(XYZ_SCFBinaryOpen(&binary, image, len));
+
+  header = (XYZ_SCFBinaryHeader*)image;
+  nodes = (XYZ_SCFBinaryNode*)(image + header->nodes_offset);
+  Uint8* arrays = image + header->arrays_offset;
+  nodes[0].len = 100;
+  assert_false(XYZ_SCFBinaryOpen(&binary, image, len));
+  nodes[0].len = 2;
+  arrays[nodes[0].as_items] = 2;
+  assert_false(XYZ_SCFBinaryOpen(&binary, image, len));
+  arrays[nodes[0].as_items] = 1;
+  Uint32* string = (Uint32*)(arrays + nodes[1].as_items);
+  string[0] = header->strings_len;
+  assert_false(XYZ_SCFBinaryOpen(&binary, image, len));
+
+  SDL_free(image);
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+
+  // a lazy block that does not parse is not written as an empty one
+  const char* src = "a = 1\nb {\n x = = 2\n}\n";
+  XYZ_SCFParser setup = {.flags = XYZ_SCF_PARSE_LAZY};
+  table = test_parse_with(&setup, src, SDL_strlen(src));
+  assert_non_null(table);
+  assert_null(XYZ_SCFTableToBinary(table, &len));
+  test_destroy(table);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(binary_round_trip),
+      cmocka_unit_test(binary_reject),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
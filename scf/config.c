@@ -0,0 +1,158 @@
+#include "scf/config.h"
+#include "scf/scf.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+// shared with table.c, parse every block XYZ_SCF_PARSE_LAZY left unparsed
+// below table, readers of a snapshot must not change it
+bool table_expand_all(XYZ_SCFTable* table);
+// free the retired snapshots no reader has pinned, under the writer lock
+void config_reclaim(XYZ_SCFConfig* config);
+bool config_pinned(XYZ_SCFConfig* config, XYZ_SCFSnapshot* snapshot);
+
+void XYZ_SCFConfigInit(XYZ_SCFConfig* config) {
+  SDL_assert(config != NULL && "XYZ_SCFConfigInit: config cannot be NULL");
+  SDL_memset(config, 0, sizeof(XYZ_SCFConfig));
+}
+
+void XYZ_SCFConfigDestroy(XYZ_SCFConfig* config) {
+  SDL_assert(config != NULL && "XYZ_SCFConfigDestroy: config cannot be NULL");
+  XYZ_SCFSnapshot* current = SDL_SetAtomicPointer(&config->current, NULL);
+  if (current != NULL) {
+    XYZ_SCFDocumentDestroy(current->doc);
+  }
+
+  for (Uint32 i = 0; i < config->retired_count; i++) {
+    XYZ_SCFDocumentDestroy(config->retired[i]->doc);
+  }
+  SDL_free(config->retired);
+  SDL_memset(config, 0, sizeof(XYZ_SCFConfig));
+}
+
+bool XYZ_SCFConfigPublish(XYZ_SCFConfig* config, XYZ_SCFDocument* doc) {
+  SDL_assert(config != NULL && "XYZ_SCFConfigPublish: config cannot be NULL");
+  SDL_assert(doc != NULL && "XYZ_SCFConfigPublish: doc cannot be NULL");
+  if (!table_expand_all(doc->root)) {
+    return false;
+  }
+
+  // the snapshot lives and dies with its document
+  XYZ_SCFSnapshot* snapshot =
+      XYZ_SCFArenaAlloc(&doc->arena, sizeof(XYZ_SCFSnapshot));
+  if (snapshot == NULL) {
+    return false;
+  }
+  snapshot->doc = doc;
+
+  SDL_LockSpinlock(&config->writer_lock);
+  if (config->retired_count == config->retired_cap) {
+    Uint32 cap = SDL_max(config->retired_cap * 2, 8);
+    XYZ_SCFSnapshot** retired =
+        SDL_realloc(config->retired, cap * sizeof(XYZ_SCFSnapshot*));
+    if (retired == NULL) {
+      SDL_UnlockSpinlock(&config->writer_lock);
+      return false;
+    }
+    config->retired = retired;
+    config->retired_cap = cap;
+  }
+
+  snapshot->version = ++config->version;
+  XYZ_SCFSnapshot* old = SDL_SetAtomicPointer(&config->current, snapshot);
+  if (old != NULL) {
+    config->retired[config->retired_count++] = old;
+  }
+  config_reclaim(config);
+  SDL_UnlockSpinlock(&config->writer_lock);
+  return true;
+}
+
+bool XYZ_SCFConfigReload(XYZ_SCFConfig* config,
+                         const char* path,
+                         Uint32 flags) {
+  SDL_assert(config != NULL && "XYZ_SCFConfigReload: config cannot be NULL");
+  SDL_assert(path != NULL && "XYZ_SCFConfigReload: path cannot be NULL");
+  // every block would be parsed right away to publish it anyway
+  XYZ_SCFDocument* doc = XYZ_SCFLoadFile(path, flags & ~XYZ_SCF_PARSE_LAZY);
+  if (doc == NULL) {
+    return false;
+  }
+
+  if (!XYZ_SCFConfigPublish(config, doc)) {
+    XYZ_SCFDocumentDestroy(doc);
+    return false;
+  }
+  return true;
+}
+
+Sint32 XYZ_SCFConfigAcquireReader(XYZ_SCFConfig* config) {
+  SDL_assert(config != NULL &&
+             "XYZ_SCFConfigAcquireReader: config cannot be NULL");
+  for (Sint32 i = 0; i < XYZ_SCF_CONFIG_MAX_READERS; i++) {
+    if (SDL_CompareAndSwapAtomicInt(&config->claimed[i], 0, 1)) {
+      return i;
+    }
+  }
+
+  SDL_SetError("all %d config readers are taken", XYZ_SCF_CONFIG_MAX_READERS);
+  return -1;
+}
+
+void XYZ_SCFConfigReleaseReader(XYZ_SCFConfig* config, Sint32 reader) {
+  SDL_assert(config != NULL &&
+             "XYZ_SCFConfigReleaseReader: config cannot be NULL");
+  SDL_assert(reader >= 0 && reader < XYZ_SCF_CONFIG_MAX_READERS &&
+             "XYZ_SCFConfigReleaseReader: invalid reader");
+  SDL_SetAtomicPointer(&config->hazards[reader], NULL);
+  SDL_SetAtomicInt(&config->claimed[reader], 0);
+}
+
+const XYZ_SCFSnapshot* XYZ_SCFConfigPin(XYZ_SCFConfig* config, Sint32 reader) {
+  SDL_assert(config != NULL && "XYZ_SCFConfigPin: config cannot be NULL");
+  SDL_assert(reader >= 0 && reader < XYZ_SCF_CONFIG_MAX_READERS &&
+             "XYZ_SCFConfigPin: invalid reader");
+
+  // announce the snapshot, then make sure it was not replaced (and possibly
+  // reclaimed) before the announcement could be seen
+  void* snapshot = SDL_GetAtomicPointer(&config->current);
+  while (true) {
+    SDL_SetAtomicPointer(&config->hazards[reader], snapshot);
+    void* check = SDL_GetAtomicPointer(&config->current);
+    if (check == snapshot) {
+      return snapshot;
+    }
+    snapshot = check;
+  }
+}
+
+void XYZ_SCFConfigUnpin(XYZ_SCFConfig* config, Sint32 reader) {
+  SDL_assert(config != NULL && "XYZ_SCFConfigUnpin: config cannot be NULL");
+  SDL_assert(reader >= 0 && reader < XYZ_SCF_CONFIG_MAX_READERS &&
+             "XYZ_SCFConfigUnpin: invalid reader");
+  SDL_SetAtomicPointer(&config->hazards[reader], NULL);
+}
+
+void config_reclaim(XYZ_SCFConfig* config) {
+  Uint32 kept = 0;
+  for (Uint32 i = 0; i < config->retired_count; i++) {
+    XYZ_SCFSnapshot* snapshot = config->retired[i];
+    if (config_pinned(config, snapshot)) {
+      config->retired[kept++] = snapshot;
+    } else {
+      XYZ_SCFDocumentDestroy(snapshot->doc);
+    }
+  }
+  config->retired_count = kept;
+}
+
+bool config_pinned(XYZ_SCFConfig* config, XYZ_SCFSnapshot* snapshot) {
+  for (Sint32 i = 0; i < XYZ_SCF_CONFIG_MAX_READERS; i++) {
+    if (SDL_GetAtomicPointer(&config->hazards[i]) == snapshot) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,194 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/config.h>
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_thread.h>
+
+#define STRESS_READERS 8
+#define STRESS_VERSIONS 2000
+
+typedef struct {
+  XYZ_SCFConfig* config;
+  SDL_AtomicInt* done;
+  SDL_AtomicInt* errors;
+  Sint32 reads;
+} stress_reader;
+
+static XYZ_SCFDocument* make_doc(Sint32 value) {
+  char src[256] = {0};
+  size_t len = SDL_snprintf(
+      src, sizeof(src),
+      "version = %d audio { volume = %d } video { display { width = %d } }",
+      value, value, value);
+  XYZ_SCFDocument* doc = XYZ_SCFParseDocument(src, len, 0);
+  assert_non_null(doc);
+  return doc;
+}
+
+static int stress_read(void* data) {
+  stress_reader* reader = data;
+  Sint32 slot = XYZ_SCFConfigAcquireReader(reader->config);
+  if (slot < 0) {
+    SDL_AddAtomicInt(reader->errors, 1);
+    return 1;
+  }
+
+  Uint64 last_version = 0;
+  while (SDL_GetAtomicInt(reader->done) == 0) {
+    const XYZ_SCFSnapshot* snapshot = XYZ_SCFConfigPin(reader->config, slot);
+    if (snapshot == NULL) {
+      continue;
+    }
+
+    // every value of a snapshot comes from the same version
+    XYZ_SCFTable* root = snapshot->doc->root;
+    Sint32 version = -1;
+    Sint32 volume = -2;
+    Sint32 width = -3;
+    XYZ_SCFTable* audio = NULL;
+    XYZ_SCFTable* video = NULL;
+    XYZ_SCFTable* display = NULL;
+    bool read = XYZ_SCFTableGetI32(root, "version", &version) &&
+                XYZ_SCFTableGetTable(root, "audio", &audio) &&
+                XYZ_SCFTableGetI32(audio, "volume", &volume) &&
+                XYZ_SCFTableGetTable(root, "video", &video) &&
+                XYZ_SCFTableGetTable(video, "display", &display) &&
+                XYZ_SCFTableGetI32(display, "width", &width);
+    if (!read || version != volume || version != width ||
+        (Uint64)version != snapshot->version ||
+        snapshot->version < last_version) {
+      SDL_AddAtomicInt(reader->errors, 1);
+    }
+    last_version = snapshot->version;
+    reader->reads++;
+    XYZ_SCFConfigUnpin(reader->config, slot);
+  }
+
+  XYZ_SCFConfigReleaseReader(reader->config, slot);
+  return 0;
+}
+
+static void config_publish(void** state) {
+  (void)state;
+
+  XYZ_SCFConfig config = {0};
+  XYZ_SCFConfigInit(&config);
+  Sint32 reader = XYZ_SCFConfigAcquireReader(&config);
+  assert_int_equal(reader, 0);
+  assert_null(XYZ_SCFConfigPin(&config, reader));
+
+  assert_true(XYZ_SCFConfigPublish(&config, make_doc(1)));
+  const XYZ_SCFSnapshot* first = XYZ_SCFConfigPin(&config, reader);
+  assert_non_null(first);
+  assert_int_equal(first->version, 1);
+
+  // the pinned snapshot survives being replaced
+  assert_true(XYZ_SCFConfigPublish(&config, make_doc(2)));
+  assert_true(XYZ_SCFConfigPublish(&config, make_doc(3)));
+  assert_int_equal(config.retired_count, 1);
+  Sint32 version = 0;
+  assert_true(XYZ_SCFTableGetI32(first->doc->root, "version", &version));
+  assert_int_equal(version, 1);
+
+  // and goes away with the next publish once unpinned
+  XYZ_SCFConfigUnpin(&config, reader);
+  assert_true(XYZ_SCFConfigPublish(&config, make_doc(4)));
+  assert_int_equal(config.retired_count, 0);
+
+  const XYZ_SCFSnapshot* last = XYZ_SCFConfigPin(&config, reader);
+  assert_int_equal(last->version, 4);
+  XYZ_SCFConfigReleaseReader(&config, reader);
+
+  for (Sint32 i = 0; i < XYZ_SCF_CONFIG_MAX_READERS; i++) {
+    assert_int_equal(XYZ_SCFConfigAcquireReader(&config), i);
+  }
+  assert_int_equal(XYZ_SCFConfigAcquireReader(&config), -1);
+
+  XYZ_SCFConfigDestroy(&config);
+}
+
+static void config_publish_lazy(void** state) {
+  (void)state;
+
+  XYZ_SCFConfig config = {0};
+  XYZ_SCFConfigInit(&config);
+
+  // readers never parse blocks, they all are by the time it is published
+  const char* src = "video { display { width = 1 } } audio { volume = 2 }";
+  XYZ_SCFDocument* doc =
+      XYZ_SCFParseDocument(src, SDL_strlen(src), XYZ_SCF_PARSE_LAZY);
+  assert_non_null(doc);
+  assert_non_null(doc->root->pairs[0].value.as_table->lazy);
+  assert_true(XYZ_SCFConfigPublish(&config, doc));
+  XYZ_SCFTable* video = doc->root->pairs[0].value.as_table;
+  assert_null(video->lazy);
+  assert_null(video->pairs[0].value.as_table->lazy);
+  assert_null(doc->root->pairs[1].value.as_table->lazy);
+
+  // a block that does not parse is not published
+  const char* bad = "video { display { width = } } audio { volume = 3 }";
+  doc = XYZ_SCFParseDocument(bad, SDL_strlen(bad), XYZ_SCF_PARSE_LAZY);
+  assert_non_null(doc);
+  assert_false(XYZ_SCFConfigPublish(&config, doc));
+  assert_string_equal(SDL_GetError(),
+                      "line 1, column 27: was expecting a value but found "
+                      "'}'");
+  assert_int_equal(config.version, 1);
+  XYZ_SCFDocumentDestroy(doc);
+
+  XYZ_SCFConfigDestroy(&config);
+}
+
+static void config_stress(void** state) {
+  (void)state;
+
+  XYZ_SCFConfig config = {0};
+  XYZ_SCFConfigInit(&config);
+  SDL_AtomicInt done = {0};
+  SDL_AtomicInt errors = {0};
+  stress_reader readers[STRESS_READERS] = {0};
+  SDL_Thread* threads[STRESS_READERS] = {0};
+  for (Sint32 i = 0; i < STRESS_READERS; i++) {
+    readers[i] = (stress_reader){&config, &done, &errors, 0};
+    threads[i] = SDL_CreateThread(stress_read, "stress_read", &readers[i]);
+    assert_non_null(threads[i]);
+  }
+
+  // one writer reloading as fast as it can
+  for (Sint32 version = 1; version <= STRESS_VERSIONS; version++) {
+    assert_true(XYZ_SCFConfigPublish(&config, make_doc(version)));
+  }
+
+  SDL_SetAtomicInt(&done, 1);
+  Sint32 reads = 0;
+  for (Sint32 i = 0; i < STRESS_READERS; i++) {
+    SDL_WaitThread(threads[i], NULL);
+    reads += readers[i].reads;
+  }
+
+  assert_int_equal(SDL_GetAtomicInt(&errors), 0);
+  assert_true(reads > 0);
+
+  // nothing is pinned anymore, the next publish frees every old snapshot
+  assert_true(XYZ_SCFConfigPublish(&config, make_doc(STRESS_VERSIONS + 1)));
+  assert_int_equal(config.retired_count, 0);
+  XYZ_SCFConfigDestroy(&config);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(config_publish),
+      cmocka_unit_test(config_publish_lazy),
+      cmocka_unit_test(config_stress),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
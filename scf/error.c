@@ -0,0 +1,126 @@
+#include "scf/error.h"
+#include "scf/lexer.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+// shared with the parsers
+//
+// record an error at token, formatting fmt unless the lexer already failed
+// there and said why, and set it as the SDL error. Always returns false
+bool error_at(XYZ_SCFError* error,
+              const XYZ_SCFToken* token,
+              Uint32 expected,
+              const char* fmt,
+              ...);
+// fill in the line and column of error from its offset into data, for
+// errors recorded without them, and set it as the SDL error again
+bool error_locate(XYZ_SCFError* error, const char* data, size_t len);
+// build the line starts of index
+bool error_index_lines(XYZ_SCFLineIndex* index);
+
+void XYZ_SCFLineIndexInit(XYZ_SCFLineIndex* index,
+                          const char* data,
+                          size_t len) {
+  SDL_assert(index != NULL && "XYZ_SCFLineIndexInit: index cannot be NULL");
+  SDL_assert((data != NULL || len == 0) &&
+             "XYZ_SCFLineIndexInit: data cannot be NULL");
+  *index = (XYZ_SCFLineIndex){.data = data, .len = len};
+}
+
+void XYZ_SCFLineIndexDestroy(XYZ_SCFLineIndex* index) {
+  SDL_assert(index != NULL &&
+             "XYZ_SCFLineIndexDestroy: index cannot be NULL");
+  SDL_free(index->starts);
+  SDL_memset(index, 0, sizeof(XYZ_SCFLineIndex));
+}
+
+bool XYZ_SCFLineIndexFind(XYZ_SCFLineIndex* index,
+                          size_t offset,
+                          Uint32* line,
+                          Uint32* col) {
+  SDL_assert(index != NULL && "XYZ_SCFLineIndexFind: index cannot be NULL");
+  SDL_assert(line != NULL && "XYZ_SCFLineIndexFind: line cannot be NULL");
+  SDL_assert(col != NULL && "XYZ_SCFLineIndexFind: col cannot be NULL");
+  if (index->starts == NULL && !error_index_lines(index)) {
+    return false;
+  }
+
+  // last line starting at or before offset
+  offset = SDL_min(offset, index->len);
+  size_t lo = 0;
+  size_t hi = index->count;
+  while (hi - lo > 1) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (index->starts[mid] <= offset) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+
+  *line = (Uint32)lo + 1;
+  *col = (Uint32)(offset - index->starts[lo]) + 1;
+  return true;
+}
+
+bool XYZ_SCFErrorReport(const XYZ_SCFError* error) {
+  SDL_assert(error != NULL && "XYZ_SCFErrorReport: error cannot be NULL");
+  if (error->line == 0) {
+    return SDL_SetError("%s", error->message);
+  }
+  return SDL_SetError("line %u, column %u: %s", error->line, error->col,
+                      error->message);
+}
+
+bool error_at(XYZ_SCFError* error,
+              const XYZ_SCFToken* token,
+              Uint32 expected,
+              const char* fmt,
+              ...) {
+  if (token->type == XYZ_SCF_TOKEN_TYPE_ERROR) {
+    SDL_strlcpy(error->message, SDL_GetError(), sizeof(error->message));
+    expected = 0;
+  } else {
+    va_list args;
+    va_start(args, fmt);
+    SDL_vsnprintf(error->message, sizeof(error->message), fmt, args);
+    va_end(args);
+  }
+
+  error->offset = token->val_start - token->buf_start;
+  error->line = token->line;
+  error->col = token->col;
+  error->expected = expected;
+  return XYZ_SCFErrorReport(error);
+}
+
+bool error_locate(XYZ_SCFError* error, const char* data, size_t len) {
+  XYZ_SCFLineIndex index = {0};
+  XYZ_SCFLineIndexInit(&index, data, len);
+  XYZ_SCFLineIndexFind(&index, error->offset, &error->line, &error->col);
+  XYZ_SCFLineIndexDestroy(&index);
+  return XYZ_SCFErrorReport(error);
+}
+
+bool error_index_lines(XYZ_SCFLineIndex* index) {
+  size_t count = 1;
+  for (size_t i = 0; i < index->len; i++) {
+    count += index->data[i] == '\n';
+  }
+
+  index->starts = SDL_malloc(count * sizeof(size_t));
+  if (index->starts == NULL) {
+    return false;
+  }
+
+  index->starts[0] = 0;
+  index->count = 1;
+  for (size_t i = 0; i < index->len; i++) {
+    if (index->data[i] == '\n') {
+      index->starts[index->count++] = i + 1;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,202 @@
+#include "scf/events.h"
+#include "scf/lexer.h"
+#include "scf/parser.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+
+typedef struct {
+  XYZ_SCFParser* parser;
+  const XYZ_SCFEvents* events;
+  void* userdata;
+} event_state;
+
+// shared with parser.c so events follow the grammar of the tree builder
+bool expect_punct(XYZ_SCFParser* parser,
+                  const char* punct,
+                  XYZ_SCFToken* token);
+bool expect_type(XYZ_SCFParser* parser,
+                 XYZ_SCFTokenType type,
+                 XYZ_SCFToken* token);
+bool parse_value(XYZ_SCFParser* parser, XYZ_SCFValue* value);
+bool parse_array_scan(XYZ_SCFParser* parser,
+                      XYZ_SCFValueType* type,
+                      Uint32* count,
+                      size_t* string_bytes);
+bool parse_array_item(const XYZ_SCFToken* token,
+                      XYZ_SCFValueType type,
+                      XYZ_SCFValue* item);
+// shared with error.c, records where parsing failed
+bool error_at(XYZ_SCFError* error,
+              const XYZ_SCFToken* token,
+              Uint32 expected,
+              const char* fmt,
+              ...);
+
+// report a key and its value or block
+bool event_entry(event_state* state);
+// report the entries of a block up to its '}'
+bool event_block(event_state* state);
+// report the value after '=', strings are left in the data
+bool event_value(event_state* state);
+// report the elements after '[' up to its ']'
+bool event_array(event_state* state);
+// a callback stopped parsing at token, keep its error there
+bool event_stopped(event_state* state, const XYZ_SCFToken* token);
+
+bool XYZ_SCFParseEvents(XYZ_SCFParser* parser,
+                        const XYZ_SCFEvents* events,
+                        void* userdata) {
+  SDL_assert(parser != NULL && "XYZ_SCFParseEvents: parser cannot be NULL");
+  SDL_assert(events != NULL && "XYZ_SCFParseEvents: events cannot be NULL");
+
+  SDL_memset(&parser->error, 0, sizeof(XYZ_SCFError));
+  if (!expect_type(parser, XYZ_SCF_TOKEN_TYPE_START, NULL)) {
+    return error_at(&parser->error, &parser->cur, 0,
+                    "was expecting start of file but found: '%.*s'",
+                    (Sint32)parser->cur.val_len, parser->cur.val_start);
+  }
+
+  event_state state = {parser, events, userdata};
+  XYZ_SCFToken eof = {0};
+  while (!expect_type(parser, XYZ_SCF_TOKEN_TYPE_EOF, &eof)) {
+    if (!event_entry(&state)) {
+      // the end of file could have come instead of a key
+      if (parser->error.expected == XYZ_SCF_EXPECT_KEY) {
+        parser->error.expected |= XYZ_SCF_EXPECT_EOF;
+      }
+      return false;
+    }
+  }
+
+  if (eof.type != XYZ_SCF_TOKEN_TYPE_EOF) {
+    return error_at(&parser->error, &parser->cur, XYZ_SCF_EXPECT_EOF,
+                    "was expecting end of file but found: '%.*s'",
+                    (Sint32)parser->cur.val_len, parser->cur.val_start);
+  }
+  return true;
+}
+
+bool event_entry(event_state* state) {
+  XYZ_SCFParser* parser = state->parser;
+  const XYZ_SCFEvents* events = state->events;
+  XYZ_SCFToken key = {0};
+  if (!expect_type(parser, XYZ_SCF_TOKEN_TYPE_WORD, &key)) {
+    return error_at(&parser->error, &parser->cur, XYZ_SCF_EXPECT_KEY,
+                    "was expecting identifier but found: '%.*s'",
+                    (Sint32)parser->cur.val_len, parser->cur.val_start);
+  }
+
+  if (events->key != NULL &&
+      !events->key(state->userdata, key.val_start, key.val_len)) {
+    return event_stopped(state, &key);
+  }
+
+  XYZ_SCFToken token = parser->cur;
+  if (expect_punct(parser, "{", NULL)) {
+    if (events->begin_table != NULL && !events->begin_table(state->userdata)) {
+      return event_stopped(state, &token);
+    }
+    return event_block(state);
+  } else if (expect_punct(parser, "=", NULL)) {
+    return event_value(state);
+  }
+
+  return error_at(&parser->error, &parser->cur,
+                  XYZ_SCF_EXPECT_ASSIGN | XYZ_SCF_EXPECT_BLOCK,
+                  "was expecting assign '=' or block '{' but found: '%.*s'",
+                  (Sint32)parser->cur.val_len, parser->cur.val_start);
+}
+
+bool event_block(event_state* state) {
+  XYZ_SCFParser* parser = state->parser;
+  XYZ_SCFToken eob = {0};
+  while (!expect_punct(parser, "}", &eob)) {
+    if (!event_entry(state)) {
+      if (parser->error.expected == XYZ_SCF_EXPECT_KEY) {
+        parser->error.expected |= XYZ_SCF_EXPECT_BLOCK_END;
+      }
+      return false;
+    }
+  }
+
+  if (eob.type != XYZ_SCF_TOKEN_TYPE_PUNCT) {
+    return error_at(&parser->error, &parser->cur, XYZ_SCF_EXPECT_BLOCK_END,
+                    "was expecting end of block '}' but found: '%.*s'",
+                    (Sint32)parser->cur.val_len, parser->cur.val_start);
+  }
+
+  if (state->events->end_table != NULL &&
+      !state->events->end_table(state->userdata)) {
+    return event_stopped(state, &eob);
+  }
+  return true;
+}
+
+bool event_value(event_state* state) {
+  XYZ_SCFParser* parser = state->parser;
+  XYZ_SCFToken token = parser->cur;
+  if (expect_punct(parser, "[", NULL)) {
+    return event_array(state);
+  }
+
+  // strings stay in the data so nothing is allocated
+  Uint32 flags = parser->flags;
+  parser->flags |= XYZ_SCF_PARSE_ZERO_COPY;
+  XYZ_SCFValue value = {0};
+  bool parsed = parse_value(parser, &value);
+  parser->flags = flags;
+  if (!parsed) {
+    return false;
+  }
+
+  if (state->events->value != NULL &&
+      !state->events->value(state->userdata, &value)) {
+    return event_stopped(state, &token);
+  }
+  return true;
+}
+
+bool event_array(event_state* state) {
+  XYZ_SCFParser* parser = state->parser;
+  const XYZ_SCFEvents* events = state->events;
+  XYZ_SCFToken token = parser->cur;
+  XYZ_SCFValueType type = XYZ_SCF_VALUE_TYPE_NIL;
+  Uint32 count = 0;
+  size_t string_bytes = 0;
+  if (!parse_array_scan(parser, &type, &count, &string_bytes)) {
+    return false;
+  }
+
+  if (events->begin_array != NULL &&
+      !events->begin_array(state->userdata, type, count)) {
+    return event_stopped(state, &token);
+  }
+
+  for (Uint32 i = 0; i < count; i++) {
+    XYZ_SCFValue item = {0};
+    token = parser->cur;
+    if (!parse_array_item(&token, type, &item)) {
+      return error_at(&parser->error, &token, 0, "%s", SDL_GetError());
+    }
+
+    if (events->value != NULL && !events->value(state->userdata, &item)) {
+      return event_stopped(state, &token);
+    }
+    XYZ_SCFNextToken(&parser->cur);
+  }
+
+  token = parser->cur;  // the ']'
+  if (!XYZ_SCFNextToken(&parser->cur)) {
+    return error_at(&parser->error, &parser->cur, 0, "%s", SDL_GetError());
+  }
+
+  if (events->end_array != NULL && !events->end_array(state->userdata)) {
+    return event_stopped(state, &token);
+  }
+  return true;
+}
+
+bool event_stopped(event_state* state, const XYZ_SCFToken* token) {
+  return error_at(&state->parser->error, token, 0, "%s", SDL_GetError());
+}
@@ -0,0 +1,180 @@
+#include <scf/scf.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_SIZE (8 * 1024 * 1024)
+#define BENCH_ROUNDS 5
+
+// what the consumer keeps of the config, read once
+typedef struct {
+  Sint64 difficulty;
+  Sint64 par_time;
+  Sint32 spawn_x;
+  Uint32 levels;
+} level_totals;
+
+// event handler state filling level_totals
+typedef struct {
+  level_totals* totals;
+  Uint32 depth;
+  const char* key;
+  size_t key_len;
+} totals_reader;
+
+// read the totals from a document tree
+bool tree_read(const char* data, size_t len, Uint32 flags, level_totals* out);
+// read the totals straight from the events
+bool events_read(const char* data, size_t len, level_totals* out);
+bool totals_begin_table(void* userdata);
+bool totals_end_table(void* userdata);
+bool totals_key(void* userdata, const char* key, size_t key_len);
+bool totals_value(void* userdata, const XYZ_SCFValue* value);
+bool totals_is(const totals_reader* reader, const char* key);
+// best of BENCH_ROUNDS runs of read
+double best(const char* data,
+            size_t len,
+            Uint32 flags,
+            bool events,
+            level_totals* out);
+
+bool tree_read(const char* data, size_t len, Uint32 flags, level_totals* out) {
+  XYZ_SCFDocument* doc = XYZ_SCFParseDocument(data, len, flags);
+  if (doc == NULL) {
+    return false;
+  }
+
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(doc->root);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    XYZ_SCFTable* level = cursor.pair->value.as_table;
+    XYZ_SCFTable* spawn = NULL;
+    Sint32 value = 0;
+    if (XYZ_SCFTableGetI32(level, "difficulty", &value)) {
+      out->difficulty += value;
+    }
+    if (XYZ_SCFTableGetI32(level, "par_time", &value)) {
+      out->par_time += value;
+    }
+    if (XYZ_SCFTableGetTable(level, "spawn", &spawn) &&
+        XYZ_SCFTableGetI32(spawn, "x", &value)) {
+      out->spawn_x = SDL_max(out->spawn_x, value);
+    }
+    out->levels++;
+  }
+
+  XYZ_SCFDocumentDestroy(doc);
+  return true;
+}
+
+bool events_read(const char* data, size_t len, level_totals* out) {
+  static const XYZ_SCFEvents events = {
+      .begin_table = totals_begin_table,
+      .end_table = totals_end_table,
+      .key = totals_key,
+      .value = totals_value,
+  };
+
+  totals_reader reader = {.totals = out};
+  XYZ_SCFParser parser = {0};
+  XYZ_SCFParserSetFile(&parser, data, len);
+  return XYZ_SCFParseEvents(&parser, &events, &reader);
+}
+
+bool totals_begin_table(void* userdata) {
+  totals_reader* reader = userdata;
+  if (reader->depth++ == 0) {
+    reader->totals->levels++;
+  }
+  return true;
+}
+
+bool totals_end_table(void* userdata) {
+  totals_reader* reader = userdata;
+  reader->depth--;
+  return true;
+}
+
+bool totals_key(void* userdata, const char* key, size_t key_len) {
+  totals_reader* reader = userdata;
+  reader->key = key;
+  reader->key_len = key_len;
+  return true;
+}
+
+bool totals_value(void* userdata, const XYZ_SCFValue* value) {
+  totals_reader* reader = userdata;
+  if (value->type != XYZ_SCF_VALUE_TYPE_I32) {
+    return true;
+  }
+
+  level_totals* totals = reader->totals;
+  if (reader->depth == 1 && totals_is(reader, "difficulty")) {
+    totals->difficulty += value->as_i32;
+  } else if (reader->depth == 1 && totals_is(reader, "par_time")) {
+    totals->par_time += value->as_i32;
+  } else if (reader->depth == 2 && totals_is(reader, "x")) {
+    totals->spawn_x = SDL_max(totals->spawn_x, value->as_i32);
+  }
+  return true;
+}
+
+bool totals_is(const totals_reader* reader, const char* key) {
+  return SDL_strlen(key) == reader->key_len &&
+         SDL_memcmp(key, reader->key, reader->key_len) == 0;
+}
+
+double best(const char* data,
+            size_t len,
+            Uint32 flags,
+            bool events,
+            level_totals* out) {
+  double best = 0.0;
+  for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+    *out = (level_totals){0};
+    Uint64 start = SDL_GetPerformanceCounter();
+    bool read = events ? events_read(data, len, out)
+                       : tree_read(data, len, flags, out);
+    double elapsed = bench_elapsed(start);
+    if (!read) {
+      SDL_Log("parse failed: %s", SDL_GetError());
+      return 0.0;
+    }
+    best = round == 0 ? elapsed : SDL_min(best, elapsed);
+  }
+  return best;
+}
+
+int main(void) {
+  size_t len = 0;
+  char* data = bench_generate_config(BENCH_SIZE, &len);
+  if (data == NULL) {
+    return 1;
+  }
+
+  const struct {
+    const char* name;
+    Uint32 flags;
+    bool events;
+  } runs[] = {
+      {"tree", 0, false},
+      {"tree zero copy", XYZ_SCF_PARSE_ZERO_COPY, false},
+      {"events", 0, true},
+  };
+  for (size_t i = 0; i < SDL_arraysize(runs); i++) {
+    level_totals totals = {0};
+    double elapsed = best(data, len, runs[i].flags, runs[i].events, &totals);
+    SDL_Log("%-14s %8.2f ms %8.1f MB/s (levels %u, difficulty %lld, "
+            "par time %lld, spawn x %d)",
+            runs[i].name, elapsed * 1e3, len / 1048576.0 / elapsed,
+            totals.levels, (long long)totals.difficulty,
+            (long long)totals.par_time, totals.spawn_x);
+  }
+
+  SDL_free(data);
+  XYZ_SCFAtomsQuit();
+  return 0;
+}
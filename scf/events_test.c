@@ -0,0 +1,210 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/events.h>
+#include <scf/parser.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+// events written out one after the other, stopping at stop_at if set
+typedef struct {
+  char text[512];
+  size_t len;
+  const char* stop_at;
+} event_log;
+
+static bool log_append(event_log* log, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  log->len += SDL_vsnprintf(log->text + log->len, sizeof(log->text) - log->len,
+                            fmt, args);
+  va_end(args);
+  return true;
+}
+
+static bool log_begin_table(void* userdata) {
+  return log_append(userdata, "{ ");
+}
+
+static bool log_end_table(void* userdata) {
+  return log_append(userdata, "} ");
+}
+
+static bool log_key(void* userdata, const char* key, size_t key_len) {
+  event_log* log = userdata;
+  if (log->stop_at != NULL && SDL_strlen(log->stop_at) == key_len &&
+      SDL_strncmp(log->stop_at, key, key_len) == 0) {
+    return SDL_SetError("stopped at %s", log->stop_at);
+  }
+  return log_append(log, "%.*s ", (Sint32)key_len, key);
+}
+
+static bool log_value(void* userdata, const XYZ_SCFValue* value) {
+  switch (value->type) {
+    case XYZ_SCF_VALUE_TYPE_NIL:
+      return log_append(userdata, "nil ");
+    case XYZ_SCF_VALUE_TYPE_BOOL:
+      return log_append(userdata, value->as_bool ? "true " : "false ");
+    case XYZ_SCF_VALUE_TYPE_I32:
+      return log_append(userdata, "%d ", value->as_i32);
+    case XYZ_SCF_VALUE_TYPE_F32:
+      return log_append(userdata, "%g ", value->as_f32);
+    case XYZ_SCF_VALUE_TYPE_STRING:
+      return log_append(userdata, "'%.*s' ", (Sint32)value->str_len,
+                        value->as_string);
+    default:
+      return SDL_SetError("unexpected value type %d", value->type);
+  }
+}
+
+static bool log_begin_array(void* userdata,
+                            XYZ_SCFValueType type,
+                            Uint32 count) {
+  return log_append(userdata, "[%d:%u ", type, count);
+}
+
+static bool log_end_array(void* userdata) {
+  return log_append(userdata, "] ");
+}
+
+static const XYZ_SCFEvents log_events = {
+    .begin_table = log_begin_table,
+    .end_table = log_end_table,
+    .key = log_key,
+    .value = log_value,
+    .begin_array = log_begin_array,
+    .end_array = log_end_array,
+};
+
+static bool parse_events(const char* src, event_log* log) {
+  XYZ_SCFParser parser = {0};
+  XYZ_SCFParserSetFile(&parser, src, SDL_strlen(src));
+  return XYZ_SCFParseEvents(&parser, &log_events, log);
+}
+
+static void events_order(void** state) {
+  (void)state;
+
+  const char* src =
+      "name = \"hero\" lives = 3 none = nil\n"
+      "video { width = 1280 display { vsync = true } audio {} }\n"
+      "gamma = 2.5 sizes = [1 2.5] tags = [\"a\"] empty = []";
+  event_log log = {0};
+  assert_true(parse_events(src, &log));
+
+  char expected[256];
+  SDL_snprintf(expected, sizeof(expected),
+               "name 'hero' lives 3 none nil "
+               "video { width 1280 display { vsync true } audio { } } "
+               "gamma 2.5 sizes [%d:2 1 2.5 ] tags [%d:1 'a' ] "
+               "empty [%d:0 ] ",
+               XYZ_SCF_VALUE_TYPE_F32_ARRAY, XYZ_SCF_VALUE_TYPE_STRING_ARRAY,
+               XYZ_SCF_VALUE_TYPE_I32_ARRAY);
+  assert_string_equal(log.text, expected);
+
+  // callbacks left out are skipped
+  XYZ_SCFEvents keys = {.key = log_key};
+  XYZ_SCFParser parser = {0};
+  XYZ_SCFParserSetFile(&parser, src, SDL_strlen(src));
+  log = (event_log){0};
+  assert_true(XYZ_SCFParseEvents(&parser, &keys, &log));
+  assert_string_equal(log.text,
+                      "name lives none video width display vsync audio "
+                      "gamma sizes tags empty ");
+}
+
+static Sint32 allocations = 0;
+
+static void* count_malloc(size_t size) {
+  allocations++;
+  return malloc(size);
+}
+
+static void* count_calloc(size_t count, size_t size) {
+  allocations++;
+  return calloc(count, size);
+}
+
+static void* count_realloc(void* mem, size_t size) {
+  allocations++;
+  return realloc(mem, size);
+}
+
+static void events_no_allocation(void** state) {
+  (void)state;
+
+  SDL_malloc_func malloc_func = NULL;
+  SDL_calloc_func calloc_func = NULL;
+  SDL_realloc_func realloc_func = NULL;
+  SDL_free_func free_func = NULL;
+  SDL_GetMemoryFunctions(&malloc_func, &calloc_func, &realloc_func,
+                         &free_func);
+  assert_true(SDL_SetMemoryFunctions(count_malloc, count_calloc,
+                                     count_realloc, free_func));
+
+  const char* src =
+      "name = \"a long enough string\" video { width = 1 inner { x = 2.5 } }"
+      " names = [\"a\" \"b\"] sizes = [1 2 3]";
+  event_log log = {0};
+  allocations = 0;
+  bool parsed = parse_events(src, &log);
+  assert_true(SDL_SetMemoryFunctions(malloc_func, calloc_func, realloc_func,
+                                     free_func));
+  assert_true(parsed);
+  assert_int_equal(allocations, 0);
+}
+
+static void events_errors(void** state) {
+  (void)state;
+
+  // a callback failing stops parsing where it was called
+  event_log log = {.stop_at = "width"};
+  XYZ_SCFParser parser = {0};
+  const char* src = "video {\n  width = 1 }";
+  XYZ_SCFParserSetFile(&parser, src, SDL_strlen(src));
+  assert_false(XYZ_SCFParseEvents(&parser, &log_events, &log));
+  assert_string_equal(SDL_GetError(), "line 2, column 3: stopped at width");
+  assert_string_equal(log.text, "video { ");
+
+  // grammar errors are the same as with the tree builder
+  const char* bad[] = {
+      "a = 1\nvideo {\n  width = }", "a = 1 b 2", "a = 1\n}", "a { b = 1",
+      "a = 1\n\tb = @", "a = \"open", "a = [1 2 true]", "a = [1\n2",
+      "a = [1 99999999999]", "a = [1]@",
+  };
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    size_t len = SDL_strlen(bad[i]);
+    XYZ_SCFParser expected = {0};
+    XYZ_SCFParserSetFile(&expected, bad[i], len);
+    XYZ_SCFTable* table = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTable(&expected, table));
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+
+    log = (event_log){0};
+    XYZ_SCFParserSetFile(&parser, bad[i], len);
+    assert_false(XYZ_SCFParseEvents(&parser, &log_events, &log));
+    assert_string_equal(parser.error.message, expected.error.message);
+    assert_int_equal(parser.error.offset, expected.error.offset);
+    assert_int_equal(parser.error.line, expected.error.line);
+    assert_int_equal(parser.error.col, expected.error.col);
+    assert_int_equal(parser.error.expected, expected.error.expected);
+  }
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(events_order),
+      cmocka_unit_test(events_no_allocation),
+      cmocka_unit_test(events_errors),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,611 @@
+#include "scf/index.h"
+#include "scf/lexer.h"
+#include "scf/parser.h"
+#include "scf/table.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_intrin.h>
+#include <SDL3/SDL_stdinc.h>
+
+// bytes classified at once, one bit each
+#define IX_BLOCK 64
+
+// bytes of a block in each class, bit i is byte i
+typedef struct {
+  Uint64 quote;
+  Uint64 punct;  // { } [ ] =
+  Uint64 blank;  // space, tab and new line
+  Uint64 newline;
+  Uint64 nul;
+} ix_masks;
+
+typedef void (*ix_classify_fn)(const char* block, ix_masks* masks);
+
+typedef enum {
+  ix_state_key,
+  ix_state_assign,
+  ix_state_value,
+} ix_state;
+
+// tables being built while walking the index
+typedef struct {
+  XYZ_SCFParser* parser;
+  XYZ_SCFTable* root;
+  const char* data;  // start of the input, errors are at offsets from it
+  const char* end;
+
+  // arrays are parsed whole by parse_value, positions before this were
+  // consumed by the last one
+  const char* resume;
+
+  // blocks opened so far, stack[depth - 1] receives the next entry
+  XYZ_SCFTable** stack;
+  Uint32 depth;
+  size_t stack_cap;
+
+  // key of the entry being parsed, points into the input
+  const char* key;
+  size_t key_len;
+
+  ix_state state;
+} ix_walk;
+
+// shared with parser.c so values read the same with both engines
+bool parse_value(XYZ_SCFParser* parser, XYZ_SCFValue* value);
+// shared with error.c, the index knows offsets only and fills in lines and
+// columns after a failure
+bool error_at(XYZ_SCFError* error,
+              const XYZ_SCFToken* token,
+              Uint32 expected,
+              const char* fmt,
+              ...);
+bool error_locate(XYZ_SCFError* error, const char* data, size_t len);
+// token at a position of the input, without line and column
+XYZ_SCFToken ix_token_at(const ix_walk* walk, const char* at);
+// grow a heap buffer to fit len items of size bytes
+bool ix_reserve(void** buf, size_t* cap, size_t len, size_t size);
+// classify kernel matching the lexer kernel in use
+ix_classify_fn ix_get_classify(void);
+void ix_classify_scalar(const char* block, ix_masks* masks);
+#ifdef SDL_SSE2_INTRINSICS
+void ix_classify_sse2(const char* block, ix_masks* masks);
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+void ix_classify_avx2(const char* block, ix_masks* masks);
+#endif
+// bit i set when an odd number of bits at or below i are set
+Uint64 ix_prefix_xor(Uint64 bits);
+Uint32 ix_ctz64(Uint64 bits);
+// fail on an unterminated string, opening is the opening quotes of the block
+// at before the failure, the last position of index is it when there are none
+bool ix_unterminated(XYZ_SCFStructuralIndex* index, size_t at, Uint64 opening);
+// split a run of words and numbers starting at cur into tokens
+bool ix_scalars(ix_walk* walk, const char* cur, const char* end);
+// advance the table builder with the next token
+bool ix_token(ix_walk* walk, const XYZ_SCFToken* token);
+
+bool XYZ_SCFStructuralIndexBuild(XYZ_SCFStructuralIndex* index,
+                                 const char* data,
+                                 size_t len) {
+  SDL_assert(index != NULL &&
+             "XYZ_SCFStructuralIndexBuild: index cannot be NULL");
+  SDL_assert((data != NULL || len == 0) &&
+             "XYZ_SCFStructuralIndexBuild: data cannot be NULL");
+  if (len > SDL_MAX_UINT32) {
+    SDL_SetError("input too large to index: %zu bytes", len);
+    return false;
+  }
+
+  ix_classify_fn classify = ix_get_classify();
+  Uint64 in_string = 0;    // all bits set while a string crosses blocks
+  Uint64 prev_scalar = 0;  // last byte of the previous block was a scalar
+  char tail[IX_BLOCK];
+  index->count = 0;
+  index->open_quote = 0;
+
+  for (size_t at = 0; at < len; at += IX_BLOCK) {
+    const char* block = data + at;
+    if (len - at < IX_BLOCK) {
+      // blanks past the end change nothing
+      SDL_memset(tail, ' ', IX_BLOCK);
+      SDL_memcpy(tail, block, len - at);
+      block = tail;
+    }
+
+    ix_masks masks = {0};
+    classify(block, &masks);
+
+    // from each opening quote up to (not including) its closing quote
+    Uint64 inside = ix_prefix_xor(masks.quote) ^ in_string;
+
+    // a NUL byte ends the input, everything after it is blank
+    bool ended = masks.nul != 0;
+    if (ended) {
+      Uint64 first_nul = masks.nul & (~masks.nul + 1);
+      if (inside & first_nul) {
+        return ix_unterminated(index, at,
+                               masks.quote & inside & (first_nul - 1));
+      }
+      Uint64 before = first_nul - 1;
+      masks.quote &= before;
+      masks.punct &= before;
+      masks.newline &= before;
+      masks.blank |= ~before;
+      inside &= before;
+      len = at + ix_ctz64(first_nul);
+    }
+
+    Uint64 broken = masks.newline & inside;
+    if (broken != 0) {
+      Uint64 first = broken & (~broken + 1);
+      return ix_unterminated(index, at, masks.quote & inside & (first - 1));
+    }
+
+    // every quote, punctuation outside strings and the first byte of each
+    // word or number
+    Uint64 scalar = ~(masks.blank | masks.punct | masks.quote | inside);
+    Uint64 starts = scalar & ~((scalar << 1) | prev_scalar);
+    Uint64 structural = (masks.punct & ~inside) | masks.quote | starts;
+    in_string = 0 - (inside >> 63);
+    prev_scalar = scalar >> 63;
+
+    if (!ix_reserve((void**)&index->positions, &index->cap,
+                    index->count + IX_BLOCK, sizeof(Uint32))) {
+      return false;
+    }
+    while (structural != 0) {
+      index->positions[index->count++] = (Uint32)at + ix_ctz64(structural);
+      structural &= structural - 1;
+    }
+
+    if (ended) {
+      break;
+    }
+  }
+
+  if (in_string != 0) {
+    return ix_unterminated(index, len, 0);
+  }
+
+  if (!ix_reserve((void**)&index->positions, &index->cap, index->count + 1,
+                  sizeof(Uint32))) {
+    return false;
+  }
+  index->positions[index->count++] = (Uint32)len;
+  return true;
+}
+
+void XYZ_SCFStructuralIndexDestroy(XYZ_SCFStructuralIndex* index) {
+  SDL_assert(index != NULL &&
+             "XYZ_SCFStructuralIndexDestroy: index cannot be NULL");
+  SDL_free(index->positions);
+  SDL_memset(index, 0, sizeof(XYZ_SCFStructuralIndex));
+}
+
+bool XYZ_SCFParseTableIndexed(XYZ_SCFParser* parser, XYZ_SCFTable* table) {
+  SDL_assert(parser != NULL &&
+             "XYZ_SCFParseTableIndexed: parser cannot be NULL");
+  SDL_assert(table != NULL &&
+             "XYZ_SCFParseTableIndexed: table cannot be NULL");
+
+  const char* data = parser->cur.buf_start;
+  size_t len = parser->cur.buf_len;
+  SDL_memset(&parser->error, 0, sizeof(XYZ_SCFError));
+  XYZ_SCFStructuralIndex index = {0};
+  if (!XYZ_SCFStructuralIndexBuild(&index, data, parser->cur.buf_len)) {
+    // placed at the opening quote, where the lexer fails on it too
+    if (index.open_quote != 0) {
+      XYZ_SCFToken token = {0};
+      token.buf_start = data;
+      token.val_start = data + index.open_quote - 1;
+      error_at(&parser->error, &token, 0, "%s", SDL_GetError());
+      error_locate(&parser->error, data, len);
+    }
+    XYZ_SCFStructuralIndexDestroy(&index);
+    return false;
+  }
+
+  ix_walk walk = {
+      .parser = parser,
+      .root = table,
+      .data = data,
+      .end = data + index.positions[index.count - 1],
+      .state = ix_state_key,
+  };
+  const char* end = walk.end;
+  bool parsed = true;
+  for (size_t i = 0; parsed && i + 1 < index.count; i++) {
+    const char* cur = data + index.positions[i];
+    if (cur < walk.resume) {
+      continue;
+    }
+
+    if (*cur != '"' && *cur != '{' && *cur != '}' && *cur != '[' &&
+        *cur != ']' && *cur != '=') {
+      parsed = ix_scalars(&walk, cur, end);
+      continue;
+    }
+
+    XYZ_SCFToken token = ix_token_at(&walk, cur);
+    token.val_len = 1;
+    token.type = XYZ_SCF_TOKEN_TYPE_PUNCT;
+    if (*cur == '"') {
+      // strings hold nothing structural, the next position is the closing
+      // quote
+      i++;
+      token.val_len = data + index.positions[i] - cur + 1;
+      token.type = XYZ_SCF_TOKEN_TYPE_STRING;
+    }
+    parsed = ix_token(&walk, &token);
+  }
+
+  XYZ_SCFToken eof = ix_token_at(&walk, end);
+  eof.type = XYZ_SCF_TOKEN_TYPE_EOF;
+  if (parsed && walk.state == ix_state_assign) {
+    parsed = error_at(&parser->error, &eof,
+                      XYZ_SCF_EXPECT_ASSIGN | XYZ_SCF_EXPECT_BLOCK,
+                      "was expecting assign '=' or block '{' but found: ''");
+  } else if (parsed && walk.state == ix_state_value) {
+    parsed = error_at(&parser->error, &eof, XYZ_SCF_EXPECT_VALUE,
+                      "was expecting a value but found ''");
+  } else if (parsed && walk.depth > 0) {
+    parsed = error_at(&parser->error, &eof,
+                      XYZ_SCF_EXPECT_KEY | XYZ_SCF_EXPECT_BLOCK_END,
+                      "was expecting end of block '}' but found end of "
+                      "input");
+  }
+
+  if (!parsed && parser->error.message[0] != '\0') {
+    error_locate(&parser->error, data, len);
+  }
+
+  SDL_free(walk.stack);
+  XYZ_SCFStructuralIndexDestroy(&index);
+  return parsed;
+}
+
+bool ix_reserve(void** buf, size_t* cap, size_t len, size_t size) {
+  if (len <= *cap) {
+    return true;
+  }
+
+  size_t new_cap = SDL_max(*cap * 2, SDL_max(len, 64));
+  void* new_buf = SDL_realloc(*buf, new_cap * size);
+  if (new_buf == NULL) {
+    return false;
+  }
+  *buf = new_buf;
+  *cap = new_cap;
+  return true;
+}
+
+bool ix_scalars(ix_walk* walk, const char* cur, const char* end) {
+  // same rules as the lexer: a word or number ends at the first byte that
+  // cannot continue it, so "1abc" is a number followed by a word
+  while (cur < end) {
+    XYZ_SCFToken token = ix_token_at(walk, cur);
+    Uint8 c = *cur;
+    if (c == '-' || SDL_isdigit(c)) {
+      token.type = XYZ_SCF_TOKEN_TYPE_INTEGER;
+      cur++;
+      while (cur < end && SDL_isdigit((Uint8)*cur)) {
+        cur++;
+      }
+      if (cur < end && *cur == '.') {
+        token.type = XYZ_SCF_TOKEN_TYPE_FLOAT;
+        cur++;
+        while (cur < end && SDL_isdigit((Uint8)*cur)) {
+          cur++;
+        }
+      }
+      if (cur < end && (*cur == 'e' || *cur == 'E')) {
+        token.type = XYZ_SCF_TOKEN_TYPE_FLOAT;
+        cur++;
+        if (cur < end && (*cur == '-' || *cur == '+')) {
+          cur++;
+        }
+        while (cur < end && SDL_isdigit((Uint8)*cur)) {
+          cur++;
+        }
+      }
+    } else if (c == '_' || SDL_isalpha(c)) {
+      token.type = XYZ_SCF_TOKEN_TYPE_WORD;
+      cur++;
+      while (cur < end && (*cur == '_' || SDL_isalnum((Uint8)*cur))) {
+        cur++;
+      }
+    } else if (c == ' ' || c == '\t' || c == '\n' || c == '{' || c == '}' ||
+               c == '[' || c == ']' || c == '=' || c == '"') {
+      return true;
+    } else {
+      const char* next = cur;
+      size_t left = end - cur;
+      SDL_StepUTF8(&next, &left);
+      return error_at(&walk->parser->error, &token, 0,
+                      "unknown character: '%.*s'", (Sint32)(next - cur), cur);
+    }
+
+    token.val_len = cur - token.val_start;
+    if (!ix_token(walk, &token)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool ix_token(ix_walk* walk, const XYZ_SCFToken* token) {
+  XYZ_SCFParser* parser = walk->parser;
+  XYZ_SCFTable* table =
+      walk->depth > 0 ? walk->stack[walk->depth - 1] : walk->root;
+  bool punct = token->type == XYZ_SCF_TOKEN_TYPE_PUNCT;
+
+  // same as parse_entry
+  Uint32 flags = 0;
+  if (parser->flags & XYZ_SCF_PARSE_ZERO_COPY) {
+    flags = XYZ_SCF_PAIR_FLAG_KEY_VIEW;
+  } else if (parser->flags & XYZ_SCF_PARSE_INTERN_KEYS) {
+    flags = XYZ_SCF_PAIR_FLAG_KEY_ATOM;
+  }
+
+  switch (walk->state) {
+    case ix_state_key:
+      if (token->type == XYZ_SCF_TOKEN_TYPE_WORD) {
+        walk->key = token->val_start;
+        walk->key_len = token->val_len;
+        walk->state = ix_state_assign;
+        return true;
+      }
+
+      if (punct && *token->val_start == '}' && walk->depth > 0) {
+        walk->depth--;
+        return true;
+      }
+
+      Uint32 end = walk->depth > 0 ? XYZ_SCF_EXPECT_BLOCK_END
+                                   : XYZ_SCF_EXPECT_EOF;
+      return error_at(&parser->error, token, XYZ_SCF_EXPECT_KEY | end,
+                      "was expecting identifier but found: '%.*s'",
+                      (Sint32)token->val_len, token->val_start);
+
+    case ix_state_assign:
+      if (punct && *token->val_start == '=') {
+        walk->state = ix_state_value;
+        return true;
+      }
+
+      if (punct && *token->val_start == '{') {
+        XYZ_SCFValue value = {0};
+        value.type = XYZ_SCF_VALUE_TYPE_TABLE;
+        value.as_table = XYZ_SCFTableCreateWithArena(parser->arena);
+        if (value.as_table == NULL) {
+          return false;
+        }
+
+        if (XYZ_SCFTableAppend(table, walk->key, walk->key_len, value,
+                               flags) == NULL ||
+            !ix_reserve((void**)&walk->stack, &walk->stack_cap,
+                        walk->depth + 1, sizeof(XYZ_SCFTable*))) {
+          return false;
+        }
+
+        walk->stack[walk->depth++] = value.as_table;
+        walk->state = ix_state_key;
+        return true;
+      }
+
+      return error_at(&parser->error, token,
+                      XYZ_SCF_EXPECT_ASSIGN | XYZ_SCF_EXPECT_BLOCK,
+                      "was expecting assign '=' or block '{' but found: '%.*s'",
+                      (Sint32)token->val_len, token->val_start);
+
+    case ix_state_value: {
+      // parse the token as the only token of its own input
+      XYZ_SCFParser value_parser = {0};
+      value_parser.arena = parser->arena;
+      value_parser.flags = parser->flags;
+      value_parser.cur = *token;
+      value_parser.cur.buf_start = token->val_start;
+      value_parser.cur.buf_len = token->val_len;
+      bool array = punct && *token->val_start == '[';
+      if (array) {
+        // the elements follow, let it read up to the end of the input
+        value_parser.cur.buf_len = walk->end - token->val_start;
+      }
+
+      XYZ_SCFValue value = {0};
+      if (!parse_value(&value_parser, &value)) {
+        parser->error = value_parser.error;
+        parser->error.offset += token->val_start - walk->data;
+        return false;
+      }
+      if (array) {
+        walk->resume = value_parser.cur.val_start;
+      }
+
+      if ((parser->flags & XYZ_SCF_PARSE_ZERO_COPY) &&
+          value.type == XYZ_SCF_VALUE_TYPE_STRING) {
+        flags |= XYZ_SCF_PAIR_FLAG_STRING_VIEW;
+      }
+      if (XYZ_SCFTableAppend(table, walk->key, walk->key_len, value, flags) ==
+          NULL) {
+        return false;
+      }
+
+      walk->state = ix_state_key;
+      return true;
+    }
+
+    default:
+      SDL_SetError("invalid parser state: %d", walk->state);
+      return false;
+  }
+}
+
+Uint64 ix_prefix_xor(Uint64 bits) {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+Uint32 ix_ctz64(Uint64 bits) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (Uint32)__builtin_ctzll(bits);
+#else
+  Uint32 index = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+bool ix_unterminated(XYZ_SCFStructuralIndex* index, size_t at, Uint64 opening) {
+  Uint32 quote = 0;
+  if (opening != 0) {
+    // the last one opened the string that does not end
+    while ((opening & (opening - 1)) != 0) {
+      opening &= opening - 1;
+    }
+    quote = (Uint32)at + ix_ctz64(opening);
+  } else if (index->count > 0) {
+    quote = index->positions[index->count - 1];
+  }
+
+  index->open_quote = quote + 1;
+  return SDL_SetError("unterminated string");
+}
+
+ix_classify_fn ix_get_classify(void) {
+  switch (XYZ_SCFGetLexerKernel()) {
+#ifdef SDL_AVX2_INTRINSICS
+    case XYZ_SCF_LEXER_KERNEL_AVX2:
+      return ix_classify_avx2;
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    case XYZ_SCF_LEXER_KERNEL_SSE2:
+      return ix_classify_sse2;
+#endif
+    default:
+      return ix_classify_scalar;
+  }
+}
+
+void ix_classify_scalar(const char* block, ix_masks* masks) {
+  *masks = (ix_masks){0};
+  for (Uint32 i = 0; i < IX_BLOCK; i++) {
+    Uint64 bit = (Uint64)1 << i;
+    switch (block[i]) {
+      case '"':
+        masks->quote |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case '=':
+        masks->punct |= bit;
+        break;
+      case '\n':
+        masks->newline |= bit;
+        masks->blank |= bit;
+        break;
+      case ' ':
+      case '\t':
+        masks->blank |= bit;
+        break;
+      case '\0':
+        masks->nul |= bit;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+SDL_TARGETING("sse2")
+void ix_classify_sse2(const char* block, ix_masks* masks) {
+  const __m128i quote = _mm_set1_epi8('"');
+  // clearing 0x20 folds braces onto brackets, two compares find all four
+  const __m128i fold = _mm_set1_epi8(~0x20);
+  const __m128i open = _mm_set1_epi8('[');
+  const __m128i close = _mm_set1_epi8(']');
+  const __m128i assign = _mm_set1_epi8('=');
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i zero = _mm_setzero_si128();
+  *masks = (ix_masks){0};
+  for (Uint32 i = 0; i < IX_BLOCK; i += 16) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)(block + i));
+    __m128i lines = _mm_cmpeq_epi8(chunk, newline);
+    __m128i folded = _mm_and_si128(chunk, fold);
+    __m128i punct = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open),
+                                              _mm_cmpeq_epi8(folded, close)),
+                                 _mm_cmpeq_epi8(chunk, assign));
+    __m128i blank = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+        lines);
+    masks->quote |=
+        (Uint64)(Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)) << i;
+    masks->punct |= (Uint64)(Uint32)_mm_movemask_epi8(punct) << i;
+    masks->blank |= (Uint64)(Uint32)_mm_movemask_epi8(blank) << i;
+    masks->newline |= (Uint64)(Uint32)_mm_movemask_epi8(lines) << i;
+    masks->nul |=
+        (Uint64)(Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero)) << i;
+  }
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+void ix_classify_avx2(const char* block, ix_masks* masks) {
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i fold = _mm256_set1_epi8(~0x20);
+  const __m256i open = _mm256_set1_epi8('[');
+  const __m256i close = _mm256_set1_epi8(']');
+  const __m256i assign = _mm256_set1_epi8('=');
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i zero = _mm256_setzero_si256();
+  *masks = (ix_masks){0};
+  for (Uint32 i = 0; i < IX_BLOCK; i += 32) {
+    __m256i chunk = _mm256_loadu_si256((const __m256i*)(block + i));
+    __m256i lines = _mm256_cmpeq_epi8(chunk, newline);
+    __m256i folded = _mm256_and_si256(chunk, fold);
+    __m256i punct = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(folded, open),
+                        _mm256_cmpeq_epi8(folded, close)),
+        _mm256_cmpeq_epi8(chunk, assign));
+    __m256i blank = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+                        _mm256_cmpeq_epi8(chunk, tab)),
+        lines);
+    masks->quote |= (Uint64)(Uint32)_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi8(chunk, quote))
+                    << i;
+    masks->punct |= (Uint64)(Uint32)_mm256_movemask_epi8(punct) << i;
+    masks->blank |= (Uint64)(Uint32)_mm256_movemask_epi8(blank) << i;
+    masks->newline |= (Uint64)(Uint32)_mm256_movemask_epi8(lines) << i;
+    masks->nul |= (Uint64)(Uint32)_mm256_movemask_epi8(
+                      _mm256_cmpeq_epi8(chunk, zero))
+                  << i;
+  }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+XYZ_SCFToken ix_token_at(const ix_walk* walk, const char* at) {
+  XYZ_SCFToken token = {0};
+  token.buf_start = walk->data;
+  token.val_start = at;
+  token.line_start = at;
+  return token;
+}
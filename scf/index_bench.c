@@ -0,0 +1,76 @@
+#include <scf/scf.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_SIZE (32 * 1024 * 1024)
+#define BENCH_ROUNDS 5
+
+int main(void) {
+  size_t len = 0;
+  char* data = bench_generate_config(BENCH_SIZE, &len);
+  if (data == NULL) {
+    return 1;
+  }
+
+  const struct {
+    const char* name;
+    XYZ_SCFLexerKernel kernel;
+  } kernels[] = {
+      {"scalar", XYZ_SCF_LEXER_KERNEL_SCALAR},
+      {"sse2", XYZ_SCF_LEXER_KERNEL_SSE2},
+      {"avx2", XYZ_SCF_LEXER_KERNEL_AVX2},
+  };
+
+  double mb = (double)len / (1024.0 * 1024.0);
+  XYZ_SCFStructuralIndex index = {0};
+  for (size_t k = 0; k < SDL_arraysize(kernels); k++) {
+    if (!XYZ_SCFSetLexerKernel(kernels[k].kernel)) {
+      SDL_Log("%-8s not supported", kernels[k].name);
+      continue;
+    }
+
+    double build = 0.0;
+    double parse = 0.0;
+    double indexed = 0.0;
+    for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+      Uint64 start = SDL_GetPerformanceCounter();
+      bool built = XYZ_SCFStructuralIndexBuild(&index, data, len);
+      double elapsed = bench_elapsed(start);
+      build = round == 0 ? elapsed : SDL_min(build, elapsed);
+
+      start = SDL_GetPerformanceCounter();
+      XYZ_SCFDocument* doc =
+          XYZ_SCFParseDocument(data, len, XYZ_SCF_PARSE_ZERO_COPY);
+      elapsed = bench_elapsed(start);
+      parse = round == 0 ? elapsed : SDL_min(parse, elapsed);
+      XYZ_SCFDocumentDestroy(doc);
+
+      start = SDL_GetPerformanceCounter();
+      XYZ_SCFDocument* indexed_doc = XYZ_SCFParseDocument(
+          data, len, XYZ_SCF_PARSE_ZERO_COPY | XYZ_SCF_PARSE_INDEXED);
+      elapsed = bench_elapsed(start);
+      indexed = round == 0 ? elapsed : SDL_min(indexed, elapsed);
+      XYZ_SCFDocumentDestroy(indexed_doc);
+
+      if (!built || doc == NULL || indexed_doc == NULL) {
+        SDL_Log("%s: parse failed: %s", kernels[k].name, SDL_GetError());
+        return 1;
+      }
+    }
+
+    SDL_Log("%-8s index %8.1f MB/s, parse %8.1f MB/s, indexed parse %8.1f "
+            "MB/s (%zu positions, %.1f MB)",
+            kernels[k].name, mb / build, mb / parse, mb / indexed,
+            index.count, mb);
+  }
+
+  XYZ_SCFStructuralIndexDestroy(&index);
+  XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_AUTO);
+  SDL_free(data);
+  return 0;
+}
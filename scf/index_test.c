@@ -0,0 +1,294 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/index.h>
+#include <scf/lexer.h>
+#include <scf/parser.h>
+
+#include <SDL3/SDL_error.h>
+
+static const XYZ_SCFLexerKernel kernels[] = {
+    XYZ_SCF_LEXER_KERNEL_SCALAR,
+    XYZ_SCF_LEXER_KERNEL_SSE2,
+    XYZ_SCF_LEXER_KERNEL_AVX2,
+};
+
+static bool same_arrays(XYZ_SCFValue* a, XYZ_SCFValue* b) {
+  if (a->count != b->count) {
+    return false;
+  }
+
+  for (Uint32 i = 0; i < a->count; i++) {
+    bool same = true;
+    switch (a->type) {
+      case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+        same = a->as_bools[i] == b->as_bools[i];
+        break;
+      case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+        same = a->as_i32s[i] == b->as_i32s[i];
+        break;
+      case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+        same = a->as_f32s[i] == b->as_f32s[i];
+        break;
+      default:
+        same = SDL_strcmp(a->as_strings[i], b->as_strings[i]) == 0;
+        break;
+    }
+    if (!same) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// same pairs in the same order, all the way down; XYZ_SCFTableEqual would
+// not do as it only sees the last of duplicated keys
+static bool same_tables(XYZ_SCFTable* a, XYZ_SCFTable* b) {
+  if (a->pair_count != b->pair_count) {
+    return false;
+  }
+
+  for (Uint32 i = 0; i < a->pair_count; i++) {
+    XYZ_SCFPair* pa = &a->pairs[i];
+    XYZ_SCFPair* pb = &b->pairs[i];
+    XYZ_SCFValue* va = &pa->value;
+    XYZ_SCFValue* vb = &pb->value;
+    if (pa->key_len != pb->key_len || pa->flags != pb->flags ||
+        SDL_memcmp(pa->key, pb->key, pa->key_len) != 0 ||
+        va->type != vb->type) {
+      return false;
+    }
+
+    bool same = true;
+    switch (va->type) {
+      case XYZ_SCF_VALUE_TYPE_BOOL:
+        same = va->as_bool == vb->as_bool;
+        break;
+      case XYZ_SCF_VALUE_TYPE_I32:
+        same = va->as_i32 == vb->as_i32;
+        break;
+      case XYZ_SCF_VALUE_TYPE_F32:
+        same = va->as_f32 == vb->as_f32;
+        break;
+      case XYZ_SCF_VALUE_TYPE_STRING:
+        same = va->str_len == vb->str_len &&
+               SDL_memcmp(va->as_string, vb->as_string, va->str_len) == 0;
+        break;
+      case XYZ_SCF_VALUE_TYPE_TABLE:
+        same = same_tables(va->as_table, vb->as_table);
+        break;
+      default:
+        same = !XYZ_SCFIsArrayType(va->type) || same_arrays(va, vb);
+        break;
+    }
+    if (!same) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// parse src with both engines, returns whether they agree; tables come from
+// an arena as the recursive parser leaves what it built behind on errors
+static bool differential(const char* src, size_t len, Uint32 flags) {
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  XYZ_SCFParser parser = {.arena = &arena, .flags = flags};
+  XYZ_SCFParserSetFile(&parser, src, len);
+  XYZ_SCFTable* expected = XYZ_SCFTableCreateWithArena(&arena);
+  bool expected_parsed = XYZ_SCFParseTable(&parser, expected);
+
+  XYZ_SCFParserSetFile(&parser, src, len);
+  XYZ_SCFTable* table = XYZ_SCFTableCreateWithArena(&arena);
+  bool parsed = XYZ_SCFParseTableIndexed(&parser, table);
+
+  bool same = parsed == expected_parsed;
+  if (same && parsed) {
+    same = same_tables(expected, table);
+  }
+
+  XYZ_SCFArenaDestroy(&arena);
+  return same;
+}
+
+static void index_positions(void** state) {
+  (void)state;
+
+  const char* src = "ab = \"x {y}\" c{d=-1.5}\n";
+  const Uint32 expected[] = {0, 3, 5, 11, 13, 14, 15, 16, 17, 21, 23};
+  for (size_t k = 0; k < SDL_arraysize(kernels); k++) {
+    assert_true(XYZ_SCFSetLexerKernel(kernels[k]));
+    XYZ_SCFStructuralIndex index = {0};
+    assert_true(XYZ_SCFStructuralIndexBuild(&index, src, SDL_strlen(src)));
+    assert_int_equal(index.count, SDL_arraysize(expected));
+    for (size_t i = 0; i < index.count; i++) {
+      assert_int_equal(index.positions[i], expected[i]);
+    }
+    XYZ_SCFStructuralIndexDestroy(&index);
+  }
+
+  // a NUL byte ends the input
+  XYZ_SCFStructuralIndex index = {0};
+  assert_true(XYZ_SCFStructuralIndexBuild(&index, "a = 1\0b = 2", 11));
+  assert_int_equal(index.count, 4);
+  assert_int_equal(index.positions[3], 5);
+  XYZ_SCFStructuralIndexDestroy(&index);
+
+  XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_AUTO);
+}
+
+static void index_differential(void** state) {
+  (void)state;
+
+  const char* srcs[] = {
+      "name = \"h\xc3\xa9ro \xe2\x9c\x93\" lives = 3 floor = -12 "
+      "speed = 12.75 god = false none = nil\n"
+      "video {\n  width = 1280\n  display { index = 2 title = \"\" }\n}\n"
+      "audio {} tail = true",
+      "a=1 b{c=\"{=}\"d{}}e=-.5 f=7. g=-",
+      "x = 1abc = 2 _k9 = \"s\"y = true e = 1e3 E = -2.5E-2 p = 3e+1",
+      "a = 1\0b = ",
+      "dup = 1 dup = \"two\" dup { three = 3 }",
+      "\t\n  \n",
+      "a = [1 -2 3] b=[\"x ]\" \"\"]c=[.5 1]d{e=[true]}f = [ ] g=[]h=1",
+  };
+
+  // shift every input over a whole block so each token lands on every
+  // offset of the 64 byte blocks at least once
+  char buf[512];
+  for (size_t k = 0; k < SDL_arraysize(kernels); k++) {
+    assert_true(XYZ_SCFSetLexerKernel(kernels[k]));
+    for (size_t s = 0; s < SDL_arraysize(srcs); s++) {
+      size_t len = s == 3 ? 10 : SDL_strlen(srcs[s]);
+      for (size_t pad = 0; pad <= 64; pad++) {
+        SDL_memset(buf, ' ', pad);
+        SDL_memcpy(buf + pad, srcs[s], len);
+        assert_true(differential(buf, pad + len, 0));
+        assert_true(differential(buf, pad + len, XYZ_SCF_PARSE_ZERO_COPY));
+      }
+    }
+  }
+
+  XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_AUTO);
+}
+
+static void index_random(void** state) {
+  (void)state;
+
+  // random runs of tokens, valid or not, both engines must agree on every
+  // one of them; pieces never put together bytes the lexer does not know,
+  // which it skips and the indexed parser rejects
+  const char* pieces[] = {
+      "a", "b1", "_c", " = ", "=", "{", "}", " { ", "1", "-2", " 3.5 ",
+      "-", "nil", "true ", " ", "\n", "\t", "\"", "x\n", "\"\"", " 4. ",
+      "e", " 2e5 ", " 1e-3 ", " 6E+1 ", "\"s t\"", "[", "]", " [1 2] ",
+  };
+  char buf[256];
+  Uint32 seed = 12345;
+  for (Sint32 round = 0; round < 20000; round++) {
+    size_t len = 0;
+    seed = seed * 1103515245 + 12345;
+    Uint32 count = (seed >> 16) % 24 + 1;
+    for (Uint32 i = 0; i < count; i++) {
+      seed = seed * 1103515245 + 12345;
+      const char* piece = pieces[(seed >> 16) % SDL_arraysize(pieces)];
+      size_t piece_len = SDL_strlen(piece);
+      SDL_memcpy(buf + len, piece, piece_len);
+      len += piece_len;
+    }
+    Uint32 flags = seed & 1 ? XYZ_SCF_PARSE_ZERO_COPY : 0;
+    assert_true(differential(buf, len, flags));
+  }
+}
+
+static void index_errors(void** state) {
+  (void)state;
+
+  const char* bad[] = {
+      "key = \"never ends", "video { width = 1", "key =",    "key",
+      "key = 1 }",          "key = {",           "= 1",      "a = 1 b 2",
+      "key = \"new\nline\"", "key = \"nul\0\"",
+  };
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    XYZ_SCFParser parser = {0};
+    XYZ_SCFParserSetFile(&parser, bad[i], SDL_strlen(bad[i]) + (i == 9));
+    XYZ_SCFTable* table = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTableIndexed(&parser, table));
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+  }
+
+  // errors are placed where the recursive parser places them
+  const char* placed[] = {
+      "a = 1\nvideo {\n  width = }", "a = 1 b 2", "a = 1\n}", "a { b = 1",
+      "a = 1\n\tb = @", "a = [1 2 true]", "a = [1\n2", "a = [1 } b = 2",
+      "a = 1\nb = \"open", "a = \"new\nline\"", "a = \"x\" b = \"y\n\"",
+  };
+  for (size_t i = 0; i < SDL_arraysize(placed); i++) {
+    size_t len = SDL_strlen(placed[i]);
+    XYZ_SCFParser expected = {0};
+    XYZ_SCFParser parser = {0};
+    XYZ_SCFParserSetFile(&expected, placed[i], len);
+    XYZ_SCFParserSetFile(&parser, placed[i], len);
+    XYZ_SCFTable* table = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTable(&expected, table));
+    XYZ_SCFTableDestroy(table);
+    assert_false(XYZ_SCFParseTableIndexed(&parser, table));
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+
+    assert_int_equal(parser.error.offset, expected.error.offset);
+    assert_int_equal(parser.error.line, expected.error.line);
+    assert_int_equal(parser.error.col, expected.error.col);
+  }
+
+  // unterminated strings are placed at their opening quote, also when it is
+  // blocks before where they fail
+  char long_string[200] = "a = 1\nb = \"";
+  SDL_memset(long_string + 11, 'x', sizeof(long_string) - 12);
+  char long_line[200];
+  SDL_memcpy(long_line, long_string, sizeof(long_line));
+  long_line[150] = '\n';
+  const char* open[] = {"a = 1\nb = \"open", long_string, long_line};
+  for (size_t i = 0; i < SDL_arraysize(open); i++) {
+    XYZ_SCFParser parser = {0};
+    XYZ_SCFParserSetFile(&parser, open[i], SDL_strlen(open[i]));
+    XYZ_SCFTable* table = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTableIndexed(&parser, table));
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+
+    assert_int_equal(parser.error.offset, 10);
+    assert_int_equal(parser.error.line, 2);
+    assert_int_equal(parser.error.col, 5);
+    assert_string_equal(SDL_GetError(),
+                        "line 2, column 5: unterminated string");
+  }
+
+  // unknown characters are errors, not skipped
+  const char* unknown[] = {"a = @", "a = 1.2.3", "\xc3\xa9 = 1"};
+  for (size_t i = 0; i < SDL_arraysize(unknown); i++) {
+    XYZ_SCFParser parser = {0};
+    XYZ_SCFParserSetFile(&parser, unknown[i], SDL_strlen(unknown[i]));
+    XYZ_SCFTable* table = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTableIndexed(&parser, table));
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+  }
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(index_positions),
+      cmocka_unit_test(index_differential),
+      cmocka_unit_test(index_random),
+      cmocka_unit_test(index_errors),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,458 @@
+#include "scf/layer.h"
+#include "scf/path.h"
+#include "scf/table.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+#define XYZ_SCF_LAYER_MIN_SLOTS 16
+
+// shared with table.c, allocate from arena or from the heap when it is NULL
+void* table_alloc(XYZ_SCFArena* arena, size_t size);
+// handle to a pair of table
+XYZ_SCFKey table_key(XYZ_SCFTable* table, const XYZ_SCFPair* pair);
+// find the pair for a key of known length and hash, atom may be
+// XYZ_SCF_NO_ATOM
+XYZ_SCFPair* table_find_hashed(XYZ_SCFTable* table,
+                               const char* key,
+                               size_t key_len,
+                               Uint32 hash,
+                               XYZ_SCFAtom atom);
+// shared with path.c, find the pair of a segment in table
+XYZ_SCFPair* path_find(XYZ_SCFTable* table,
+                       const XYZ_SCFPathSegment* segment);
+// find path in a single layer, shadowed when a segment before the last holds
+// something else than a table, hiding the layers below; the handle has no
+// table when the layer does not have path
+XYZ_SCFKey layer_find(XYZ_SCFTable* table,
+                      const XYZ_SCFPath* path,
+                      bool* shadowed);
+// walk the stack from the top, filling key and layer of slot
+void layer_search(XYZ_SCFLayers* layers,
+                  const XYZ_SCFPath* path,
+                  XYZ_SCFLayerSlot* slot);
+// cached slot for a path, NULL if it was not looked up yet
+XYZ_SCFLayerSlot* layer_cache_find(XYZ_SCFLayers* layers,
+                                   const char* path,
+                                   size_t path_len,
+                                   Uint32 hash);
+// copy slot and its path into the cache, NULL if out of memory
+XYZ_SCFLayerSlot* layer_cache_insert(XYZ_SCFLayers* layers,
+                                     const XYZ_SCFLayerSlot* slot);
+bool layer_cache_grow(XYZ_SCFLayers* layers);
+// merge src into dst, copying whatever dst does not already have as a table
+bool layer_merge(XYZ_SCFTable* dst, XYZ_SCFTable* src);
+// deep copy the value of pair into arena, or the heap when it is NULL
+bool layer_copy(XYZ_SCFArena* arena,
+                const XYZ_SCFPair* pair,
+                XYZ_SCFValue* value);
+// free the value of a heap pair that is about to be replaced
+void layer_release(XYZ_SCFPair* pair);
+
+void XYZ_SCFLayersInit(XYZ_SCFLayers* layers) {
+  SDL_assert(layers != NULL && "XYZ_SCFLayersInit: layers cannot be NULL");
+  SDL_memset(layers, 0, sizeof(XYZ_SCFLayers));
+  XYZ_SCFArenaInit(&layers->paths, 0);
+}
+
+void XYZ_SCFLayersDestroy(XYZ_SCFLayers* layers) {
+  SDL_assert(layers != NULL && "XYZ_SCFLayersDestroy: layers cannot be NULL");
+  if (layers->top != NULL) {
+    XYZ_SCFTableDestroy(layers->top);
+    SDL_free(layers->top);
+  }
+  SDL_free(layers->layers);
+  SDL_free(layers->slots);
+  XYZ_SCFArenaDestroy(&layers->paths);
+  SDL_memset(layers, 0, sizeof(XYZ_SCFLayers));
+}
+
+bool XYZ_SCFLayersPush(XYZ_SCFLayers* layers, XYZ_SCFTable* table) {
+  SDL_assert(layers != NULL && "XYZ_SCFLayersPush: layers cannot be NULL");
+  SDL_assert(table != NULL && "XYZ_SCFLayersPush: table cannot be NULL");
+  if (layers->layer_count == layers->layer_cap) {
+    Uint32 cap = SDL_max(layers->layer_cap * 2, 4);
+    XYZ_SCFTable** grown =
+        SDL_realloc(layers->layers, cap * sizeof(XYZ_SCFTable*));
+    if (grown == NULL) {
+      return false;
+    }
+    layers->layers = grown;
+    layers->layer_cap = cap;
+  }
+
+  layers->layers[layers->layer_count++] = table;
+  XYZ_SCFLayersInvalidate(layers);
+  return true;
+}
+
+void XYZ_SCFLayersInvalidate(XYZ_SCFLayers* layers) {
+  SDL_assert(layers != NULL &&
+             "XYZ_SCFLayersInvalidate: layers cannot be NULL");
+  if (layers->path_count == 0) {
+    return;
+  }
+
+  SDL_memset(layers->slots, 0, layers->slot_count * sizeof(XYZ_SCFLayerSlot));
+  layers->path_count = 0;
+  XYZ_SCFArenaDestroy(&layers->paths);
+  XYZ_SCFArenaInit(&layers->paths, 0);
+}
+
+bool XYZ_SCFLayersResolve(XYZ_SCFLayers* layers,
+                          const char* path,
+                          XYZ_SCFKey* handle,
+                          Uint32* layer) {
+  SDL_assert(layers != NULL && "XYZ_SCFLayersResolve: layers cannot be NULL");
+  SDL_assert(path != NULL && "XYZ_SCFLayersResolve: path cannot be NULL");
+  SDL_assert(handle != NULL && "XYZ_SCFLayersResolve: handle cannot be NULL");
+
+  size_t path_len = SDL_strlen(path);
+  Uint32 hash = XYZ_SCFHashKey(path, path_len);
+  XYZ_SCFLayerSlot found = {0};
+  XYZ_SCFLayerSlot* slot = layer_cache_find(layers, path, path_len, hash);
+  if (slot == NULL) {
+    XYZ_SCFPath compiled = {0};
+    if (!XYZ_SCFPathCompile(&compiled, path)) {
+      return false;
+    }
+
+    found.hash = hash;
+    found.path_len = (Uint32)path_len;
+    found.path = path;
+    layer_search(layers, &compiled, &found);
+
+    // a full cache only costs the next lookup another search
+    slot = layer_cache_insert(layers, &found);
+    if (slot == NULL) {
+      slot = &found;
+    }
+  }
+
+  if (slot->key.table == NULL) {
+    SDL_SetError("key not found: %s", path);
+    return false;
+  }
+
+  *handle = slot->key;
+  if (layer != NULL) {
+    *layer = slot->layer;
+  }
+  return true;
+}
+
+bool XYZ_SCFLayersGet(XYZ_SCFLayers* layers,
+                      const char* path,
+                      XYZ_SCFValue* value) {
+  SDL_assert(value != NULL && "XYZ_SCFLayersGet: value cannot be NULL");
+  XYZ_SCFKey key = {0};
+  if (!XYZ_SCFLayersResolve(layers, path, &key, NULL)) {
+    return false;
+  }
+
+  *value = *XYZ_SCFKeyValue(key);
+  return true;
+}
+
+bool XYZ_SCFLayersGetBool(XYZ_SCFLayers* layers,
+                          const char* path,
+                          bool* value) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFLayersResolve(layers, path, &key, NULL) &&
+         XYZ_SCFKeyGetBool(key, value);
+}
+
+bool XYZ_SCFLayersGetI32(XYZ_SCFLayers* layers,
+                         const char* path,
+                         Sint32* value) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFLayersResolve(layers, path, &key, NULL) &&
+         XYZ_SCFKeyGetI32(key, value);
+}
+
+bool XYZ_SCFLayersGetF32(XYZ_SCFLayers* layers,
+                         const char* path,
+                         float* value) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFLayersResolve(layers, path, &key, NULL) &&
+         XYZ_SCFKeyGetF32(key, value);
+}
+
+bool XYZ_SCFLayersGetStringView(XYZ_SCFLayers* layers,
+                                const char* path,
+                                const char** value,
+                                size_t* value_len) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFLayersResolve(layers, path, &key, NULL) &&
+         XYZ_SCFKeyGetStringView(key, value, value_len);
+}
+
+bool XYZ_SCFLayersSet(XYZ_SCFLayers* layers,
+                      const char* path,
+                      XYZ_SCFValue value) {
+  SDL_assert(layers != NULL && "XYZ_SCFLayersSet: layers cannot be NULL");
+  SDL_assert(path != NULL && "XYZ_SCFLayersSet: path cannot be NULL");
+
+  XYZ_SCFPath compiled = {0};
+  if (!XYZ_SCFPathCompile(&compiled, path)) {
+    return false;
+  }
+
+  if (layers->top == NULL) {
+    layers->top = XYZ_SCFTableCreate();
+    if (layers->top == NULL) {
+      return false;
+    }
+  }
+
+  // overwriting an earlier edit in place only changes the value behind
+  // pairs already cached, anything else can move the winner of other paths
+  bool shadowed = false;
+  XYZ_SCFKey key = layer_find(layers->top, &compiled, &shadowed);
+  if (key.table == NULL) {
+    XYZ_SCFLayersInvalidate(layers);
+    return XYZ_SCFPathSet(layers->top, &compiled, value);
+  }
+
+  XYZ_SCFPair* pair = XYZ_SCFKeyPair(key);
+  if (pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE ||
+      value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+    XYZ_SCFLayersInvalidate(layers);
+  }
+  layer_release(pair);
+  XYZ_SCFKeySet(key, value);
+  return true;
+}
+
+XYZ_SCFTable* XYZ_SCFLayersFlatten(XYZ_SCFLayers* layers, XYZ_SCFArena* arena) {
+  SDL_assert(layers != NULL && "XYZ_SCFLayersFlatten: layers cannot be NULL");
+  XYZ_SCFTable* flat = XYZ_SCFTableCreateWithArena(arena);
+  if (flat == NULL) {
+    return NULL;
+  }
+
+  bool ok = true;
+  for (Uint32 i = 0; ok && i < layers->layer_count; i++) {
+    ok = layer_merge(flat, layers->layers[i]);
+  }
+  if (ok && layers->top != NULL) {
+    ok = layer_merge(flat, layers->top);
+  }
+
+  if (!ok) {
+    if (arena == NULL) {
+      XYZ_SCFTableDestroy(flat);
+      SDL_free(flat);
+    }
+    return NULL;
+  }
+  return flat;
+}
+
+XYZ_SCFKey layer_find(XYZ_SCFTable* table,
+                      const XYZ_SCFPath* path,
+                      bool* shadowed) {
+  for (Uint32 i = 0;; i++) {
+    const XYZ_SCFPathSegment* segment = &path->segments[i];
+    XYZ_SCFPair* pair = path_find(table, segment);
+    if (pair == NULL) {
+      return (XYZ_SCFKey){0};
+    }
+    if (i + 1 == path->count) {
+      return table_key(table, pair);
+    }
+
+    if (pair->value.type != XYZ_SCF_VALUE_TYPE_TABLE) {
+      *shadowed = true;
+      return (XYZ_SCFKey){0};
+    }
+    table = pair->value.as_table;
+  }
+}
+
+void layer_search(XYZ_SCFLayers* layers,
+                  const XYZ_SCFPath* path,
+                  XYZ_SCFLayerSlot* slot) {
+  bool shadowed = false;
+  if (layers->top != NULL) {
+    slot->key = layer_find(layers->top, path, &shadowed);
+    slot->layer = layers->layer_count;
+  }
+
+  for (Uint32 i = layers->layer_count;
+       i > 0 && slot->key.table == NULL && !shadowed; i--) {
+    slot->key = layer_find(layers->layers[i - 1], path, &shadowed);
+    slot->layer = i - 1;
+  }
+}
+
+XYZ_SCFLayerSlot* layer_cache_find(XYZ_SCFLayers* layers,
+                                   const char* path,
+                                   size_t path_len,
+                                   Uint32 hash) {
+  if (layers->slot_count == 0) {
+    return NULL;
+  }
+
+  Uint32 mask = layers->slot_count - 1;
+  for (Uint32 i = hash & mask;; i = (i + 1) & mask) {
+    XYZ_SCFLayerSlot* slot = &layers->slots[i];
+    if (slot->path == NULL) {
+      return NULL;
+    }
+
+    if (slot->hash == hash && slot->path_len == path_len &&
+        SDL_memcmp(slot->path, path, path_len) == 0) {
+      return slot;
+    }
+  }
+}
+
+XYZ_SCFLayerSlot* layer_cache_insert(XYZ_SCFLayers* layers,
+                                     const XYZ_SCFLayerSlot* slot) {
+  if ((layers->path_count + 1) * 4 > layers->slot_count * 3 &&
+      !layer_cache_grow(layers)) {
+    return NULL;
+  }
+
+  char* path = XYZ_SCFArenaAlloc(&layers->paths, slot->path_len + 1);
+  if (path == NULL) {
+    return NULL;
+  }
+  SDL_memcpy(path, slot->path, slot->path_len);
+
+  Uint32 mask = layers->slot_count - 1;
+  Uint32 i = slot->hash & mask;
+  while (layers->slots[i].path != NULL) {
+    i = (i + 1) & mask;
+  }
+
+  layers->slots[i] = *slot;
+  layers->slots[i].path = path;
+  layers->path_count++;
+  return &layers->slots[i];
+}
+
+bool layer_cache_grow(XYZ_SCFLayers* layers) {
+  Uint32 slot_count = SDL_max(layers->slot_count * 2, XYZ_SCF_LAYER_MIN_SLOTS);
+  XYZ_SCFLayerSlot* slots = SDL_calloc(slot_count, sizeof(XYZ_SCFLayerSlot));
+  if (slots == NULL) {
+    return false;
+  }
+
+  Uint32 mask = slot_count - 1;
+  for (Uint32 i = 0; i < layers->slot_count; i++) {
+    XYZ_SCFLayerSlot* old = &layers->slots[i];
+    if (old->path == NULL) {
+      continue;
+    }
+
+    Uint32 j = old->hash & mask;
+    while (slots[j].path != NULL) {
+      j = (j + 1) & mask;
+    }
+    slots[j] = *old;
+  }
+
+  SDL_free(layers->slots);
+  layers->slots = slots;
+  layers->slot_count = slot_count;
+  return true;
+}
+
+bool layer_merge(XYZ_SCFTable* dst, XYZ_SCFTable* src) {
+  // a lazy block that fails to parse is not merged as an empty one
+  if (!XYZ_SCFTableExpand(dst) || !XYZ_SCFTableExpand(src)) {
+    return false;
+  }
+
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(src);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    const XYZ_SCFPair* pair = cursor.pair;
+    XYZ_SCFPair* cur = table_find_hashed(dst, pair->key, pair->key_len,
+                                         pair->key_hash, pair->key_atom);
+    if (cur != NULL && cur->value.type == XYZ_SCF_VALUE_TYPE_TABLE &&
+        pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+      if (!layer_merge(cur->value.as_table, pair->value.as_table)) {
+        return false;
+      }
+      continue;
+    }
+
+    XYZ_SCFValue value = {0};
+    if (!layer_copy(dst->arena, pair, &value)) {
+      return false;
+    }
+
+    if (cur != NULL) {
+      layer_release(cur);
+      XYZ_SCFKeySet(table_key(dst, cur), value);
+      continue;
+    }
+
+    // interned keys stay interned, the copy shares them
+    Uint32 flags = pair->flags & XYZ_SCF_PAIR_FLAG_KEY_ATOM;
+    if (XYZ_SCFTableAppend(dst, pair->key, pair->key_len, value, flags) ==
+        NULL) {
+      if (dst->arena == NULL) {
+        XYZ_SCFPair owner = {.value = value};
+        layer_release(&owner);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+bool layer_copy(XYZ_SCFArena* arena,
+                const XYZ_SCFPair* pair,
+                XYZ_SCFValue* value) {
+  *value = pair->value;
+  if (pair->value.type == XYZ_SCF_VALUE_TYPE_STRING) {
+    size_t len = XYZ_SCFPairStringLen(pair);
+    char* str = table_alloc(arena, len + 1);
+    if (str == NULL) {
+      return false;
+    }
+    SDL_memcpy(str, pair->value.as_string, len);
+    str[len] = '\0';
+    value->as_string = str;
+    value->str_len = (Uint32)len;
+  } else if (pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+    XYZ_SCFTable* table = XYZ_SCFTableCreateWithArena(arena);
+    if (table == NULL) {
+      return false;
+    }
+
+    if (!layer_merge(table, pair->value.as_table)) {
+      if (arena == NULL) {
+        XYZ_SCFTableDestroy(table);
+        SDL_free(table);
+      }
+      return false;
+    }
+    value->as_table = table;
+  } else if (XYZ_SCFIsArrayType(pair->value.type)) {
+    return XYZ_SCFArrayCreate(arena, pair->value.type, pair->value.as_array,
+                              pair->value.count, value);
+  }
+  return true;
+}
+
+void layer_release(XYZ_SCFPair* pair) {
+  if (pair->flags & XYZ_SCF_PAIR_FLAG_ARENA) {
+    return;
+  }
+
+  XYZ_SCFValue value = pair->value;
+  if (value.type == XYZ_SCF_VALUE_TYPE_STRING &&
+      !(pair->flags & XYZ_SCF_PAIR_FLAG_STRING_VIEW)) {
+    SDL_free(value.as_string);
+  } else if (value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+    XYZ_SCFTableDestroy(value.as_table);
+    SDL_free(value.as_table);
+  } else if (XYZ_SCFIsArrayType(value.type)) {
+    SDL_free(value.as_array);
+  }
+}
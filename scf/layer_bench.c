@@ -0,0 +1,101 @@
+#include <scf/layer.h>
+#include <scf/scf.h>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_SIZE (256 * 1024)
+#define BENCH_LAYERS 5
+#define BENCH_KEYS 64
+#define BENCH_READS 1000000
+#define BENCH_ROUNDS 5
+
+int main(void) {
+  size_t len = 0;
+  char* data = bench_generate_config(BENCH_SIZE, &len);
+  if (data == NULL) {
+    return 1;
+  }
+
+  // the same file stands in for defaults, platform, user and so on
+  XYZ_SCFDocument* docs[BENCH_LAYERS] = {0};
+  for (Sint32 i = 0; i < BENCH_LAYERS; i++) {
+    docs[i] = XYZ_SCFParseDocument(data, len, 0);
+    if (docs[i] == NULL) {
+      return 1;
+    }
+  }
+
+  const char* keys[BENCH_KEYS] = {0};
+  Sint32 key_count = 0;
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(docs[0]->root);
+  while (key_count < BENCH_KEYS && XYZ_SCFCursorNext(&cursor)) {
+    keys[key_count++] = cursor.pair->key;
+  }
+
+  const Sint32 counts[] = {1, BENCH_LAYERS};
+  for (size_t c = 0; c < SDL_arraysize(counts); c++) {
+    double merge = 0.0;
+    double push = 0.0;
+    double first = 0.0;
+    double cached = 0.0;
+    for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+      XYZ_SCFLayers layers = {0};
+      XYZ_SCFArena arena = {0};
+      XYZ_SCFArenaInit(&arena, len);
+
+      // what merging by copying every layer into one table costs
+      Uint64 start = SDL_GetPerformanceCounter();
+      XYZ_SCFLayersInit(&layers);
+      for (Sint32 i = 0; i < counts[c]; i++) {
+        XYZ_SCFLayersPush(&layers, docs[i]->root);
+      }
+      if (XYZ_SCFLayersFlatten(&layers, &arena) == NULL) {
+        return 1;
+      }
+      double elapsed[4] = {bench_elapsed(start)};
+      XYZ_SCFLayersDestroy(&layers);
+      XYZ_SCFArenaDestroy(&arena);
+
+      start = SDL_GetPerformanceCounter();
+      XYZ_SCFLayersInit(&layers);
+      for (Sint32 i = 0; i < counts[c]; i++) {
+        XYZ_SCFLayersPush(&layers, docs[i]->root);
+      }
+      elapsed[1] = bench_elapsed(start);
+
+      XYZ_SCFValue value = {0};
+      start = SDL_GetPerformanceCounter();
+      for (Sint32 i = 0; i < key_count; i++) {
+        XYZ_SCFLayersGet(&layers, keys[i], &value);
+      }
+      elapsed[2] = bench_elapsed(start);
+
+      start = SDL_GetPerformanceCounter();
+      for (Sint32 i = 0; i < BENCH_READS; i++) {
+        XYZ_SCFLayersGet(&layers, keys[i % key_count], &value);
+      }
+      elapsed[3] = bench_elapsed(start);
+      XYZ_SCFLayersDestroy(&layers);
+
+      merge = round == 0 ? elapsed[0] : SDL_min(merge, elapsed[0]);
+      push = round == 0 ? elapsed[1] : SDL_min(push, elapsed[1]);
+      first = round == 0 ? elapsed[2] : SDL_min(first, elapsed[2]);
+      cached = round == 0 ? elapsed[3] : SDL_min(cached, elapsed[3]);
+    }
+
+    SDL_Log("%d layers: merge %8.1f us, push %6.2f us, "
+            "first read %6.1f ns, cached read %5.1f ns",
+            counts[c], merge * 1e6, push * 1e6, first * 1e9 / key_count,
+            cached * 1e9 / BENCH_READS);
+  }
+
+  for (Sint32 i = 0; i < BENCH_LAYERS; i++) {
+    XYZ_SCFDocumentDestroy(docs[i]);
+  }
+  SDL_free(data);
+  return 0;
+}
@@ -0,0 +1,218 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/layer.h>
+#include <scf/parser.h>
+
+#include "test.h"
+
+static void layers_get(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* defaults = test_parse(
+      "name = \"hero\" video { width = 1280 height = 720 vsync = true }");
+  XYZ_SCFTable* platform = test_parse("video { width = 1920 height = 1080 }");
+  XYZ_SCFTable* user = test_parse("video { height = 1200 } volume = 0.5");
+
+  XYZ_SCFLayers layers = {0};
+  XYZ_SCFLayersInit(&layers);
+  assert_true(XYZ_SCFLayersPush(&layers, defaults));
+  assert_true(XYZ_SCFLayersPush(&layers, platform));
+  assert_true(XYZ_SCFLayersPush(&layers, user));
+
+  // blocks merge key by key, the topmost layer having a key wins
+  Sint32 width = 0;
+  Sint32 height = 0;
+  bool vsync = false;
+  float volume = 0.0f;
+  const char* name = NULL;
+  size_t name_len = 0;
+  assert_true(XYZ_SCFLayersGetI32(&layers, "video.width", &width));
+  assert_int_equal(width, 1920);
+  assert_true(XYZ_SCFLayersGetI32(&layers, "video.height", &height));
+  assert_int_equal(height, 1200);
+  assert_true(XYZ_SCFLayersGetBool(&layers, "video.vsync", &vsync));
+  assert_true(vsync);
+  assert_true(XYZ_SCFLayersGetF32(&layers, "volume", &volume));
+  assert_float_equal(volume, 0.5f, 0.0f);
+  assert_true(XYZ_SCFLayersGetStringView(&layers, "name", &name, &name_len));
+  assert_memory_equal(name, "hero", 4);
+
+  XYZ_SCFKey key = {0};
+  Uint32 layer = 0;
+  assert_true(XYZ_SCFLayersResolve(&layers, "video.width", &key, &layer));
+  assert_int_equal(layer, 1);
+  assert_true(XYZ_SCFLayersResolve(&layers, "name", &key, &layer));
+  assert_int_equal(layer, 0);
+
+  // misses are cached too and still fail
+  assert_false(XYZ_SCFLayersGetI32(&layers, "video.depth", &width));
+  assert_false(XYZ_SCFLayersGetI32(&layers, "video.depth", &width));
+  assert_false(XYZ_SCFLayersGetI32(&layers, "name", &width));
+  assert_false(XYZ_SCFLayersGetI32(&layers, "video..width", &width));
+
+  XYZ_SCFLayersDestroy(&layers);
+  test_destroy(user);
+  test_destroy(platform);
+  test_destroy(defaults);
+}
+
+static void layers_shadow(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* defaults = test_parse("video { width = 1280 } audio = 1");
+  XYZ_SCFTable* user = test_parse("video = false audio { channels = 2 }");
+
+  XYZ_SCFLayers layers = {0};
+  XYZ_SCFLayersInit(&layers);
+  assert_true(XYZ_SCFLayersPush(&layers, defaults));
+
+  // the cached winner is dropped when a layer is pushed above it
+  Sint32 width = 0;
+  assert_true(XYZ_SCFLayersGetI32(&layers, "video.width", &width));
+  assert_true(XYZ_SCFLayersPush(&layers, user));
+
+  // a value replaces a whole block below it, and a block a value
+  bool video = true;
+  Sint32 channels = 0;
+  assert_false(XYZ_SCFLayersGetI32(&layers, "video.width", &width));
+  assert_true(XYZ_SCFLayersGetBool(&layers, "video", &video));
+  assert_false(video);
+  assert_true(XYZ_SCFLayersGetI32(&layers, "audio.channels", &channels));
+  assert_int_equal(channels, 2);
+
+  XYZ_SCFLayersDestroy(&layers);
+  test_destroy(user);
+  test_destroy(defaults);
+}
+
+static void layers_set(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* defaults = test_parse("video { width = 1280 height = 720 }");
+  XYZ_SCFTable* copy = test_parse("video { width = 1280 height = 720 }");
+
+  XYZ_SCFLayers layers = {0};
+  XYZ_SCFLayersInit(&layers);
+  assert_true(XYZ_SCFLayersPush(&layers, defaults));
+
+  Sint32 width = 0;
+  Sint32 height = 0;
+  XYZ_SCFKey key = {0};
+  Uint32 layer = 0;
+  assert_true(XYZ_SCFLayersGetI32(&layers, "video.width", &width));
+  assert_int_equal(width, 1280);
+
+  // edits land above every layer, which stays untouched
+  XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = 1920};
+  assert_true(XYZ_SCFLayersSet(&layers, "video.width", value));
+  assert_true(XYZ_SCFLayersGetI32(&layers, "video.width", &width));
+  assert_int_equal(width, 1920);
+  assert_true(XYZ_SCFLayersResolve(&layers, "video.width", &key, &layer));
+  assert_int_equal(layer, 1);
+  assert_true(XYZ_SCFLayersGetI32(&layers, "video.height", &height));
+  assert_int_equal(height, 720);
+  assert_true(XYZ_SCFTableEqual(defaults, copy));
+
+  // editing an edit again is seen through handles already resolved
+  value.as_i32 = 2560;
+  assert_true(XYZ_SCFLayersSet(&layers, "video.width", value));
+  assert_int_equal(XYZ_SCFKeyValue(key)->as_i32, 2560);
+
+  value = (XYZ_SCFValue){.type = XYZ_SCF_VALUE_TYPE_STRING};
+  value.as_string = SDL_strdup("metal");
+  assert_true(XYZ_SCFLayersSet(&layers, "video.renderer", value));
+  value.as_string = SDL_strdup("vulkan");
+  assert_true(XYZ_SCFLayersSet(&layers, "video.renderer", value));
+
+  const char* renderer = NULL;
+  size_t renderer_len = 0;
+  assert_true(XYZ_SCFLayersGetStringView(&layers, "video.renderer", &renderer,
+                                         &renderer_len));
+  assert_int_equal(renderer_len, 6);
+  assert_memory_equal(renderer, "vulkan", 6);
+
+  // replacing a block drops everything cached below it
+  value = (XYZ_SCFValue){.type = XYZ_SCF_VALUE_TYPE_BOOL, .as_bool = false};
+  assert_true(XYZ_SCFLayersSet(&layers, "video", value));
+  assert_false(XYZ_SCFLayersGetI32(&layers, "video.height", &height));
+  assert_false(XYZ_SCFLayersSet(&layers, "video.height", value));
+  assert_false(XYZ_SCFLayersSet(&layers, "video.", value));
+
+  XYZ_SCFLayersDestroy(&layers);
+  test_destroy(copy);
+  test_destroy(defaults);
+}
+
+static void layers_flatten(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* defaults = test_parse(
+      "name = \"hero\" video { width = 1280 height = 720 } audio = 1 "
+      "keys { up = \"w\" }");
+  XYZ_SCFTable* user = test_parse(
+      "video { height = 1080 mode { fullscreen = true } } "
+      "audio { channels = 2 } keys = false");
+
+  XYZ_SCFLayers layers = {0};
+  XYZ_SCFLayersInit(&layers);
+  XYZ_SCFTable* empty = XYZ_SCFLayersFlatten(&layers, NULL);
+  assert_non_null(empty);
+  assert_int_equal(XYZ_SCFTableCount(empty), 0);
+  test_destroy(empty);
+
+  assert_true(XYZ_SCFLayersPush(&layers, defaults));
+  assert_true(XYZ_SCFLayersPush(&layers, user));
+  XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_STRING};
+  value.as_string = SDL_strdup("villain");
+  assert_true(XYZ_SCFLayersSet(&layers, "name", value));
+
+  XYZ_SCFTable* expected = test_parse(
+      "name = \"villain\" video { width = 1280 height = 1080 "
+      "mode { fullscreen = true } } audio { channels = 2 } keys = false");
+
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  XYZ_SCFTable* flat = XYZ_SCFLayersFlatten(&layers, &arena);
+  XYZ_SCFTable* heap = XYZ_SCFLayersFlatten(&layers, NULL);
+  assert_non_null(flat);
+  assert_non_null(heap);
+
+  // the result shares nothing with the layers
+  XYZ_SCFLayersDestroy(&layers);
+  test_destroy(user);
+  test_destroy(defaults);
+  assert_true(XYZ_SCFTableEqual(flat, expected));
+  assert_true(XYZ_SCFTableEqual(heap, expected));
+
+  test_destroy(heap);
+  XYZ_SCFArenaDestroy(&arena);
+  test_destroy(expected);
+
+  // a lazy block that does not parse is not merged as an empty one
+  const char* src = "a = 1\nb {\n x = = 2\n}\n";
+  XYZ_SCFParser setup = {.flags = XYZ_SCF_PARSE_LAZY};
+  XYZ_SCFTable* lazy = test_parse_with(&setup, src, SDL_strlen(src));
+  assert_non_null(lazy);
+  XYZ_SCFLayersInit(&layers);
+  assert_true(XYZ_SCFLayersPush(&layers, lazy));
+  assert_null(XYZ_SCFLayersFlatten(&layers, NULL));
+  XYZ_SCFLayersDestroy(&layers);
+  test_destroy(lazy);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(layers_get),
+      cmocka_unit_test(layers_shadow),
+      cmocka_unit_test(layers_set),
+      cmocka_unit_test(layers_flatten),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
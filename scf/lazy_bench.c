@@ -0,0 +1,133 @@
+#include <scf/scf.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_SIZE (8 * 1024 * 1024)
+#define BENCH_ROUNDS 5
+
+typedef enum {
+  run_copy,   // memcpy of the data, the floor
+  run_first,  // parse and look up one nested key
+  run_all,    // parse and walk every block
+} run_kind;
+
+// parse data with flags and read what kind asks for, into out
+bool config_read(const char* data,
+                 size_t len,
+                 Uint32 flags,
+                 run_kind kind,
+                 char* out);
+// sum of the spawn x and pair counts of every level, walking every block
+Sint64 walk(XYZ_SCFTable* root);
+// best of BENCH_ROUNDS runs of config_read
+double best(const char* data, size_t len, Uint32 flags, run_kind kind);
+
+bool config_read(const char* data,
+                 size_t len,
+                 Uint32 flags,
+                 run_kind kind,
+                 char* out) {
+  if (kind == run_copy) {
+    SDL_memcpy(out, data, len);
+    return true;
+  }
+
+  XYZ_SCFDocument* doc = XYZ_SCFParseDocument(data, len, flags);
+  if (doc == NULL) {
+    return false;
+  }
+
+  Sint32 x = 0;
+  XYZ_SCFTable* level = NULL;
+  XYZ_SCFTable* spawn = NULL;
+  bool found = true;
+  if (kind == run_first) {
+    found = XYZ_SCFTableGetTable(doc->root, "level_100", &level) &&
+            XYZ_SCFTableGetTable(level, "spawn", &spawn) &&
+            XYZ_SCFTableGetI32(spawn, "x", &x);
+  } else {
+    x = (Sint32)walk(doc->root);
+  }
+  SDL_memcpy(out, &x, sizeof(x));
+
+  XYZ_SCFDocumentDestroy(doc);
+  return found;
+}
+
+Sint64 walk(XYZ_SCFTable* root) {
+  Sint64 total = 0;
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(root);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    XYZ_SCFTable* level = cursor.pair->value.as_table;
+    XYZ_SCFCursor inner = XYZ_SCFTableCursor(level);
+    while (XYZ_SCFCursorNext(&inner)) {
+      if (inner.pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+        total += XYZ_SCFTableCount(inner.pair->value.as_table);
+      }
+    }
+
+    XYZ_SCFTable* spawn = NULL;
+    Sint32 x = 0;
+    if (XYZ_SCFTableGetTable(level, "spawn", &spawn) &&
+        XYZ_SCFTableGetI32(spawn, "x", &x)) {
+      total += x;
+    }
+  }
+  return total;
+}
+
+double best(const char* data, size_t len, Uint32 flags, run_kind kind) {
+  char* out = SDL_malloc(len);
+  if (out == NULL) {
+    return 0.0;
+  }
+
+  double best = 0.0;
+  for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    bool done = config_read(data, len, flags, kind, out);
+    double elapsed = bench_elapsed(start);
+    if (!done) {
+      SDL_Log("read failed: %s", SDL_GetError());
+      break;
+    }
+    best = round == 0 ? elapsed : SDL_min(best, elapsed);
+  }
+
+  SDL_free(out);
+  return best;
+}
+
+int main(void) {
+  size_t len = 0;
+  char* data = bench_generate_config(BENCH_SIZE, &len);
+  if (data == NULL) {
+    return 1;
+  }
+
+  const struct {
+    const char* name;
+    Uint32 flags;
+    run_kind kind;
+  } runs[] = {
+      {"memcpy", 0, run_copy},
+      {"first eager", 0, run_first},
+      {"first lazy", XYZ_SCF_PARSE_LAZY, run_first},
+      {"all eager", 0, run_all},
+      {"all lazy", XYZ_SCF_PARSE_LAZY, run_all},
+  };
+  for (size_t i = 0; i < SDL_arraysize(runs); i++) {
+    double elapsed = best(data, len, runs[i].flags, runs[i].kind);
+    SDL_Log("%-12s %8.2f ms %8.1f MB/s", runs[i].name, elapsed * 1e3,
+            len / 1048576.0 / elapsed);
+  }
+
+  SDL_free(data);
+  XYZ_SCFAtomsQuit();
+  return 0;
+}
@@ -1,7 +1,10 @@
 #include "scf/lexer.h"
 
 #include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_cpuinfo.h>
 #include <SDL3/SDL_error.h>
+#include <SDL3/SDL_intrin.h>
 #include <SDL3/SDL_stdinc.h>
 
 typedef enum {
@@ -10,6 +13,10 @@ typedef enum {
   l_state_float,
   l_state_string,
   l_state_word,
+  l_state_exp_mark,  // right after the 'e' of an exponent
+  l_state_exp_sign,  // right after its sign
+  l_state_exp,
+  l_state_count,
 } l_state;
 
 typedef struct {
@@ -20,8 +27,211 @@ typedef struct {
   XYZ_SCFTokenType emit_type;
 } l_action;
 
+// byte classes used by the table driven scanner
+typedef enum {
+  c_nul,  // end of input
+  c_oth,  // anything without a meaning outside of strings
+  c_spc,  // space or tab
+  c_nln,  // new line, also ends (with an error) a string
+  c_dig,
+  c_min,
+  c_dot,
+  c_quo,
+  c_pun,  // single byte punctuation: { } [ ] =
+  c_let,  // letters and underscore
+  c_utf,  // non-ASCII, only valid inside strings
+  c_exp,  // e and E, letters that also start an exponent
+  c_pls,  // plus, only valid as the sign of an exponent
+  c_count,
+} l_class;
+
+// a transition packs the next state in the low bits plus these flags
+#define L_STATE_MASK 0x07
+#define L_ACCEPT 0x08
+#define L_EMIT 0x10
+#define L_ERROR 0x20
+#define L_UNKNOWN 0x40
+
+// scanning kernels, both return buf_end when nothing is found
+typedef struct {
+  XYZ_SCFLexerKernel kind;
+  // first byte that is not a space, tab or new line, counting the new lines
+  // skipped into line and moving line_start past the last one
+  const char* (*skip_blanks)(const char* cur,
+                             const char* buf_end,
+                             Uint32* line,
+                             const char** line_start);
+  // first quote, new line or NUL byte
+  const char* (*string_end)(const char* cur, const char* buf_end);
+  // first brace, quote or NUL byte, counting new lines like skip_blanks
+  const char* (*block_byte)(const char* cur,
+                            const char* buf_end,
+                            Uint32* line,
+                            const char** line_start);
+} l_kernels;
+
 // check whats the next action to take after the given UCP
 l_action ucp_action(l_state cur_state, Sint32 ucp);
+// scan the next token, with partial set a token cut by the end of the
+// buffer is returned as such instead of being ended there
+bool l_next(XYZ_SCFToken* token, bool* partial);
+// report an unknown character
+void l_unknown(const char* cur, const char* buf_end);
+// leave token as an error at at, returns false
+bool l_fail(XYZ_SCFToken* token, const char* at);
+// bytes taken by the UTF-8 sequence starting with lead
+size_t l_utf8_len(Uint8 lead);
+// kernels in use, detected on first use
+const l_kernels* l_get_kernels(void);
+Uint32 l_ctz32(Uint32 mask);
+Uint32 l_popcount32(Uint32 mask);
+// add the new lines set in mask, bit i being base[i]
+void l_count_lines(Uint32 mask,
+                   const char* base,
+                   Uint32* line,
+                   const char** line_start);
+const char* l_skip_blanks_scalar(const char* cur,
+                                 const char* buf_end,
+                                 Uint32* line,
+                                 const char** line_start);
+const char* l_string_end_scalar(const char* cur, const char* buf_end);
+const char* l_block_byte_scalar(const char* cur,
+                                const char* buf_end,
+                                Uint32* line,
+                                const char** line_start);
+#ifdef SDL_SSE2_INTRINSICS
+const char* l_skip_blanks_sse2(const char* cur,
+                               const char* buf_end,
+                               Uint32* line,
+                               const char** line_start);
+const char* l_string_end_sse2(const char* cur, const char* buf_end);
+const char* l_block_byte_sse2(const char* cur,
+                              const char* buf_end,
+                              Uint32* line,
+                              const char** line_start);
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+const char* l_skip_blanks_avx2(const char* cur,
+                               const char* buf_end,
+                               Uint32* line,
+                               const char** line_start);
+const char* l_string_end_avx2(const char* cur, const char* buf_end);
+const char* l_block_byte_avx2(const char* cur,
+                              const char* buf_end,
+                              Uint32* line,
+                              const char** line_start);
+#endif
+
+static const Uint8 l_classes[256] = {
+    c_nul, c_oth, c_oth, c_oth, c_oth, c_oth, c_oth, c_oth,  // 0x00
+    c_oth, c_spc, c_nln, c_oth, c_oth, c_oth, c_oth, c_oth,  // 0x08
+    c_oth, c_oth, c_oth, c_oth, c_oth, c_oth, c_oth, c_oth,  // 0x10
+    c_oth, c_oth, c_oth, c_oth, c_oth, c_oth, c_oth, c_oth,  // 0x18
+    c_spc, c_oth, c_quo, c_oth, c_oth, c_oth, c_oth, c_oth,  // 0x20
+    c_oth, c_oth, c_oth, c_pls, c_oth, c_min, c_dot, c_oth,  // 0x28
+    c_dig, c_dig, c_dig, c_dig, c_dig, c_dig, c_dig, c_dig,  // 0x30
+    c_dig, c_dig, c_oth, c_oth, c_oth, c_pun, c_oth, c_oth,  // 0x38
+    c_oth, c_let, c_let, c_let, c_let, c_exp, c_let, c_let,  // 0x40
+    c_let, c_let, c_let, c_let, c_let, c_let, c_let, c_let,  // 0x48
+    c_let, c_let, c_let, c_let, c_let, c_let, c_let, c_let,  // 0x50
+    c_let, c_let, c_let, c_pun, c_oth, c_pun, c_oth, c_let,  // 0x58
+    c_oth, c_let, c_let, c_let, c_let, c_exp, c_let, c_let,  // 0x60
+    c_let, c_let, c_let, c_let, c_let, c_let, c_let, c_let,  // 0x68
+    c_let, c_let, c_let, c_let, c_let, c_let, c_let, c_let,  // 0x70
+    c_let, c_let, c_let, c_pun, c_oth, c_pun, c_oth, c_oth,  // 0x78
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0x80
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0x88
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0x90
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0x98
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xa0
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xa8
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xb0
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xb8
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xc0
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xc8
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xd0
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xd8
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xe0
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xe8
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xf0
+    c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf, c_utf,  // 0xf8
+};
+
+#define EM L_EMIT
+#define ER L_ERROR
+#define UN (L_UNKNOWN | L_ERROR)
+#define PU (L_ACCEPT | L_EMIT)
+#define TI (L_ACCEPT | l_state_int)
+#define TF (L_ACCEPT | l_state_float)
+#define TS (L_ACCEPT | l_state_string)
+#define TW (L_ACCEPT | l_state_word)
+#define TE (L_ACCEPT | l_state_exp_mark)
+#define TG (L_ACCEPT | l_state_exp_sign)
+#define TX (L_ACCEPT | l_state_exp)
+
+// precomputed ucp_action for every state and byte class
+// clang-format off
+static const Uint8 l_transitions[l_state_count][c_count] = {
+  //                    nul oth spc nln dig min dot quo pun let utf exp pls
+  [l_state_any]      = {ER, UN, UN, UN, TI, TI, UN, TS, PU, TW, UN, TW, UN},
+  [l_state_int]      = {EM, EM, EM, EM, TI, EM, TF, EM, EM, EM, EM, TE, EM},
+  [l_state_float]    = {EM, EM, EM, EM, TF, EM, EM, EM, EM, EM, EM, TE, EM},
+  [l_state_string]   = {ER, TS, TS, ER, TS, TS, TS, PU, TS, TS, TS, TS, TS},
+  [l_state_word]     = {EM, EM, EM, EM, TW, EM, EM, EM, EM, TW, EM, TW, EM},
+  [l_state_exp_mark] = {EM, EM, EM, EM, TX, TG, EM, EM, EM, EM, EM, EM, TG},
+  [l_state_exp_sign] = {EM, EM, EM, EM, TX, EM, EM, EM, EM, EM, EM, EM, EM},
+  [l_state_exp]      = {EM, EM, EM, EM, TX, EM, EM, EM, EM, EM, EM, EM, EM},
+};
+// clang-format on
+
+#undef EM
+#undef ER
+#undef UN
+#undef PU
+#undef TI
+#undef TF
+#undef TS
+#undef TW
+#undef TE
+#undef TG
+#undef TX
+
+static const l_kernels l_kernels_scalar = {
+    XYZ_SCF_LEXER_KERNEL_SCALAR,
+    l_skip_blanks_scalar,
+    l_string_end_scalar,
+    l_block_byte_scalar,
+};
+#ifdef SDL_SSE2_INTRINSICS
+static const l_kernels l_kernels_sse2 = {
+    XYZ_SCF_LEXER_KERNEL_SSE2,
+    l_skip_blanks_sse2,
+    l_string_end_sse2,
+    l_block_byte_sse2,
+};
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+static const l_kernels l_kernels_avx2 = {
+    XYZ_SCF_LEXER_KERNEL_AVX2,
+    l_skip_blanks_avx2,
+    l_string_end_avx2,
+    l_block_byte_avx2,
+};
+#endif
+
+static void* l_active_kernels = NULL;
+
+// token type emitted when leaving each state
+static const XYZ_SCFTokenType l_emit_types[l_state_count] = {
+    [l_state_any] = XYZ_SCF_TOKEN_TYPE_PUNCT,
+    [l_state_int] = XYZ_SCF_TOKEN_TYPE_INTEGER,
+    [l_state_float] = XYZ_SCF_TOKEN_TYPE_FLOAT,
+    [l_state_string] = XYZ_SCF_TOKEN_TYPE_STRING,
+    [l_state_word] = XYZ_SCF_TOKEN_TYPE_WORD,
+    [l_state_exp_mark] = XYZ_SCF_TOKEN_TYPE_FLOAT,
+    [l_state_exp_sign] = XYZ_SCF_TOKEN_TYPE_FLOAT,
+    [l_state_exp] = XYZ_SCF_TOKEN_TYPE_FLOAT,
+};
 
 void XYZ_SCFStartToken(XYZ_SCFToken* token, const char* src, size_t len) {
   SDL_assert(token != NULL && "XYZ_SCFStartToken: token cannot be NULL");
@@ -33,13 +243,477 @@ void XYZ_SCFStartToken(XYZ_SCFToken* token, const char* src, size_t len) {
       .buf_len = len,
       .val_start = src,
       .val_len = 0,
+      .line = 1,
+      .col = 1,
+      .line_start = src,
   };
 }
 
 bool XYZ_SCFNextToken(XYZ_SCFToken* token) {
   SDL_assert(token != NULL && "XYZ_SCFNextToken: token cannot be NULL");
+  return l_next(token, NULL);
+}
+
+bool XYZ_SCFSkipBlock(XYZ_SCFToken* token) {
+  SDL_assert(token != NULL && "XYZ_SCFSkipBlock: token cannot be NULL");
+  if (token->type != XYZ_SCF_TOKEN_TYPE_PUNCT || *token->val_start != '{') {
+    return false;
+  }
+
+  // strings end at a quote or a new line, like when lexing them
+  const l_kernels* kernels = l_get_kernels();
+  const char* buf_end = token->buf_start + token->buf_len;
+  const char* cur = token->val_start + 1;
+  Uint32 line = token->line;
+  const char* line_start = token->line_start;
+  for (Uint32 depth = 1;; cur++) {
+    cur = kernels->block_byte(cur, buf_end, &line, &line_start);
+    if (cur == buf_end || *cur == '\0') {
+      return false;
+    }
+
+    if (*cur == '"') {
+      cur = kernels->string_end(cur + 1, buf_end);
+      if (cur == buf_end || *cur == '\0') {
+        return false;
+      }
+      if (*cur == '\n') {
+        line++;
+        line_start = cur + 1;
+      }
+    } else if (*cur == '{') {
+      depth++;
+    } else if (--depth == 0) {
+      break;
+    }
+  }
+
+  token->val_start = cur;
+  token->val_len = 1;
+  token->line = line;
+  token->col = (Uint32)(cur - line_start) + 1;
+  token->line_start = line_start;
+  return true;
+}
+
+bool XYZ_SCFNextTokenPartial(XYZ_SCFToken* token, bool* partial) {
+  SDL_assert(token != NULL &&
+             "XYZ_SCFNextTokenPartial: token cannot be NULL");
+  SDL_assert(partial != NULL &&
+             "XYZ_SCFNextTokenPartial: partial cannot be NULL");
+  *partial = false;
+  return l_next(token, partial);
+}
+
+bool l_next(XYZ_SCFToken* token, bool* partial) {
+  const l_kernels* kernels = l_get_kernels();
+  const char* buf_end = token->buf_start + token->buf_len;
+  const char* cur = token->val_start + token->val_len;
+
+  // skip blanks, a NUL byte also ends the input
+  cur = kernels->skip_blanks(cur, buf_end, &token->line, &token->line_start);
+  token->col = (Uint32)(cur - token->line_start) + 1;
+  if (cur >= buf_end || *cur == '\0') {
+    token->val_start = cur;
+    token->val_len = 0;
+    token->type = XYZ_SCF_TOKEN_TYPE_EOF;
+    return true;
+  }
+
+  const char* token_start = cur;
+  const char* token_end = cur;
+  Uint8 state = l_state_any;
+  while (true) {
+    // more input may follow, the token is not over yet
+    if (partial != NULL &&
+        (cur >= buf_end || (l_classes[(Uint8)*cur] == c_utf &&
+                            l_utf8_len(*cur) > (size_t)(buf_end - cur)))) {
+      token->val_start = token_start;
+      token->val_len = buf_end - token_start;
+      *partial = true;
+      return true;
+    }
+
+    Uint8 cls = cur < buf_end ? l_classes[(Uint8)*cur] : c_nul;
+    Uint8 next = l_transitions[state][cls];
+    if (next & L_ERROR) {
+      if (next & L_UNKNOWN) {
+        l_unknown(cur, buf_end);
+        return l_fail(token, cur);
+      } else if (state == l_state_string) {
+        SDL_SetError("unterminated string");
+        return l_fail(token, token_start);
+      }
+      SDL_SetError("unexpected end of input");
+      return l_fail(token, cur);
+    }
+
+    if (next & L_ACCEPT) {
+      cur++;
+
+      // the body of a string literal can only end at a quote, a new line or
+      // NUL; jump there and let the table decide, UTF-8 sequences never
+      // contain those bytes so they need no decoding
+      if (next == (L_ACCEPT | l_state_string)) {
+        cur = kernels->string_end(cur, buf_end);
+      }
+      token_end = cur;
+    }
+
+    if (next & L_EMIT) {
+      token->val_start = token_start;
+      token->val_len = token_end - token_start;
+      token->type = l_emit_types[state];
+      return true;
+    }
+
+    state = next & L_STATE_MASK;
+  }
+}
+
+void l_unknown(const char* cur, const char* buf_end) {
+  const char* tmp = cur;
+  size_t left = buf_end - cur;
+  Uint32 ucp = SDL_StepUTF8(&tmp, &left);
+
+  char c[8] = {0};
+  SDL_UCS4ToUTF8(ucp, (char*)c);
+  SDL_SetError("unknown character: '%s'", c);
+}
+
+bool l_fail(XYZ_SCFToken* token, const char* at) {
+  token->val_start = at;
+  token->val_len = 0;
+  token->type = XYZ_SCF_TOKEN_TYPE_ERROR;
+  token->col = (Uint32)(at - token->line_start) + 1;
+  return false;
+}
+
+size_t l_utf8_len(Uint8 lead) {
+  if (lead >= 0xf0) {
+    return 4;
+  } else if (lead >= 0xe0) {
+    return 3;
+  } else if (lead >= 0xc0) {
+    return 2;
+  }
+  return 1;
+}
+
+bool XYZ_SCFSetLexerKernel(XYZ_SCFLexerKernel kernel) {
+  const l_kernels* kernels = NULL;
+  switch (kernel) {
+    case XYZ_SCF_LEXER_KERNEL_AUTO:
+      kernels = &l_kernels_scalar;
+#ifdef SDL_SSE2_INTRINSICS
+      if (SDL_HasSSE2()) {
+        kernels = &l_kernels_sse2;
+      }
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+      if (SDL_HasAVX2()) {
+        kernels = &l_kernels_avx2;
+      }
+#endif
+      break;
+    case XYZ_SCF_LEXER_KERNEL_SCALAR:
+      kernels = &l_kernels_scalar;
+      break;
+#ifdef SDL_SSE2_INTRINSICS
+    case XYZ_SCF_LEXER_KERNEL_SSE2:
+      if (SDL_HasSSE2()) {
+        kernels = &l_kernels_sse2;
+      }
+      break;
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    case XYZ_SCF_LEXER_KERNEL_AVX2:
+      if (SDL_HasAVX2()) {
+        kernels = &l_kernels_avx2;
+      }
+      break;
+#endif
+    default:
+      break;
+  }
+
+  if (kernels == NULL) {
+    SDL_SetError("lexer kernel not supported: %d", kernel);
+    return false;
+  }
+
+  SDL_SetAtomicPointer(&l_active_kernels, (void*)kernels);
+  return true;
+}
+
+XYZ_SCFLexerKernel XYZ_SCFGetLexerKernel(void) {
+  return l_get_kernels()->kind;
+}
+
+const l_kernels* l_get_kernels(void) {
+  const l_kernels* kernels = SDL_GetAtomicPointer(&l_active_kernels);
+  if (kernels == NULL) {
+    XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_AUTO);
+    kernels = SDL_GetAtomicPointer(&l_active_kernels);
+  }
+  return kernels;
+}
+
+Uint32 l_ctz32(Uint32 mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (Uint32)__builtin_ctz(mask);
+#else
+  Uint32 index = 0;
+  while ((mask & 1) == 0) {
+    mask >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+Uint32 l_popcount32(Uint32 mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (Uint32)__builtin_popcount(mask);
+#else
+  Uint32 count = 0;
+  for (; mask != 0; mask &= mask - 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+void l_count_lines(Uint32 mask,
+                   const char* base,
+                   Uint32* line,
+                   const char** line_start) {
+  if (mask == 0) {
+    return;
+  }
+
+  Uint32 last = 31;
+#if defined(__GNUC__) || defined(__clang__)
+  last -= (Uint32)__builtin_clz(mask);
+#else
+  while ((mask & (1u << last)) == 0) {
+    last--;
+  }
+#endif
+  *line += l_popcount32(mask);
+  *line_start = base + last + 1;
+}
+
+const char* l_skip_blanks_scalar(const char* cur,
+                                 const char* buf_end,
+                                 Uint32* line,
+                                 const char** line_start) {
+  Uint32 lines = *line;
+  const char* start = *line_start;
+  while (cur < buf_end && (*cur == ' ' || *cur == '\t' || *cur == '\n')) {
+    if (*cur == '\n') {
+      lines++;
+      start = cur + 1;
+    }
+    cur++;
+  }
+  *line = lines;
+  *line_start = start;
+  return cur;
+}
+
+const char* l_string_end_scalar(const char* cur, const char* buf_end) {
+  while (cur < buf_end && *cur != '"' && *cur != '\n' && *cur != '\0') {
+    cur++;
+  }
+  return cur;
+}
+
+const char* l_block_byte_scalar(const char* cur,
+                                const char* buf_end,
+                                Uint32* line,
+                                const char** line_start) {
+  Uint32 lines = *line;
+  const char* start = *line_start;
+  for (; cur < buf_end; cur++) {
+    if (*cur == '{' || *cur == '}' || *cur == '"' || *cur == '\0') {
+      break;
+    }
+    if (*cur == '\n') {
+      lines++;
+      start = cur + 1;
+    }
+  }
+  *line = lines;
+  *line_start = start;
+  return cur;
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+SDL_TARGETING("sse2")
+const char* l_skip_blanks_sse2(const char* cur,
+                               const char* buf_end,
+                               Uint32* line,
+                               const char** line_start) {
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i newline = _mm_set1_epi8('\n');
+  while (buf_end - cur >= 16) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)cur);
+    __m128i lines = _mm_cmpeq_epi8(chunk, newline);
+    __m128i blank = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+        lines);
+    Uint32 mask = ~(Uint32)_mm_movemask_epi8(blank) & 0xFFFF;
+    Uint32 line_mask = (Uint32)_mm_movemask_epi8(lines);
+    if (mask != 0) {
+      Uint32 end = l_ctz32(mask);
+      l_count_lines(line_mask & ((1u << end) - 1), cur, line, line_start);
+      return cur + end;
+    }
+    l_count_lines(line_mask, cur, line, line_start);
+    cur += 16;
+  }
+  return l_skip_blanks_scalar(cur, buf_end, line, line_start);
+}
+
+SDL_TARGETING("sse2")
+const char* l_string_end_sse2(const char* cur, const char* buf_end) {
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i zero = _mm_setzero_si128();
+  while (buf_end - cur >= 16) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)cur);
+    __m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                             _mm_cmpeq_epi8(chunk, newline)),
+                                _mm_cmpeq_epi8(chunk, zero));
+    Uint32 mask = (Uint32)_mm_movemask_epi8(stop);
+    if (mask != 0) {
+      return cur + l_ctz32(mask);
+    }
+    cur += 16;
+  }
+  return l_string_end_scalar(cur, buf_end);
+}
+
+SDL_TARGETING("sse2")
+const char* l_block_byte_sse2(const char* cur,
+                              const char* buf_end,
+                              Uint32* line,
+                              const char** line_start) {
+  const __m128i open = _mm_set1_epi8('{');
+  const __m128i close = _mm_set1_epi8('}');
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i newline = _mm_set1_epi8('\n');
+  while (buf_end - cur >= 16) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)cur);
+    __m128i braces =
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, open), _mm_cmpeq_epi8(chunk, close));
+    __m128i others =
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, zero));
+    __m128i stop = _mm_or_si128(braces, others);
+    Uint32 mask = (Uint32)_mm_movemask_epi8(stop);
+    Uint32 line_mask =
+        (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+    if (mask != 0) {
+      Uint32 end = l_ctz32(mask);
+      l_count_lines(line_mask & ((1u << end) - 1), cur, line, line_start);
+      return cur + end;
+    }
+    l_count_lines(line_mask, cur, line, line_start);
+    cur += 16;
+  }
+  return l_block_byte_scalar(cur, buf_end, line, line_start);
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+const char* l_skip_blanks_avx2(const char* cur,
+                               const char* buf_end,
+                               Uint32* line,
+                               const char** line_start) {
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i newline = _mm256_set1_epi8('\n');
+  while (buf_end - cur >= 32) {
+    __m256i chunk = _mm256_loadu_si256((const __m256i*)cur);
+    __m256i lines = _mm256_cmpeq_epi8(chunk, newline);
+    __m256i blank = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+                        _mm256_cmpeq_epi8(chunk, tab)),
+        lines);
+    Uint32 mask = ~(Uint32)_mm256_movemask_epi8(blank);
+    Uint32 line_mask = (Uint32)_mm256_movemask_epi8(lines);
+    if (mask != 0) {
+      Uint32 end = l_ctz32(mask);
+      l_count_lines(line_mask & ((1u << end) - 1), cur, line, line_start);
+      return cur + end;
+    }
+    l_count_lines(line_mask, cur, line, line_start);
+    cur += 32;
+  }
+  return l_skip_blanks_scalar(cur, buf_end, line, line_start);
+}
+
+SDL_TARGETING("avx2")
+const char* l_string_end_avx2(const char* cur, const char* buf_end) {
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i zero = _mm256_setzero_si256();
+  while (buf_end - cur >= 32) {
+    __m256i chunk = _mm256_loadu_si256((const __m256i*)cur);
+    __m256i stop = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                        _mm256_cmpeq_epi8(chunk, newline)),
+        _mm256_cmpeq_epi8(chunk, zero));
+    Uint32 mask = (Uint32)_mm256_movemask_epi8(stop);
+    if (mask != 0) {
+      return cur + l_ctz32(mask);
+    }
+    cur += 32;
+  }
+  return l_string_end_scalar(cur, buf_end);
+}
+
+SDL_TARGETING("avx2")
+const char* l_block_byte_avx2(const char* cur,
+                              const char* buf_end,
+                              Uint32* line,
+                              const char** line_start) {
+  const __m256i open = _mm256_set1_epi8('{');
+  const __m256i close = _mm256_set1_epi8('}');
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i newline = _mm256_set1_epi8('\n');
+  while (buf_end - cur >= 32) {
+    __m256i chunk = _mm256_loadu_si256((const __m256i*)cur);
+    __m256i stop = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, open),
+                        _mm256_cmpeq_epi8(chunk, close)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                        _mm256_cmpeq_epi8(chunk, zero)));
+    Uint32 mask = (Uint32)_mm256_movemask_epi8(stop);
+    Uint32 line_mask =
+        (Uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline));
+    if (mask != 0) {
+      Uint32 end = l_ctz32(mask);
+      l_count_lines(line_mask & ((1u << end) - 1), cur, line, line_start);
+      return cur + end;
+    }
+    l_count_lines(line_mask, cur, line, line_start);
+    cur += 32;
+  }
+  return l_block_byte_scalar(cur, buf_end, line, line_start);
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+bool XYZ_SCFNextTokenReference(XYZ_SCFToken* token) {
+  SDL_assert(token != NULL &&
+             "XYZ_SCFNextTokenReference: token cannot be NULL");
+
   l_state cur_state = l_state_any;
-  const char* buf_start = token->buf_start;
   const char* buf_end = token->buf_start + token->buf_len;
   const char* token_start = token->val_start + token->val_len;
   Uint32 ucp = 0;
@@ -48,33 +722,43 @@ bool XYZ_SCFNextToken(XYZ_SCFToken* token) {
     token->val_start = token_start;
     token->val_len = 0;
     token->type = XYZ_SCF_TOKEN_TYPE_EOF;
+    token->col = (Uint32)(token_start - token->line_start) + 1;
     return true;
   }
 
   while (token_start <= buf_end) {
+    // stepping back could land before a stray continuation byte, go back to
+    // where the character started instead
+    const char* at = token_start;
     ucp = SDL_StepUTF8(&token_start, NULL);
     if (ucp == 0) {
       token->val_start = token_start;
       token->val_len = 0;
       token->type = XYZ_SCF_TOKEN_TYPE_EOF;
+      token->col = (Uint32)(token_start - token->line_start) + 1;
       return true;
     }
 
-    if (ucp != ' ' && ucp != '\t' && ucp != '\n') {
-      SDL_StepBackUTF8(buf_start, &token_start);
+    if (ucp == '\n') {
+      token->line++;
+      token->line_start = token_start;
+    } else if (ucp != ' ' && ucp != '\t') {
+      token_start = at;
       break;
     }
   }
+  token->col = (Uint32)(token_start - token->line_start) + 1;
 
   const char* token_end = token_start;
   const char* token_tmp = token_start;
   while (token_tmp <= buf_end) {
+    const char* at = token_tmp;
     ucp = SDL_StepUTF8(&token_tmp, NULL);
     l_action action = ucp_action(cur_state, ucp);
-    cur_state = action.set_state;
     if (action.error) {
-      return false;
+      return l_fail(token, cur_state == l_state_string ? token_start : at);
     }
+    cur_state = action.set_state;
 
     if (action.accept) {
       token_end = token_tmp;
@@ -107,7 +791,8 @@ l_action ucp_action(l_state cur_state, Sint32 ucp) {
       } else if (ucp == '"') {
         action.set_state = l_state_string;
         action.accept = true;
-      } else if (ucp == '{' || ucp == '}' || ucp == '=') {
+      } else if (ucp == '{' || ucp == '}' || ucp == '[' || ucp == ']' ||
+                 ucp == '=') {
         action.set_state = l_state_any;
         action.accept = true;
         action.emit_type = XYZ_SCF_TOKEN_TYPE_PUNCT;
@@ -116,13 +801,14 @@ l_action ucp_action(l_state cur_state, Sint32 ucp) {
                  (ucp >= 'A' && ucp <= 'Z')) {
         action.set_state = l_state_word;
         action.accept = true;
+      } else if (ucp == 0) {
+        SDL_SetError("unexpected end of input");
+        action.error = true;
       } else {
-        action.set_state = l_state_any;
-        action.accept = true;
-
         char c[8] = {0};
         SDL_UCS4ToUTF8(ucp, (char*)c);
-        SDL_SetError("unknown character: '%s'\n", c);
+        SDL_SetError("unknown character: '%s'", c);
+        action.error = true;
       }
       break;
     case l_state_int:
@@ -132,6 +818,9 @@ l_action ucp_action(l_state cur_state, Sint32 ucp) {
       } else if (ucp == '.') {
         action.set_state = l_state_float;
         action.accept = true;
+      } else if (ucp == 'e' || ucp == 'E') {
+        action.set_state = l_state_exp_mark;
+        action.accept = true;
       } else {
         action.set_state = l_state_any;
         action.emit_type = XYZ_SCF_TOKEN_TYPE_INTEGER;
@@ -142,6 +831,9 @@ l_action ucp_action(l_state cur_state, Sint32 ucp) {
       if (ucp >= '0' && ucp <= '9') {
         action.set_state = l_state_float;
         action.accept = true;
+      } else if (ucp == 'e' || ucp == 'E') {
+        action.set_state = l_state_exp_mark;
+        action.accept = true;
       } else {
         action.set_state = l_state_any;
         action.emit_type = XYZ_SCF_TOKEN_TYPE_FLOAT;
@@ -173,6 +865,22 @@ l_action ucp_action(l_state cur_state, Sint32 ucp) {
         action.emit = true;
       }
       break;
+    case l_state_exp_mark:
+    case l_state_exp_sign:
+    case l_state_exp:
+      if (ucp >= '0' && ucp <= '9') {
+        action.set_state = l_state_exp;
+        action.accept = true;
+      } else if (cur_state == l_state_exp_mark &&
+                 (ucp == '-' || ucp == '+')) {
+        action.set_state = l_state_exp_sign;
+        action.accept = true;
+      } else {
+        action.set_state = l_state_any;
+        action.emit_type = XYZ_SCF_TOKEN_TYPE_FLOAT;
+        action.emit = true;
+      }
+      break;
     default:
       SDL_SetError("unknown state: %d", cur_state);
       action.error = true;
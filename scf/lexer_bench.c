@@ -0,0 +1,79 @@
+#include <scf/lexer.h>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_SIZE (8 * 1024 * 1024)
+#define BENCH_ROUNDS 5
+
+typedef bool (*lex_fn)(XYZ_SCFToken* token);
+
+// lex the whole input rounds times, returns the best time of one round
+double bench_lexer(lex_fn next, const char* data, size_t len, size_t* tokens);
+
+double bench_lexer(lex_fn next, const char* data, size_t len, size_t* tokens) {
+  double best = 0.0;
+  for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+    XYZ_SCFToken token = {0};
+    size_t count = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    XYZ_SCFStartToken(&token, data, len);
+    do {
+      if (!next(&token)) {
+        return -1.0;
+      }
+      count++;
+    } while (token.type != XYZ_SCF_TOKEN_TYPE_EOF);
+
+    double elapsed = bench_elapsed(start);
+    if (round == 0 || elapsed < best) {
+      best = elapsed;
+    }
+    *tokens = count;
+  }
+  return best;
+}
+
+int main(void) {
+  size_t len = 0;
+  char* data = bench_generate_config(BENCH_SIZE, &len);
+  if (data == NULL) {
+    return 1;
+  }
+
+  const struct {
+    const char* name;
+    lex_fn next;
+    XYZ_SCFLexerKernel kernel;
+  } lexers[] = {
+      {"reference", XYZ_SCFNextTokenReference, XYZ_SCF_LEXER_KERNEL_SCALAR},
+      {"scalar", XYZ_SCFNextToken, XYZ_SCF_LEXER_KERNEL_SCALAR},
+      {"sse2", XYZ_SCFNextToken, XYZ_SCF_LEXER_KERNEL_SSE2},
+      {"avx2", XYZ_SCFNextToken, XYZ_SCF_LEXER_KERNEL_AVX2},
+  };
+
+  double mb = (double)len / (1024.0 * 1024.0);
+  for (size_t i = 0; i < SDL_arraysize(lexers); i++) {
+    if (!XYZ_SCFSetLexerKernel(lexers[i].kernel)) {
+      SDL_Log("%-10s not supported", lexers[i].name);
+      continue;
+    }
+
+    size_t tokens = 0;
+    double elapsed = bench_lexer(lexers[i].next, data, len, &tokens);
+    if (elapsed < 0.0) {
+      SDL_Log("%s: lexer failed", lexers[i].name);
+      return 1;
+    }
+
+    SDL_Log("%-10s %8.2f Mtokens/s %8.1f MB/s (%zu tokens, %.1f MB)",
+            lexers[i].name, tokens / elapsed / 1e6, mb / elapsed, tokens, mb);
+  }
+
+  XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_AUTO);
+  SDL_free(data);
+  return 0;
+}
@@ -8,6 +8,8 @@
 
 #include <scf/lexer.h>
 
+#include <SDL3/SDL_error.h>
+
 static void lex_int(void** state) {
   (void)state;
 
@@ -70,6 +72,31 @@ static void lex_float(void** state) {
   assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_EOF);
 }
 
+static void lex_exponent(void** state) {
+  (void)state;
+
+  // a number ends where the exponent stops making sense, the parser rejects
+  // what is left of it
+  const char* src_data = "1e5 -2.5E-3 7.e+12 3e x";
+  const char* expected[] = {"1e5", "-2.5E-3", "7.e+12", "3e"};
+  size_t src_size = SDL_strlen(src_data);
+
+  XYZ_SCFToken token = {0};
+  XYZ_SCFStartToken(&token, src_data, src_size);
+  for (size_t i = 0; i < SDL_arraysize(expected); i++) {
+    size_t len = SDL_strlen(expected[i]);
+    assert_true(XYZ_SCFNextToken(&token));
+    assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_FLOAT);
+    assert_int_equal(token.val_len, len);
+    assert_memory_equal(token.val_start, expected[i], len);
+  }
+
+  assert_true(XYZ_SCFNextToken(&token));
+  assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_WORD);
+  assert_true(XYZ_SCFNextToken(&token));
+  assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_EOF);
+}
+
 static void lex_string(void** state) {
   (void)state;
 
@@ -99,7 +126,7 @@ static void lex_string(void** state) {
 static void lex_punct(void** state) {
   (void)state;
 
-  const char* src_data = "{} =";
+  const char* src_data = "{} =[]";
   size_t src_size = SDL_strlen(src_data);
 
   XYZ_SCFToken token = {0};
@@ -123,6 +150,14 @@ static void lex_punct(void** state) {
   assert_int_equal(token.val_len, 1);
   assert_memory_equal(token.val_start, "=", 1);
 
+  assert_true(XYZ_SCFNextToken(&token));
+  assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_PUNCT);
+  assert_memory_equal(token.val_start, "[", 1);
+
+  assert_true(XYZ_SCFNextToken(&token));
+  assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_PUNCT);
+  assert_memory_equal(token.val_start, "]", 1);
+
   assert_true(XYZ_SCFNextToken(&token));
   assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_EOF);
 }
@@ -163,11 +198,316 @@ static void lex_word(void** state) {
   assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_EOF);
 }
 
+static void lex_reference(void** state) {
+  (void)state;
+
+  const char* src_data =
+      "video {\n\twidth = 1280 scale = -1.5\n}\n"
+      "title = \"caf\xc3\xa9 \xe2\x98\x95\" id_2 = 7\n\n  x = 1.25e3";
+  size_t src_size = SDL_strlen(src_data);
+
+  XYZ_SCFToken fast = {0};
+  XYZ_SCFToken reference = {0};
+  XYZ_SCFStartToken(&fast, src_data, src_size);
+  XYZ_SCFStartToken(&reference, src_data, src_size);
+
+  Sint32 count = 0;
+  do {
+    assert_true(XYZ_SCFNextToken(&fast));
+    assert_true(XYZ_SCFNextTokenReference(&reference));
+    assert_int_equal(fast.type, reference.type);
+    assert_ptr_equal(fast.val_start, reference.val_start);
+    assert_int_equal(fast.val_len, reference.val_len);
+    assert_int_equal(fast.line, reference.line);
+    assert_int_equal(fast.col, reference.col);
+    count++;
+  } while (fast.type != XYZ_SCF_TOKEN_TYPE_EOF);
+  assert_int_equal(count, 19);
+}
+
+static void lex_unterminated_string(void** state) {
+  (void)state;
+
+  const char* src_data = "\"hello\nworld\"";
+  size_t src_size = SDL_strlen(src_data);
+
+  XYZ_SCFToken token = {0};
+  XYZ_SCFStartToken(&token, src_data, src_size);
+  assert_false(XYZ_SCFNextToken(&token));
+
+  XYZ_SCFStartToken(&token, src_data, 4);
+  assert_false(XYZ_SCFNextToken(&token));
+  assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_ERROR);
+  assert_ptr_equal(token.val_start, src_data);
+}
+
+static void lex_unknown(void** state) {
+  (void)state;
+
+  // the lexer stops at the character instead of skipping it
+  const char* src_data = "a = 1\n  b ? 2";
+  size_t src_size = SDL_strlen(src_data);
+
+  XYZ_SCFToken token = {0};
+  XYZ_SCFStartToken(&token, src_data, src_size);
+  for (Sint32 i = 0; i < 4; i++) {
+    assert_true(XYZ_SCFNextToken(&token));
+  }
+  assert_false(XYZ_SCFNextToken(&token));
+  assert_string_equal(SDL_GetError(), "unknown character: '?'");
+  assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_ERROR);
+  assert_ptr_equal(token.val_start, src_data + 10);
+  assert_int_equal(token.line, 2);
+  assert_int_equal(token.col, 5);
+
+  XYZ_SCFStartToken(&token, src_data, src_size);
+  for (Sint32 i = 0; i < 4; i++) {
+    assert_true(XYZ_SCFNextTokenReference(&token));
+  }
+  assert_false(XYZ_SCFNextTokenReference(&token));
+  assert_ptr_equal(token.val_start, src_data + 10);
+
+  // stray UTF-8 bytes outside strings are neither digits nor letters
+  const char* stray[] = {"a\xb2", "\xb3", "1\xb9", "\x80"};
+  for (size_t i = 0; i < SDL_arraysize(stray); i++) {
+    XYZ_SCFStartToken(&token, stray[i], SDL_strlen(stray[i]));
+    while (XYZ_SCFNextToken(&token) && token.type != XYZ_SCF_TOKEN_TYPE_EOF) {
+    }
+    assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_ERROR);
+    assert_ptr_equal(token.val_start, stray[i] + SDL_strlen(stray[i]) - 1);
+  }
+}
+
+static void lex_position(void** state) {
+  (void)state;
+
+  // runs of blanks longer than a vector, new lines on both sides of its end
+  const char* src_data =
+      "a\n\n\t b = 1\n"
+      "                                         \n"
+      "                                      \n   c";
+  size_t src_size = SDL_strlen(src_data);
+  const Uint32 lines[] = {1, 3, 3, 3, 6, 6};
+  const Uint32 cols[] = {1, 3, 5, 7, 4, 5};
+
+  const XYZ_SCFLexerKernel kernels[] = {
+      XYZ_SCF_LEXER_KERNEL_SCALAR,
+      XYZ_SCF_LEXER_KERNEL_SSE2,
+      XYZ_SCF_LEXER_KERNEL_AVX2,
+  };
+  for (size_t k = 0; k < SDL_arraysize(kernels); k++) {
+    if (!XYZ_SCFSetLexerKernel(kernels[k])) {
+      continue;
+    }
+
+    XYZ_SCFToken token = {0};
+    XYZ_SCFStartToken(&token, src_data, src_size);
+    assert_int_equal(token.line, 1);
+    assert_int_equal(token.col, 1);
+    for (size_t i = 0; i < SDL_arraysize(lines); i++) {
+      assert_true(XYZ_SCFNextToken(&token));
+      assert_int_equal(token.line, lines[i]);
+      assert_int_equal(token.col, cols[i]);
+    }
+    assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_EOF);
+  }
+  assert_true(XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_AUTO));
+}
+
+static void lex_skip_block(void** state) {
+  (void)state;
+
+  // braces in strings do not count, a string cut by a new line ends there,
+  // blocks longer than a vector with new lines on both sides of its end
+  const char* src_data =
+      "a {\n  b = \"}{\" c { d = \"x\n  e = 1 }\n"
+      "                                         \n"
+      "  f = \"a string longer than any vector is wide {\"\n} g = 1";
+  const char* close = SDL_strrchr(src_data, '}');
+  const char* bad[] = {"{ a { }", "{ a = \"}", "{ \"x\0\" }", "a { }"};
+  const size_t bad_len[] = {7, 8, 9, 5};
+
+  const XYZ_SCFLexerKernel kernels[] = {
+      XYZ_SCF_LEXER_KERNEL_SCALAR,
+      XYZ_SCF_LEXER_KERNEL_SSE2,
+      XYZ_SCF_LEXER_KERNEL_AVX2,
+  };
+  for (size_t k = 0; k < SDL_arraysize(kernels); k++) {
+    if (!XYZ_SCFSetLexerKernel(kernels[k])) {
+      continue;
+    }
+
+    XYZ_SCFToken token = {0};
+    XYZ_SCFStartToken(&token, src_data, SDL_strlen(src_data));
+    assert_true(XYZ_SCFNextToken(&token));
+    assert_true(XYZ_SCFNextToken(&token));
+    assert_true(XYZ_SCFSkipBlock(&token));
+    assert_ptr_equal(token.val_start, close);
+    assert_int_equal(token.val_len, 1);
+    assert_int_equal(token.line, 6);
+    assert_int_equal(token.col, 1);
+
+    // lexing goes on after the '}'
+    assert_true(XYZ_SCFNextToken(&token));
+    assert_int_equal(token.type, XYZ_SCF_TOKEN_TYPE_WORD);
+    assert_int_equal(token.line, 6);
+    assert_int_equal(token.col, 3);
+
+    // no closing brace or a NUL byte first, or not on a block at all
+    for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+      XYZ_SCFStartToken(&token, bad[i], bad_len[i]);
+      assert_true(XYZ_SCFNextToken(&token));
+      XYZ_SCFToken before = token;
+      assert_false(XYZ_SCFSkipBlock(&token));
+      assert_memory_equal(&token, &before, sizeof(XYZ_SCFToken));
+    }
+  }
+  assert_true(XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_AUTO));
+}
+
+#define FUZZ_ROUNDS 2000
+#define FUZZ_MAX_LEN 512
+
+// small deterministic generator so failures reproduce
+static Uint32 fuzz_next(Uint32* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed >> 8;
+}
+
+// random soup of fragments, long runs of blanks and long strings so every
+// kernel crosses its vector width, plus stray UTF-8 bytes and the odd random
+// byte
+static size_t fuzz_input(Uint32* seed, char* dst, size_t cap) {
+  static const char* fragments[] = {
+      "key", "_w9", "=",  "{",  "}", "12", "-",        "3.5",         ".",
+      "\"",  "nil", "\n", "\t", " ", "?",  "\xc3\xa9", "\xe2\x98\x95",
+      "e",   "E",   "+",  "\xb2", "\x80", "\xc3",
+  };
+
+  size_t len = 0;
+  while (len + 80 < cap) {
+    Uint32 pick = fuzz_next(seed) % 30;
+    if (pick < SDL_arraysize(fragments)) {
+      size_t frag_len = SDL_strlen(fragments[pick]);
+      SDL_memcpy(dst + len, fragments[pick], frag_len);
+      len += frag_len;
+    } else if (pick < 26) {
+      size_t run = fuzz_next(seed) % 70;
+      for (size_t i = 0; i < run; i++) {
+        dst[len++] = " \t\n"[fuzz_next(seed) % 3];
+      }
+    } else if (pick < 29) {
+      size_t run = fuzz_next(seed) % 70;
+      dst[len++] = '"';
+      for (size_t i = 0; i < run; i++) {
+        dst[len++] = 'a' + fuzz_next(seed) % 26;
+      }
+      dst[len++] = '"';
+    } else {
+      dst[len++] = (char)(Uint8)(fuzz_next(seed) % 256);
+    }
+
+    if (fuzz_next(seed) % 16 == 0) {
+      break;
+    }
+  }
+  dst[len] = '\0';
+  return len;
+}
+
+typedef struct {
+  bool ok;
+  XYZ_SCFToken token;
+} fuzz_token;
+
+// lex src with next, returns how many tokens were written to out
+static size_t fuzz_lex(bool (*next)(XYZ_SCFToken*),
+                       const char* src,
+                       size_t len,
+                       fuzz_token* out) {
+  XYZ_SCFToken token = {0};
+  XYZ_SCFStartToken(&token, src, len);
+  size_t count = 0;
+  while (true) {
+    out[count].ok = next(&token);
+    out[count].token = token;
+    count++;
+    if (!out[count - 1].ok || token.type == XYZ_SCF_TOKEN_TYPE_EOF) {
+      return count;
+    }
+  }
+}
+
+static void fuzz_compare(const fuzz_token* expected,
+                         size_t expected_count,
+                         const fuzz_token* got,
+                         size_t got_count) {
+  assert_int_equal(expected_count, got_count);
+  for (size_t i = 0; i < got_count; i++) {
+    assert_int_equal(expected[i].ok, got[i].ok);
+    if (!got[i].ok) {
+      continue;
+    }
+    assert_int_equal(expected[i].token.type, got[i].token.type);
+    assert_ptr_equal(expected[i].token.val_start, got[i].token.val_start);
+    assert_int_equal(expected[i].token.val_len, got[i].token.val_len);
+    assert_int_equal(expected[i].token.line, got[i].token.line);
+    assert_int_equal(expected[i].token.col, got[i].token.col);
+  }
+}
+
+static void lex_kernels_fuzz(void** state) {
+  (void)state;
+
+  const XYZ_SCFLexerKernel kernels[] = {
+      XYZ_SCF_LEXER_KERNEL_SSE2,
+      XYZ_SCF_LEXER_KERNEL_AVX2,
+  };
+
+  static char src_data[FUZZ_MAX_LEN];
+  static fuzz_token expected[FUZZ_MAX_LEN + 1];
+  static fuzz_token got[FUZZ_MAX_LEN + 1];
+  Uint32 seed = 1234;
+  for (Sint32 round = 0; round < FUZZ_ROUNDS; round++) {
+    size_t src_size = fuzz_input(&seed, src_data, sizeof(src_data));
+    if (src_size == 0) {
+      continue;
+    }
+
+    assert_true(XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_SCALAR));
+    size_t expected_count =
+        fuzz_lex(XYZ_SCFNextToken, src_data, src_size, expected);
+
+    // bytes of 0x80 and above outside strings included
+    size_t reference_count =
+        fuzz_lex(XYZ_SCFNextTokenReference, src_data, src_size, got);
+    fuzz_compare(expected, expected_count, got, reference_count);
+
+    for (size_t k = 0; k < SDL_arraysize(kernels); k++) {
+      if (!XYZ_SCFSetLexerKernel(kernels[k])) {
+        continue;
+      }
+
+      size_t got_count = fuzz_lex(XYZ_SCFNextToken, src_data, src_size, got);
+      fuzz_compare(expected, expected_count, got, got_count);
+    }
+  }
+
+  assert_true(XYZ_SCFSetLexerKernel(XYZ_SCF_LEXER_KERNEL_AUTO));
+  assert_int_not_equal(XYZ_SCFGetLexerKernel(), XYZ_SCF_LEXER_KERNEL_AUTO);
+}
+
 int main(void) {
   const struct CMUnitTest tests[] = {
       cmocka_unit_test(lex_int),    cmocka_unit_test(lex_float),
+      cmocka_unit_test(lex_exponent),
       cmocka_unit_test(lex_string), cmocka_unit_test(lex_punct),
-      cmocka_unit_test(lex_word),
+      cmocka_unit_test(lex_word),   cmocka_unit_test(lex_reference),
+      cmocka_unit_test(lex_unterminated_string),
+      cmocka_unit_test(lex_unknown),
+      cmocka_unit_test(lex_position),
+      cmocka_unit_test(lex_skip_block),
+      cmocka_unit_test(lex_kernels_fuzz),
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,360 @@
+#include "scf/number.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+// significant digits mantissa can hold exactly
+#define NUM_FAST_DIGITS 19
+// significant digits compared exactly on the slow path, any digit past them
+// only counts as a nonzero tail; no float halfway point needs more
+#define NUM_SLOW_DIGITS 120
+// 32 bit limbs of the integers compared on the slow path, enough for the
+// largest exponents that do not overflow or round to zero
+#define NUM_BIG_LIMBS 40
+// exponents are clamped here, anything past it is out of range anyway
+#define NUM_MAX_EXPONENT 100000
+
+#define NUM_F32_INFINITY 0x7f800000u
+#define NUM_F32_MAX 0x7f7fffffu
+
+typedef struct {
+  Uint64 mantissa;  // first NUM_FAST_DIGITS significant digits
+  Sint32 exponent;  // the value is all significant digits * 10^exponent
+  Sint32 digit_count;
+  const char* first;  // first significant digit
+  const char* end;    // end of the digits, before the exponent
+  bool negative;
+} num_decimal;
+
+// little endian arbitrary precision unsigned integer
+typedef struct {
+  Uint32 limbs[NUM_BIG_LIMBS];
+  Uint32 count;
+} num_big;
+
+// split a number into its digits and exponent, false if malformed
+bool num_decimal_read(const char* str, size_t len, num_decimal* dec);
+// nearest float to dec, whatever the rounding of the fast paths
+bool num_f32_slow(const num_decimal* dec, Uint32 guess, Uint32* bits);
+// compare dec (as digits * 10^exponent) with the point halfway between the
+// float with the given bits and the next one
+Sint32 num_compare_halfway(const num_big* digits,
+                           Sint32 exponent,
+                           Uint32 bits);
+void num_big_mul_add(num_big* big, Uint32 mul, Uint32 add);
+void num_big_mul_pow10(num_big* big, Sint32 exponent);
+void num_big_shift_left(num_big* big, Sint32 shift);
+Sint32 num_big_compare(const num_big* a, const num_big* b);
+
+// every power of ten a double holds exactly
+static const double num_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+bool XYZ_SCFParseI32(const char* str, size_t len, Sint32* out) {
+  SDL_assert((str != NULL || len == 0) &&
+             "XYZ_SCFParseI32: str cannot be NULL");
+  SDL_assert(out != NULL && "XYZ_SCFParseI32: out cannot be NULL");
+
+  const char* cur = str;
+  const char* end = str + len;
+  bool negative = cur < end && *cur == '-';
+  if (negative) {
+    cur++;
+  }
+
+  if (cur == end) {
+    SDL_SetError("malformed integer: '%.*s'", (Sint32)len, str);
+    return false;
+  }
+
+  Uint64 limit = negative ? (Uint64)SDL_MAX_SINT32 + 1 : SDL_MAX_SINT32;
+  Uint64 value = 0;
+  for (; cur < end; cur++) {
+    Uint32 digit = (Uint32)(Uint8)*cur - '0';
+    if (digit > 9) {
+      SDL_SetError("malformed integer: '%.*s'", (Sint32)len, str);
+      return false;
+    }
+
+    value = value * 10 + digit;
+    if (value > limit) {
+      SDL_SetError("integer out of range: '%.*s'", (Sint32)len, str);
+      return false;
+    }
+  }
+
+  *out = negative ? (Sint32)(0 - (Sint64)value) : (Sint32)value;
+  return true;
+}
+
+bool XYZ_SCFParseF32(const char* str, size_t len, float* out) {
+  SDL_assert((str != NULL || len == 0) &&
+             "XYZ_SCFParseF32: str cannot be NULL");
+  SDL_assert(out != NULL && "XYZ_SCFParseF32: out cannot be NULL");
+
+  num_decimal dec = {0};
+  if (!num_decimal_read(str, len, &dec)) {
+    SDL_SetError("malformed float: '%.*s'", (Sint32)len, str);
+    return false;
+  }
+
+  // the value is in [10^(magnitude - 1), 10^magnitude)
+  Sint32 magnitude = dec.digit_count + dec.exponent;
+  float value = 0.0f;
+  if (dec.digit_count == 0 || magnitude <= -46) {
+    value = 0.0f;  // below half the smallest float
+  } else if (magnitude > 39) {
+    SDL_SetError("float out of range: '%.*s'", (Sint32)len, str);
+    return false;
+  } else {
+    Sint32 exponent = dec.exponent;
+    if (dec.digit_count > NUM_FAST_DIGITS) {
+      exponent += dec.digit_count - NUM_FAST_DIGITS;
+    }
+
+    // both operands are exact so the double is correctly rounded, rounding
+    // it again to a float is only wrong when it lands right between two
+    // floats (the 29 bits a float drops are 1 followed by zeros)
+    double guess = (double)dec.mantissa;
+    bool exact = dec.digit_count <= NUM_FAST_DIGITS &&
+                 dec.mantissa <= ((Uint64)1 << 53) && exponent >= -22 &&
+                 exponent <= 22;
+    if (exact) {
+      guess = exponent < 0 ? guess / num_pow10[-exponent]
+                           : guess * num_pow10[exponent];
+      Uint64 guess_bits = 0;
+      SDL_memcpy(&guess_bits, &guess, sizeof(guess_bits));
+      exact = (guess_bits & 0x1fffffff) != 0x10000000;
+    } else {
+      guess *= SDL_pow(10.0, exponent);
+    }
+
+    value = (float)guess;
+    if (!exact) {
+      // the guess is at most one float away, settle it with exact integers
+      Uint32 bits = 0;
+      SDL_memcpy(&bits, &value, sizeof(bits));
+      if (!num_f32_slow(&dec, SDL_min(bits, NUM_F32_MAX), &bits)) {
+        SDL_SetError("float out of range: '%.*s'", (Sint32)len, str);
+        return false;
+      }
+      SDL_memcpy(&value, &bits, sizeof(value));
+    }
+  }
+
+  *out = dec.negative ? -value : value;
+  return true;
+}
+
+bool num_decimal_read(const char* str, size_t len, num_decimal* dec) {
+  const char* cur = str;
+  const char* end = str + len;
+  dec->negative = cur < end && *cur == '-';
+  if (dec->negative) {
+    cur++;
+  }
+
+  bool any_digit = false;
+  bool point = false;
+  Sint32 exponent = 0;
+  for (; cur < end; cur++) {
+    if (*cur == '.' && !point) {
+      point = true;
+      continue;
+    }
+
+    Uint32 digit = (Uint32)(Uint8)*cur - '0';
+    if (digit > 9) {
+      break;
+    }
+
+    any_digit = true;
+    if (digit == 0 && dec->digit_count == 0) {
+      exponent -= point;  // leading zeros only move the point
+      continue;
+    }
+
+    if (dec->digit_count == 0) {
+      dec->first = cur;
+    }
+    if (dec->digit_count < NUM_FAST_DIGITS) {
+      dec->mantissa = dec->mantissa * 10 + digit;
+    }
+    dec->digit_count++;
+    exponent -= point;
+  }
+  dec->end = cur;
+
+  if (!any_digit) {
+    return false;
+  }
+
+  if (cur < end && (*cur == 'e' || *cur == 'E')) {
+    cur++;
+    bool negative = cur < end && *cur == '-';
+    if (cur < end && (*cur == '-' || *cur == '+')) {
+      cur++;
+    }
+
+    if (cur == end) {
+      return false;
+    }
+
+    Sint32 value = 0;
+    for (; cur < end; cur++) {
+      Uint32 digit = (Uint32)(Uint8)*cur - '0';
+      if (digit > 9) {
+        return false;
+      }
+      value = SDL_min(value * 10 + (Sint32)digit, NUM_MAX_EXPONENT);
+    }
+    exponent += negative ? -value : value;
+  }
+
+  dec->exponent = exponent;
+  return cur == end;
+}
+
+bool num_f32_slow(const num_decimal* dec, Uint32 guess, Uint32* bits) {
+  // the first NUM_SLOW_DIGITS digits, plus a last 1 standing for anything
+  // nonzero after them
+  num_big digits = {0};
+  Sint32 taken = 0;
+  bool tail = false;
+  for (const char* cur = dec->first; cur < dec->end; cur++) {
+    if (*cur == '.') {
+      continue;
+    }
+
+    Uint32 digit = (Uint32)(*cur - '0');
+    if (taken < NUM_SLOW_DIGITS) {
+      num_big_mul_add(&digits, 10, digit);
+      taken++;
+    } else if (digit != 0) {
+      tail = true;
+      break;
+    }
+  }
+
+  Sint32 exponent = dec->exponent + dec->digit_count - taken;
+  if (tail) {
+    num_big_mul_add(&digits, 10, 1);
+    exponent--;
+  }
+
+  // move to the next float while past the halfway point above, then to the
+  // previous one while below the halfway point under, ties go to even
+  *bits = guess;
+  while (true) {
+    Sint32 above = num_compare_halfway(&digits, exponent, *bits);
+    if (above > 0 || (above == 0 && (*bits & 1))) {
+      if (++*bits >= NUM_F32_INFINITY) {
+        return false;
+      }
+      continue;
+    }
+
+    if (*bits > 0) {
+      Sint32 below = num_compare_halfway(&digits, exponent, *bits - 1);
+      if (below < 0 || (below == 0 && (*bits & 1))) {
+        --*bits;
+        continue;
+      }
+    }
+    return true;
+  }
+}
+
+Sint32 num_compare_halfway(const num_big* digits,
+                           Sint32 exponent,
+                           Uint32 bits) {
+  // the float is mantissa * 2^binary, the next one (mantissa + 1) * 2^binary
+  // so the point between them is (2 * mantissa + 1) * 2^(binary - 1)
+  Uint32 biased = bits >> 23;
+  Uint32 mantissa = bits & 0x7fffff;
+  Sint32 binary = -149;
+  if (biased != 0) {
+    mantissa |= 0x800000;
+    binary = (Sint32)biased - 150;
+  }
+
+  num_big left = *digits;
+  num_big right = {0};
+  num_big_mul_add(&right, 1, 2 * mantissa + 1);
+  if (exponent >= 0) {
+    num_big_mul_pow10(&left, exponent);
+  } else {
+    num_big_mul_pow10(&right, -exponent);
+  }
+  if (binary - 1 >= 0) {
+    num_big_shift_left(&right, binary - 1);
+  } else {
+    num_big_shift_left(&left, 1 - binary);
+  }
+  return num_big_compare(&left, &right);
+}
+
+void num_big_mul_add(num_big* big, Uint32 mul, Uint32 add) {
+  Uint64 carry = add;
+  for (Uint32 i = 0; i < big->count; i++) {
+    Uint64 limb = (Uint64)big->limbs[i] * mul + carry;
+    big->limbs[i] = (Uint32)limb;
+    carry = limb >> 32;
+  }
+
+  if (carry != 0) {
+    SDL_assert(big->count < NUM_BIG_LIMBS && "num_big: out of limbs");
+    big->limbs[big->count++] = (Uint32)carry;
+  }
+}
+
+void num_big_mul_pow10(num_big* big, Sint32 exponent) {
+  for (; exponent >= 9; exponent -= 9) {
+    num_big_mul_add(big, 1000000000, 0);
+  }
+  if (exponent > 0) {
+    num_big_mul_add(big, (Uint32)num_pow10[exponent], 0);
+  }
+}
+
+void num_big_shift_left(num_big* big, Sint32 shift) {
+  if (big->count == 0) {
+    return;
+  }
+
+  Uint32 limbs = (Uint32)shift / 32;
+  Uint32 bits = (Uint32)shift % 32;
+  SDL_assert(big->count + limbs + 1 <= NUM_BIG_LIMBS &&
+             "num_big: out of limbs");
+
+  big->limbs[big->count + limbs] = 0;
+  for (Uint32 i = big->count; i-- > 0;) {
+    Uint32 limb = big->limbs[i];
+    if (bits != 0) {
+      big->limbs[i + limbs + 1] |= limb >> (32 - bits);
+    }
+    big->limbs[i + limbs] = limb << bits;
+  }
+  SDL_memset(big->limbs, 0, limbs * sizeof(Uint32));
+
+  big->count += limbs + 1;
+  while (big->count > 0 && big->limbs[big->count - 1] == 0) {
+    big->count--;
+  }
+}
+
+Sint32 num_big_compare(const num_big* a, const num_big* b) {
+  if (a->count != b->count) {
+    return a->count > b->count ? 1 : -1;
+  }
+
+  for (Uint32 i = a->count; i-- > 0;) {
+    if (a->limbs[i] != b->limbs[i]) {
+      return a->limbs[i] > b->limbs[i] ? 1 : -1;
+    }
+  }
+  return 0;
+}
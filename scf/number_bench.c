@@ -0,0 +1,116 @@
+#include <scf/number.h>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_NUMBERS 1000000
+#define BENCH_ROUNDS 5
+#define BENCH_NUMBER_MAX 32
+
+// baseline: what parse_value did before, copy into a zeroed buffer and
+// convert from there
+#define BENCH_MAX_DIGITS 250
+Sint32 copy_atoi(const char* str, size_t len);
+float copy_atof(const char* str, size_t len);
+
+Sint32 copy_atoi(const char* str, size_t len) {
+  char digits[BENCH_MAX_DIGITS] = {0};
+  SDL_memset(digits, 0, BENCH_MAX_DIGITS);
+  SDL_memcpy(digits, str, SDL_min(len, BENCH_MAX_DIGITS));
+  return SDL_atoi(digits);
+}
+
+float copy_atof(const char* str, size_t len) {
+  char digits[BENCH_MAX_DIGITS] = {0};
+  SDL_memset(digits, 0, BENCH_MAX_DIGITS);
+  SDL_memcpy(digits, str, SDL_min(len, BENCH_MAX_DIGITS));
+  return (float)SDL_atof(digits);
+}
+
+int main(void) {
+  // numbers as they show up in curve and tuning tables
+  char* ints = SDL_malloc(BENCH_NUMBERS * BENCH_NUMBER_MAX);
+  char* floats = SDL_malloc(BENCH_NUMBERS * BENCH_NUMBER_MAX);
+  size_t* int_lens = SDL_malloc(BENCH_NUMBERS * sizeof(size_t));
+  size_t* float_lens = SDL_malloc(BENCH_NUMBERS * sizeof(size_t));
+  if (ints == NULL || floats == NULL || int_lens == NULL ||
+      float_lens == NULL) {
+    return 1;
+  }
+
+  Uint32 seed = 7;
+  for (Sint32 i = 0; i < BENCH_NUMBERS; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    char* dst = ints + i * BENCH_NUMBER_MAX;
+    int_lens[i] = SDL_snprintf(dst, BENCH_NUMBER_MAX, "%d",
+                               (Sint32)(seed >> 4) - (1 << 27));
+
+    dst = floats + i * BENCH_NUMBER_MAX;
+    float value = (Sint32)(seed >> 8) / 65536.0f - 128.0f;
+    switch (i % 3) {
+      case 0:
+        float_lens[i] = SDL_snprintf(dst, BENCH_NUMBER_MAX, "%.3f", value);
+        break;
+      case 1:
+        float_lens[i] = SDL_snprintf(dst, BENCH_NUMBER_MAX, "%.7f", value);
+        break;
+      default:
+        float_lens[i] = SDL_snprintf(dst, BENCH_NUMBER_MAX, "%.4e", value);
+        break;
+    }
+  }
+
+  double times[4] = {0};
+  Sint64 sum = 0;
+  double fsum = 0.0;
+  for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+    double elapsed[4] = {0};
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_NUMBERS; i++) {
+      sum += copy_atoi(ints + i * BENCH_NUMBER_MAX, int_lens[i]);
+    }
+    elapsed[0] = bench_elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_NUMBERS; i++) {
+      Sint32 value = 0;
+      XYZ_SCFParseI32(ints + i * BENCH_NUMBER_MAX, int_lens[i], &value);
+      sum += value;
+    }
+    elapsed[1] = bench_elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_NUMBERS; i++) {
+      fsum += copy_atof(floats + i * BENCH_NUMBER_MAX, float_lens[i]);
+    }
+    elapsed[2] = bench_elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_NUMBERS; i++) {
+      float value = 0.0f;
+      XYZ_SCFParseF32(floats + i * BENCH_NUMBER_MAX, float_lens[i], &value);
+      fsum += value;
+    }
+    elapsed[3] = bench_elapsed(start);
+
+    for (Sint32 i = 0; i < 4; i++) {
+      times[i] = round == 0 ? elapsed[i] : SDL_min(times[i], elapsed[i]);
+    }
+  }
+
+  SDL_Log("i32: copy + atoi %6.1f ns, parse %6.1f ns",
+          times[0] * 1e9 / BENCH_NUMBERS, times[1] * 1e9 / BENCH_NUMBERS);
+  SDL_Log("f32: copy + atof %6.1f ns, parse %6.1f ns (%lld %f)",
+          times[2] * 1e9 / BENCH_NUMBERS, times[3] * 1e9 / BENCH_NUMBERS,
+          (long long)sum, fsum);
+
+  SDL_free(ints);
+  SDL_free(floats);
+  SDL_free(int_lens);
+  SDL_free(float_lens);
+  return 0;
+}
@@ -0,0 +1,139 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/number.h>
+
+#include <stdlib.h>
+
+static bool parse_i32(const char* str, Sint32* out) {
+  return XYZ_SCFParseI32(str, SDL_strlen(str), out);
+}
+
+static bool parse_f32(const char* str, float* out) {
+  return XYZ_SCFParseF32(str, SDL_strlen(str), out);
+}
+
+static Uint32 f32_bits(float value) {
+  Uint32 bits = 0;
+  SDL_memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static void number_i32(void** state) {
+  (void)state;
+
+  Sint32 value = 0;
+  assert_true(parse_i32("0", &value));
+  assert_int_equal(value, 0);
+  assert_true(parse_i32("-17", &value));
+  assert_int_equal(value, -17);
+  assert_true(parse_i32("000123", &value));
+  assert_int_equal(value, 123);
+  assert_true(parse_i32("2147483647", &value));
+  assert_int_equal(value, SDL_MAX_SINT32);
+  assert_true(parse_i32("-2147483648", &value));
+  assert_int_equal(value, SDL_MIN_SINT32);
+
+  const char* bad[] = {
+      "2147483648", "-2147483649", "99999999999999999999999", "", "-", "1a",
+  };
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    assert_false(parse_i32(bad[i], &value));
+  }
+}
+
+static void number_f32(void** state) {
+  (void)state;
+
+  const struct {
+    const char* str;
+    Uint32 bits;
+  } cases[] = {
+      {"0.0", 0x00000000},
+      {"-0.0", 0x80000000},
+      {"1.5", 0x3fc00000},
+      {"-9.81", 0xc11cf5c3},
+      {"0.1", 0x3dcccccd},
+      {"5.", 0x40a00000},
+      {"-.5", 0xbf000000},
+      {"1e3", 0x447a0000},
+      {"1E+3", 0x447a0000},
+      {"2.5e-3", 0x3b23d70a},
+      {"3.4028235e38", 0x7f7fffff},
+      {"1e-45", 0x00000001},
+      {"7e-46", 0x00000000},
+      {"1e-99999", 0x00000000},
+      // exactly halfway between 1 and the next float, ties go to even
+      {"1.000000059604644775390625", 0x3f800000},
+      // a hair above halfway, as a double it rounds to the halfway point
+      {"1.000000059604644775390625000000001", 0x3f800001},
+      {"1.00000005960464477539062499999", 0x3f800000},
+      {"0.1000000000000000055511151231257827021181583404541015625",
+       0x3dcccccd},
+  };
+  for (size_t i = 0; i < SDL_arraysize(cases); i++) {
+    float value = 1.0f;
+    assert_true(parse_f32(cases[i].str, &value));
+    assert_int_equal(f32_bits(value), cases[i].bits);
+  }
+
+  const char* bad[] = {
+      "", "-", ".", "-.", "1e", "1e+", "1e5x", "1.2.3", "3.5e38", "1e39",
+  };
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    float value = 0.0f;
+    assert_false(parse_f32(bad[i], &value));
+  }
+}
+
+static void number_f32_random(void** state) {
+  (void)state;
+
+  // random digits, points and exponents checked against the C library, which
+  // rounds correctly on the platforms we test
+  char str[64];
+  Uint32 seed = 4242;
+  for (Sint32 round = 0; round < 200000; round++) {
+    size_t len = 0;
+    seed = seed * 1664525u + 1013904223u;
+    Uint32 digits = (seed >> 8) % 24 + 1;
+    Uint32 point = (seed >> 16) % (digits + 1);
+    for (Uint32 i = 0; i < digits; i++) {
+      if (i == point) {
+        str[len++] = '.';
+      }
+      seed = seed * 1664525u + 1013904223u;
+      str[len++] = (char)('0' + (seed >> 8) % 10);
+    }
+    seed = seed * 1664525u + 1013904223u;
+    if (seed & 0x100) {
+      len += SDL_snprintf(str + len, sizeof(str) - len, "e%d",
+                          (Sint32)((seed >> 9) % 100) - 60);
+    }
+    str[len] = '\0';
+
+    float expected = strtof(str, NULL);
+    float value = 0.0f;
+    if (f32_bits(expected) == 0x7f800000) {
+      assert_false(parse_f32(str, &value));
+      continue;
+    }
+    assert_true(parse_f32(str, &value));
+    assert_int_equal(f32_bits(value), f32_bits(expected));
+  }
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(number_i32),
+      cmocka_unit_test(number_f32),
+      cmocka_unit_test(number_f32_random),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
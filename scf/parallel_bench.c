@@ -0,0 +1,61 @@
+#include <scf/scf.h>
+
+#include <SDL3/SDL_cpuinfo.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_SIZE (64 * 1024 * 1024)
+#define BENCH_ROUNDS 3
+
+int main(void) {
+  size_t len = 0;
+  char* data = bench_generate_config(BENCH_SIZE, &len);
+  if (data == NULL) {
+    return 1;
+  }
+
+  SDL_Log("%.1f MB, %d logical cores", len / 1048576.0,
+          SDL_GetNumLogicalCPUCores());
+
+  const struct {
+    const char* name;
+    Uint32 flags;
+  } modes[] = {
+      {"zero copy", XYZ_SCF_PARSE_ZERO_COPY},
+      {"copied keys", 0},
+      {"interned keys", XYZ_SCF_PARSE_INTERN_KEYS},
+  };
+  const Sint32 threads[] = {1, 2, 4, 8, 12, 16};
+  for (size_t m = 0; m < SDL_arraysize(modes); m++) {
+    SDL_Log("%s", modes[m].name);
+    double base = 0.0;
+    for (size_t t = 0; t < SDL_arraysize(threads); t++) {
+      double best = 0.0;
+      for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        XYZ_SCFDocument* doc = XYZ_SCFParseDocumentParallel(
+            data, len, modes[m].flags, threads[t]);
+        double elapsed = bench_elapsed(start);
+        if (doc == NULL) {
+          SDL_Log("parse failed: %s", SDL_GetError());
+          return 1;
+        }
+        XYZ_SCFDocumentDestroy(doc);
+        // every round interns the keys anew
+        XYZ_SCFAtomsQuit();
+        best = round == 0 ? elapsed : SDL_min(best, elapsed);
+      }
+
+      base = t == 0 ? best : base;
+      SDL_Log("%2d threads %8.2f ms %8.1f MB/s  x%.2f", threads[t],
+              best * 1e3, len / 1048576.0 / best, base / best);
+    }
+  }
+
+  SDL_free(data);
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include "scf/parser.h"
 #include "scf/lexer.h"
+#include "scf/number.h"
 #include "scf/table.h"
 
 #include <SDL3/SDL_assert.h>
@@ -13,8 +14,106 @@ bool expect_type(XYZ_SCFParser* parser,
                  XYZ_SCFTokenType type,
                  XYZ_SCFToken* token);
 bool parse_block(XYZ_SCFParser* parser, XYZ_SCFValue* value);
+// parse the entries of a block up to its '}' into table
+bool parse_entries(XYZ_SCFParser* parser, XYZ_SCFTable* table);
+// make value a table that parses the block from the current '{' to close on
+// first use and move past close, value is left untouched on failure
+bool parse_skip_block(XYZ_SCFParser* parser,
+                      const XYZ_SCFToken* close,
+                      XYZ_SCFValue* value);
+// shared with table.c, parse a block skipped by parse_skip_block into table
+bool parse_lazy_block(XYZ_SCFTable* table);
 bool parse_value(XYZ_SCFParser* parser, XYZ_SCFValue* value);
-XYZ_SCFPair* parse_entry(XYZ_SCFParser* parser);
+// parse the elements after '[' up to the closing ']', the type and count of
+// the elements are found first so they are parsed straight into one buffer
+bool parse_array(XYZ_SCFParser* parser, XYZ_SCFValue* value);
+// type and count of the elements after '[', shared with events.c
+bool parse_array_scan(XYZ_SCFParser* parser,
+                      XYZ_SCFValueType* type,
+                      Uint32* count,
+                      size_t* string_bytes);
+// array type of an element token, NIL if it cannot be one
+XYZ_SCFValueType parse_array_type(const XYZ_SCFToken* token);
+// element of an array of type at token, strings point into the token
+bool parse_array_item(const XYZ_SCFToken* token,
+                      XYZ_SCFValueType type,
+                      XYZ_SCFValue* item);
+// parse a key and its value or block, appending them to table
+XYZ_SCFPair* parse_entry(XYZ_SCFParser* parser, XYZ_SCFTable* table);
+// body of XYZ_SCFParseTable, which sets up the schema state around it
+bool parse_root(XYZ_SCFParser* parser, XYZ_SCFTable* table);
+// check the value of the known key field, see XYZ_SCFParseTable
+bool parse_check(XYZ_SCFParser* parser,
+                 const XYZ_SCFSchemaField* field,
+                 XYZ_SCFValue* value,
+                 const XYZ_SCFToken* token);
+
+// shared with error.c, records where parsing failed
+bool error_at(XYZ_SCFError* error,
+              const XYZ_SCFToken* token,
+              Uint32 expected,
+              const char* fmt,
+              ...);
+// shared with schema.c so tables and settings structs follow the same rules
+bool schema_check(const XYZ_SCFSchemaField* field,
+                  XYZ_SCFValue* value,
+                  const XYZ_SCFToken* token,
+                  XYZ_SCFError* error);
+// shared with table.c, see XYZ_SCFArrayCreate
+bool table_array_alloc(XYZ_SCFArena* arena,
+                       XYZ_SCFValueType type,
+                       Uint32 count,
+                       size_t string_bytes,
+                       XYZ_SCFValue* value);
+bool schema_default(const XYZ_SCFSchema* schema,
+                    const XYZ_SCFSchemaField* field,
+                    XYZ_SCFArena* arena,
+                    XYZ_SCFValue* value);
+void schema_clear(const XYZ_SCFSchema* schema, Uint32* seen, Uint32 scope);
+void schema_mark(const XYZ_SCFSchema* schema,
+                 Uint32* seen,
+                 const XYZ_SCFSchemaField* field);
+bool schema_complete(const XYZ_SCFSchema* schema,
+                     Uint32* seen,
+                     Uint32 scope,
+                     XYZ_SCFTable* table,
+                     XYZ_SCFArena* arena,
+                     const XYZ_SCFToken* token,
+                     XYZ_SCFError* error);
+
+// what XYZ_SCF_PARSE_LAZY keeps of a block until it is parsed
+typedef struct XYZ_SCFLazyBlock {
+  XYZ_SCFToken open;  // the '{', with the data cut right after its '}'
+  Uint32 flags;
+} XYZ_SCFLazyBlock;
+
+typedef enum {
+  push_state_key,
+  push_state_assign,
+  push_state_value,
+  push_state_array,
+} push_state;
+
+// grow a heap buffer to fit len bytes
+bool push_reserve(void** buf, size_t* cap, size_t len, size_t size);
+// lex and parse complete tokens of data, used is where the cut token starts
+bool push_lex(XYZ_SCFPushParser* parser,
+              const char* data,
+              size_t len,
+              size_t* used);
+// advance the parser state with the next token
+bool push_token(XYZ_SCFPushParser* parser, const XYZ_SCFToken* token);
+// parse data as the value of the current key and append it to table
+bool push_value(XYZ_SCFPushParser* parser,
+                XYZ_SCFTable* table,
+                const XYZ_SCFToken* token,
+                size_t len);
+// find where the token in carry ends in data, take is how many bytes of data
+// to append to it
+bool push_token_end(XYZ_SCFPushParser* parser,
+                    const char* data,
+                    size_t len,
+                    size_t* take);
 
 void XYZ_SCFParserSetFile(XYZ_SCFParser* parser, const char* data, size_t len) {
   SDL_assert(parser != NULL && "XYZ_SCFParserSetFile: parser cannot be NULL");
@@ -28,15 +127,36 @@ bool XYZ_SCFParseTable(XYZ_SCFParser* parser, XYZ_SCFTable* out_table) {
   SDL_assert(out_table != NULL &&
              "XYZ_SCFParseTable: out_table cannot be NULL");
 
-  XYZ_SCFToken eof = {0};
-  if (!expect_type(parser, XYZ_SCF_TOKEN_TYPE_START, NULL)) {
-    SDL_SetError("was expecting start of file but found: '%.*s'",
-                 (Sint32)parser->cur.val_len, parser->cur.val_start);
+  SDL_memset(&parser->error, 0, sizeof(XYZ_SCFError));
+  const XYZ_SCFSchema* schema = parser->schema;
+  if (schema == NULL) {
+    return parse_root(parser, out_table);
+  }
+
+  size_t seen_size = (schema->field_count / 32 + 1) * sizeof(Uint32);
+  parser->seen = parser->arena != NULL
+                     ? XYZ_SCFArenaAlloc(parser->arena, seen_size)
+                     : SDL_malloc(seen_size);
+  if (parser->seen == NULL) {
     return false;
   }
+  parser->scope = 0;
+  schema_clear(schema, parser->seen, 0);
 
-  if (expect_type(parser, XYZ_SCF_TOKEN_TYPE_EOF, NULL)) {
-    return true;
+  bool parsed = parse_root(parser, out_table);
+  if (parser->arena == NULL) {
+    SDL_free(parser->seen);
+  }
+  parser->seen = NULL;
+  return parsed;
+}
+
+bool parse_root(XYZ_SCFParser* parser, XYZ_SCFTable* out_table) {
+  XYZ_SCFToken eof = {0};
+  if (!expect_type(parser, XYZ_SCF_TOKEN_TYPE_START, NULL)) {
+    return error_at(&parser->error, &parser->cur, 0,
+                    "was expecting start of file but found: '%.*s'",
+                    (Sint32)parser->cur.val_len, parser->cur.val_start);
   }
 
   while (true) {
@@ -44,20 +164,25 @@ bool XYZ_SCFParseTable(XYZ_SCFParser* parser, XYZ_SCFTable* out_table) {
       break;
     }
 
-    XYZ_SCFPair* entry = parse_entry(parser);
-    if (entry == NULL) {
+    if (parse_entry(parser, out_table) == NULL) {
+      // the end of file could have come instead of a key
+      if (parser->error.expected == XYZ_SCF_EXPECT_KEY) {
+        parser->error.expected |= XYZ_SCF_EXPECT_EOF;
+      }
       return false;
     }
-
-    XYZ_SCFTableAdd(out_table, entry);
   }
 
   if (eof.type != XYZ_SCF_TOKEN_TYPE_EOF) {
-    SDL_SetError("was expecting end of file but found: '%.*s'",
-                 (Sint32)parser->cur.val_len, parser->cur.val_start);
-    return false;
+    return error_at(&parser->error, &parser->cur, XYZ_SCF_EXPECT_EOF,
+                    "was expecting end of file but found: '%.*s'",
+                    (Sint32)parser->cur.val_len, parser->cur.val_start);
   }
 
+  if (parser->schema != NULL) {
+    return schema_complete(parser->schema, parser->seen, 0, out_table,
+                           parser->arena, &eof, &parser->error);
+  }
   return true;
 }
 
@@ -116,65 +241,238 @@ bool expect_type(XYZ_SCFParser* parser,
   return XYZ_SCFNextToken(&parser->cur);
 }
 
-XYZ_SCFPair* parse_entry(XYZ_SCFParser* parser) {
+XYZ_SCFPair* parse_entry(XYZ_SCFParser* parser, XYZ_SCFTable* table) {
   XYZ_SCFToken key_token = {0};
   if (!expect_type(parser, XYZ_SCF_TOKEN_TYPE_WORD, &key_token)) {
-    SDL_SetError("was expecting identifier but found: '%.*s'",
-                 (Sint32)parser->cur.val_len, parser->cur.val_start);
+    error_at(&parser->error, &parser->cur, XYZ_SCF_EXPECT_KEY,
+             "was expecting identifier but found: '%.*s'",
+             (Sint32)parser->cur.val_len, parser->cur.val_start);
     return NULL;
   }
 
+  Uint32 flags = 0;
+  if (parser->flags & XYZ_SCF_PARSE_ZERO_COPY) {
+    flags = XYZ_SCF_PAIR_FLAG_KEY_VIEW;
+  } else if (parser->flags & XYZ_SCF_PARSE_INTERN_KEYS) {
+    flags = XYZ_SCF_PAIR_FLAG_KEY_ATOM;
+  }
+
+  const XYZ_SCFSchemaField* field = NULL;
+  if (parser->schema != NULL) {
+    field = XYZ_SCFSchemaFind(parser->schema, parser->scope,
+                              key_token.val_start, key_token.val_len);
+  }
+
   XYZ_SCFValue value = {0};
-  if (expect_punct(parser, "{", NULL)) {
-    if (!parse_block(parser, &value)) {
+  XYZ_SCFToken token = parser->cur;
+  // blocks the brace matching cannot skip are parsed, and fail, right away
+  XYZ_SCFToken close = token;
+  if ((parser->flags & XYZ_SCF_PARSE_LAZY) && parser->schema == NULL &&
+      XYZ_SCFSkipBlock(&close)) {
+    if (!parse_skip_block(parser, &close, &value)) {
+      return NULL;
+    }
+    return XYZ_SCFTableAppend(table, key_token.val_start, key_token.val_len,
+                              value, flags);
+  } else if (expect_punct(parser, "{", NULL)) {
+    if (field != NULL && field->type != XYZ_SCF_VALUE_TYPE_TABLE) {
+      error_at(&parser->error, &token, 0,
+               "key '%.*s' expects a value, not a block",
+               (Sint32)field->key_len, field->key);
       return NULL;
     }
 
-    return XYZ_SCFPairCreate(key_token.val_start, key_token.val_len, value);
+    // the keys of blocks the schema does not know are not checked
+    Uint32 scope = parser->scope;
+    parser->scope = XYZ_SCF_SCHEMA_NO_SCOPE;
+    if (field != NULL) {
+      parser->scope = field->block;
+      schema_clear(parser->schema, parser->seen, field->block);
+      schema_mark(parser->schema, parser->seen, field);
+    }
+
+    bool parsed = parse_block(parser, &value);
+    parser->scope = scope;
+    if (!parsed) {
+      // what the block had so far, nothing else owns it
+      if (parser->arena == NULL && value.as_table != NULL) {
+        XYZ_SCFTableDestroy(value.as_table);
+        SDL_free(value.as_table);
+      }
+      return NULL;
+    }
+
+    return XYZ_SCFTableAppend(table, key_token.val_start, key_token.val_len,
+                              value, flags);
   } else if (expect_punct(parser, "=", NULL)) {
+    token = parser->cur;
     if (!parse_value(parser, &value)) {
       return NULL;
     }
 
-    return XYZ_SCFPairCreate(key_token.val_start, key_token.val_len, value);
+    if ((parser->flags & XYZ_SCF_PARSE_ZERO_COPY) &&
+        value.type == XYZ_SCF_VALUE_TYPE_STRING) {
+      flags |= XYZ_SCF_PAIR_FLAG_STRING_VIEW;
+    }
+
+    if (field != NULL && !parse_check(parser, field, &value, &token)) {
+      // the pair that would have owned the string or array is never made
+      bool owned = XYZ_SCFIsArrayType(value.type) ||
+                   (value.type == XYZ_SCF_VALUE_TYPE_STRING &&
+                    !(flags & XYZ_SCF_PAIR_FLAG_STRING_VIEW));
+      if (owned && parser->arena == NULL) {
+        SDL_free(value.as_array);
+      }
+      return NULL;
+    }
+    return XYZ_SCFTableAppend(table, key_token.val_start, key_token.val_len,
+                              value, flags);
   }
 
-  SDL_SetError("was expecting assign '=' or block '{' but found: '%.*s'",
-               (Sint32)parser->cur.val_len, parser->cur.val_start);
+  error_at(&parser->error, &parser->cur,
+           XYZ_SCF_EXPECT_ASSIGN | XYZ_SCF_EXPECT_BLOCK,
+           "was expecting assign '=' or block '{' but found: '%.*s'",
+           (Sint32)parser->cur.val_len, parser->cur.val_start);
   return NULL;
 }
 
+bool parse_check(XYZ_SCFParser* parser,
+                 const XYZ_SCFSchemaField* field,
+                 XYZ_SCFValue* value,
+                 const XYZ_SCFToken* token) {
+  if (!schema_check(field, value, token, &parser->error)) {
+    return false;
+  }
+
+  if (value->type != XYZ_SCF_VALUE_TYPE_NIL) {
+    schema_mark(parser->schema, parser->seen, field);
+    return true;
+  }
+
+  // nil stands for the default, a block of defaults for blocks
+  if (!schema_default(parser->schema, field, parser->arena, value)) {
+    return false;
+  }
+  schema_mark(parser->schema, parser->seen, field);
+  if (field->type != XYZ_SCF_VALUE_TYPE_TABLE) {
+    return true;
+  }
+
+  schema_clear(parser->schema, parser->seen, field->block);
+  return schema_complete(parser->schema, parser->seen, field->block,
+                         value->as_table, parser->arena, token,
+                         &parser->error);
+}
+
 bool parse_block(XYZ_SCFParser* parser, XYZ_SCFValue* value) {
-  XYZ_SCFToken eob = {0};
-  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  XYZ_SCFTable* table = XYZ_SCFTableCreateWithArena(parser->arena);
+  if (table == NULL) {
+    return false;
+  }
   value->type = XYZ_SCF_VALUE_TYPE_TABLE;
   value->as_table = table;
+  return parse_entries(parser, table);
+}
 
+bool parse_entries(XYZ_SCFParser* parser, XYZ_SCFTable* table) {
   // closing right after opening: "table {}"
+  XYZ_SCFToken eob = {0};
   while (true) {
     if (expect_punct(parser, "}", &eob)) {
       break;
     }
 
-    XYZ_SCFPair* entry = parse_entry(parser);
-    if (entry == NULL) {
+    if (parse_entry(parser, table) == NULL) {
+      if (parser->error.expected == XYZ_SCF_EXPECT_KEY) {
+        parser->error.expected |= XYZ_SCF_EXPECT_BLOCK_END;
+      }
       return false;
     }
-
-    XYZ_SCFTableAdd(table, entry);
   }
 
   if (eob.type != XYZ_SCF_TOKEN_TYPE_PUNCT) {
-    SDL_SetError("was expecting end of block '}' but found: '%.*s'",
-                 (Sint32)parser->cur.val_len, parser->cur.val_start);
+    return error_at(&parser->error, &parser->cur, XYZ_SCF_EXPECT_BLOCK_END,
+                    "was expecting end of block '}' but found: '%.*s'",
+                    (Sint32)parser->cur.val_len, parser->cur.val_start);
+  }
+
+  if (parser->schema != NULL) {
+    return schema_complete(parser->schema, parser->seen, parser->scope, table,
+                           parser->arena, &eob, &parser->error);
+  }
+  return true;
+}
+
+bool parse_skip_block(XYZ_SCFParser* parser,
+                      const XYZ_SCFToken* close,
+                      XYZ_SCFValue* value) {
+  XYZ_SCFTable* table = XYZ_SCFTableCreateWithArena(parser->arena);
+  if (table == NULL) {
+    return false;
+  }
+
+  size_t lazy_size = sizeof(XYZ_SCFLazyBlock);
+  table->lazy = parser->arena != NULL
+                    ? XYZ_SCFArenaAlloc(parser->arena, lazy_size)
+                    : SDL_malloc(lazy_size);
+  if (table->lazy == NULL) {
+    if (parser->arena == NULL) {
+      SDL_free(table);
+    }
     return false;
   }
 
+  // the block is lexed again from its '{' when parsed, positions and error
+  // offsets are then still those of the whole data
+  table->lazy->open = parser->cur;
+  table->lazy->open.buf_len = close->val_start + 1 - parser->cur.buf_start;
+  table->lazy->flags = parser->flags;
+
+  parser->cur = *close;
+  if (!XYZ_SCFNextToken(&parser->cur)) {
+    if (parser->arena == NULL) {
+      XYZ_SCFTableDestroy(table);
+      SDL_free(table);
+    }
+    return error_at(&parser->error, &parser->cur, 0, "%s", SDL_GetError());
+  }
+
+  value->type = XYZ_SCF_VALUE_TYPE_TABLE;
+  value->as_table = table;
   return true;
 }
 
+bool parse_lazy_block(XYZ_SCFTable* table) {
+  // off the table while its entries are added, they must not parse it again
+  XYZ_SCFLazyBlock* lazy = table->lazy;
+  table->lazy = NULL;
+
+  XYZ_SCFParser parser = {
+      .cur = lazy->open,
+      .arena = table->arena,
+      .flags = lazy->flags,
+  };
+  bool parsed =
+      expect_punct(&parser, "{", NULL)
+          ? parse_entries(&parser, table)
+          : error_at(&parser.error, &parser.cur, 0, "%s", SDL_GetError());
+  if (parsed) {
+    if (table->arena == NULL) {
+      SDL_free(lazy);
+    }
+    return true;
+  }
+
+  // keep nothing of a block that failed but leave it unparsed, so every look
+  // into it fails with the same error instead of finding it empty
+  XYZ_SCFArena* arena = table->arena;
+  XYZ_SCFTableDestroy(table);
+  table->arena = arena;
+  table->lazy = lazy;
+  return false;
+}
+
 bool parse_value(XYZ_SCFParser* parser, XYZ_SCFValue* value) {
-  char digits[XYZ_SCF_MAX_DIGITS] = {0};
   XYZ_SCFToken token = {0};
   if (expect_word(parser, "nil", NULL)) {
     value->type = XYZ_SCF_VALUE_TYPE_NIL;
@@ -185,21 +483,27 @@ bool parse_value(XYZ_SCFParser* parser, XYZ_SCFValue* value) {
     value->type = XYZ_SCF_VALUE_TYPE_BOOL;
     value->as_bool = false;
   } else if (expect_type(parser, XYZ_SCF_TOKEN_TYPE_INTEGER, &token)) {
-    SDL_memset(digits, 0, XYZ_SCF_MAX_DIGITS);
-    SDL_memcpy(digits, token.val_start,
-               SDL_min(token.val_len, XYZ_SCF_MAX_DIGITS));
     value->type = XYZ_SCF_VALUE_TYPE_I32;
-    value->as_i32 = SDL_atoi(digits);
+    if (!XYZ_SCFParseI32(token.val_start, token.val_len, &value->as_i32)) {
+      return error_at(&parser->error, &token, 0, "%s", SDL_GetError());
+    }
   } else if (expect_type(parser, XYZ_SCF_TOKEN_TYPE_FLOAT, &token)) {
-    SDL_memset(digits, 0, XYZ_SCF_MAX_DIGITS);
-    SDL_memcpy(digits, token.val_start,
-               SDL_min(token.val_len, XYZ_SCF_MAX_DIGITS));
     value->type = XYZ_SCF_VALUE_TYPE_F32;
-    value->as_f32 = SDL_atof(digits);
+    if (!XYZ_SCFParseF32(token.val_start, token.val_len, &value->as_f32)) {
+      return error_at(&parser->error, &token, 0, "%s", SDL_GetError());
+    }
   } else if (expect_type(parser, XYZ_SCF_TOKEN_TYPE_STRING, &token)) {
     size_t token_len = token.val_len;
     value->type = XYZ_SCF_VALUE_TYPE_STRING;
-    value->as_string = SDL_malloc(token_len);
+    value->str_len = (Uint32)(token_len - 2);
+    if (parser->flags & XYZ_SCF_PARSE_ZERO_COPY) {
+      value->as_string = (char*)token.val_start + 1;  // unquote
+      return true;
+    }
+
+    value->as_string = parser->arena != NULL
+                           ? XYZ_SCFArenaAlloc(parser->arena, token_len)
+                           : SDL_malloc(token_len);
     if (value->as_string == NULL) {
       return false;
     }
@@ -207,11 +511,482 @@ bool parse_value(XYZ_SCFParser* parser, XYZ_SCFValue* value) {
     SDL_memset(value->as_string, 0, token_len);
     SDL_memcpy(value->as_string, token.val_start + 1,
                token_len - 2);  // unquote
+  } else if (expect_punct(parser, "[", NULL)) {
+    return parse_array(parser, value);
   } else {
-    SDL_SetError("was expecting a value but found '%.*s'",
-                 (Sint32)token.val_len, token.val_start);
+    return error_at(&parser->error, &parser->cur, XYZ_SCF_EXPECT_VALUE,
+                    "was expecting a value but found '%.*s'",
+                    (Sint32)parser->cur.val_len, parser->cur.val_start);
+  }
+
+  return true;
+}
+
+bool parse_array(XYZ_SCFParser* parser, XYZ_SCFValue* value) {
+  XYZ_SCFValueType type = XYZ_SCF_VALUE_TYPE_NIL;
+  Uint32 count = 0;
+  size_t string_bytes = 0;
+  if (!parse_array_scan(parser, &type, &count, &string_bytes) ||
+      !table_array_alloc(parser->arena, type, count, string_bytes, value)) {
+    return false;
+  }
+
+  // parse again into the buffer, the tokens are known to be good
+  char* strings = (char*)(value->as_strings + count);
+  bool parsed = true;
+  for (Uint32 i = 0; parsed && i < count; i++) {
+    XYZ_SCFValue item = {0};
+    parsed = parse_array_item(&parser->cur, type, &item);
+    switch (type) {
+      case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+        value->as_bools[i] = item.as_bool;
+        break;
+      case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+        value->as_i32s[i] = item.as_i32;
+        break;
+      case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+        value->as_f32s[i] = item.as_f32;
+        break;
+      default:
+        // copied even when zero copy, the elements must be null terminated
+        SDL_memcpy(strings, item.as_string, item.str_len);
+        strings[item.str_len] = '\0';
+        value->as_strings[i] = strings;
+        strings += item.str_len + 1;
+        break;
+    }
+
+    if (parsed) {
+      XYZ_SCFNextToken(&parser->cur);
+    }
+  }
+
+  // past the ']', which the next token may fail to follow
+  if (!parsed || !XYZ_SCFNextToken(&parser->cur)) {
+    if (parser->arena == NULL) {
+      SDL_free(value->as_array);
+    }
+    return error_at(&parser->error, &parser->cur, 0, "%s", SDL_GetError());
+  }
+  return true;
+}
+
+bool parse_array_scan(XYZ_SCFParser* parser,
+                      XYZ_SCFValueType* type,
+                      Uint32* count,
+                      size_t* string_bytes) {
+  // lex ahead of cur, integers in a float array are floats
+  XYZ_SCFToken token = parser->cur;
+  while (token.type != XYZ_SCF_TOKEN_TYPE_PUNCT || *token.val_start != ']') {
+    XYZ_SCFValueType item = parse_array_type(&token);
+    if (item == XYZ_SCF_VALUE_TYPE_NIL) {
+      return error_at(&parser->error, &token,
+                      XYZ_SCF_EXPECT_VALUE | XYZ_SCF_EXPECT_ARRAY_END,
+                      "was expecting a value or end of array ']' but found: "
+                      "'%.*s'",
+                      (Sint32)token.val_len, token.val_start);
+    }
+
+    bool numbers = (item == XYZ_SCF_VALUE_TYPE_I32_ARRAY ||
+                    item == XYZ_SCF_VALUE_TYPE_F32_ARRAY) &&
+                   (*type == XYZ_SCF_VALUE_TYPE_I32_ARRAY ||
+                    *type == XYZ_SCF_VALUE_TYPE_F32_ARRAY);
+    if (!numbers && *type != XYZ_SCF_VALUE_TYPE_NIL && item != *type) {
+      return error_at(&parser->error, &token, 0,
+                      "array elements must all be of one type but found: "
+                      "'%.*s'",
+                      (Sint32)token.val_len, token.val_start);
+    }
+    *type = SDL_max(*type, item);  // F32 comes after I32
+
+    if (item == XYZ_SCF_VALUE_TYPE_STRING_ARRAY) {
+      *string_bytes += token.val_len - 1;  // unquoted and null terminated
+    }
+    (*count)++;
+    XYZ_SCFNextToken(&token);  // errors are reported by the next round
+  }
+
+  // "[]" has no element type, any of the getters read it
+  if (*type == XYZ_SCF_VALUE_TYPE_NIL) {
+    *type = XYZ_SCF_VALUE_TYPE_I32_ARRAY;
+  }
+  return true;
+}
+
+bool parse_array_item(const XYZ_SCFToken* token,
+                      XYZ_SCFValueType type,
+                      XYZ_SCFValue* item) {
+  switch (type) {
+    case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+      item->type = XYZ_SCF_VALUE_TYPE_BOOL;
+      item->as_bool = *token->val_start == 't';
+      return true;
+    case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+      item->type = XYZ_SCF_VALUE_TYPE_I32;
+      return XYZ_SCFParseI32(token->val_start, token->val_len, &item->as_i32);
+    case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+      item->type = XYZ_SCF_VALUE_TYPE_F32;
+      return XYZ_SCFParseF32(token->val_start, token->val_len, &item->as_f32);
+    default:
+      item->type = XYZ_SCF_VALUE_TYPE_STRING;
+      item->as_string = (char*)token->val_start + 1;  // unquote
+      item->str_len = (Uint32)(token->val_len - 2);
+      return true;
+  }
+}
+
+XYZ_SCFValueType parse_array_type(const XYZ_SCFToken* token) {
+  switch (token->type) {
+    case XYZ_SCF_TOKEN_TYPE_INTEGER:
+      return XYZ_SCF_VALUE_TYPE_I32_ARRAY;
+    case XYZ_SCF_TOKEN_TYPE_FLOAT:
+      return XYZ_SCF_VALUE_TYPE_F32_ARRAY;
+    case XYZ_SCF_TOKEN_TYPE_STRING:
+      return XYZ_SCF_VALUE_TYPE_STRING_ARRAY;
+    case XYZ_SCF_TOKEN_TYPE_WORD:
+      if ((token->val_len == 4 &&
+           SDL_strncmp(token->val_start, "true", 4) == 0) ||
+          (token->val_len == 5 &&
+           SDL_strncmp(token->val_start, "false", 5) == 0)) {
+        return XYZ_SCF_VALUE_TYPE_BOOL_ARRAY;
+      }
+      return XYZ_SCF_VALUE_TYPE_NIL;
+    default:
+      return XYZ_SCF_VALUE_TYPE_NIL;
+  }
+}
+
+void XYZ_SCFPushParserInit(XYZ_SCFPushParser* parser,
+                           XYZ_SCFTable* table,
+                           XYZ_SCFArena* arena) {
+  SDL_assert(parser != NULL &&
+             "XYZ_SCFPushParserInit: parser cannot be NULL");
+  SDL_assert(table != NULL && "XYZ_SCFPushParserInit: table cannot be NULL");
+  *parser = (XYZ_SCFPushParser){
+      .root = table,
+      .arena = arena,
+      .state = push_state_key,
+  };
+}
+
+bool XYZ_SCFPushParserFeed(XYZ_SCFPushParser* parser,
+                           const char* data,
+                           size_t len) {
+  SDL_assert(parser != NULL &&
+             "XYZ_SCFPushParserFeed: parser cannot be NULL");
+  SDL_assert((data != NULL || len == 0) &&
+             "XYZ_SCFPushParserFeed: data cannot be NULL");
+  if (parser->failed) {
+    SDL_SetError("parser cannot resume after an error");
     return false;
   }
 
+  while (len > 0) {
+    size_t used = 0;
+    if (parser->carry_len == 0) {
+      if (!push_lex(parser, data, len, &used)) {
+        parser->failed = true;
+        return false;
+      }
+      data += used;
+      len -= used;
+
+      // keep the cut token for the next chunk
+      if (!push_reserve((void**)&parser->carry, &parser->carry_cap, len, 1)) {
+        parser->failed = true;
+        return false;
+      }
+      if (len > 0) {
+        SDL_memcpy(parser->carry, data, len);
+      }
+      parser->carry_len = len;
+      return true;
+    }
+
+    size_t take = 0;
+    bool ended = push_token_end(parser, data, len, &take);
+    if (!push_reserve((void**)&parser->carry, &parser->carry_cap,
+                      parser->carry_len + take, 1)) {
+      parser->failed = true;
+      return false;
+    }
+    SDL_memcpy(parser->carry + parser->carry_len, data, take);
+    parser->carry_len += take;
+    data += take;
+    len -= take;
+    if (!ended) {
+      return true;
+    }
+
+    if (!push_lex(parser, parser->carry, parser->carry_len, &used)) {
+      parser->failed = true;
+      return false;
+    }
+    SDL_memmove(parser->carry, parser->carry + used,
+                parser->carry_len - used);
+    parser->carry_len -= used;
+  }
+
   return true;
 }
+
+bool XYZ_SCFPushParserFinish(XYZ_SCFPushParser* parser) {
+  SDL_assert(parser != NULL &&
+             "XYZ_SCFPushParserFinish: parser cannot be NULL");
+  if (parser->failed) {
+    SDL_SetError("parser cannot resume after an error");
+    return false;
+  }
+
+  // nothing follows, whatever is left in carry ends at the end of input
+  if (parser->carry_len > 0) {
+    XYZ_SCFToken token = {0};
+    XYZ_SCFStartToken(&token, parser->carry, parser->carry_len);
+    while (true) {
+      if (!XYZ_SCFNextToken(&token)) {
+        parser->failed = true;
+        return false;
+      }
+
+      if (token.type == XYZ_SCF_TOKEN_TYPE_EOF) {
+        break;
+      }
+
+      if (!push_token(parser, &token)) {
+        parser->failed = true;
+        return false;
+      }
+    }
+    parser->carry_len = 0;
+  }
+
+  if (parser->state != push_state_key) {
+    SDL_SetError("unexpected end of input in entry: '%.*s'",
+                 (Sint32)parser->key_len, parser->key);
+    parser->failed = true;
+    return false;
+  }
+
+  if (parser->depth > 0) {
+    SDL_SetError("was expecting end of block '}' but found end of input");
+    parser->failed = true;
+    return false;
+  }
+
+  return true;
+}
+
+void XYZ_SCFPushParserDestroy(XYZ_SCFPushParser* parser) {
+  SDL_assert(parser != NULL &&
+             "XYZ_SCFPushParserDestroy: parser cannot be NULL");
+  SDL_free(parser->stack);
+  SDL_free(parser->carry);
+  SDL_free(parser->key);
+  SDL_free(parser->array);
+  SDL_memset(parser, 0, sizeof(XYZ_SCFPushParser));
+}
+
+bool push_reserve(void** buf, size_t* cap, size_t len, size_t size) {
+  if (len <= *cap) {
+    return true;
+  }
+
+  size_t new_cap = SDL_max(*cap * 2, SDL_max(len, 64));
+  void* new_buf = SDL_realloc(*buf, new_cap * size);
+  if (new_buf == NULL) {
+    return false;
+  }
+  *buf = new_buf;
+  *cap = new_cap;
+  return true;
+}
+
+bool push_lex(XYZ_SCFPushParser* parser,
+              const char* data,
+              size_t len,
+              size_t* used) {
+  XYZ_SCFToken token = {0};
+  XYZ_SCFStartToken(&token, data, len);
+  while (true) {
+    bool partial = false;
+    if (!XYZ_SCFNextTokenPartial(&token, &partial)) {
+      return false;
+    }
+
+    if (partial) {
+      *used = token.val_start - data;
+      return true;
+    }
+
+    if (token.type == XYZ_SCF_TOKEN_TYPE_EOF) {
+      // the whole chunk was blank, anything else is a NUL byte
+      if (token.val_start < data + len) {
+        SDL_SetError("unexpected end of input");
+        return false;
+      }
+      *used = len;
+      return true;
+    }
+
+    if (!push_token(parser, &token)) {
+      return false;
+    }
+  }
+}
+
+bool push_token(XYZ_SCFPushParser* parser, const XYZ_SCFToken* token) {
+  XYZ_SCFTable* table =
+      parser->depth > 0 ? parser->stack[parser->depth - 1] : parser->root;
+  bool punct = token->type == XYZ_SCF_TOKEN_TYPE_PUNCT;
+
+  switch (parser->state) {
+    case push_state_key:
+      if (token->type == XYZ_SCF_TOKEN_TYPE_WORD) {
+        if (!push_reserve((void**)&parser->key, &parser->key_cap,
+                          token->val_len, 1)) {
+          return false;
+        }
+        SDL_memcpy(parser->key, token->val_start, token->val_len);
+        parser->key_len = token->val_len;
+        parser->state = push_state_assign;
+        return true;
+      }
+
+      if (punct && *token->val_start == '}' && parser->depth > 0) {
+        parser->depth--;
+        return true;
+      }
+
+      SDL_SetError("was expecting identifier but found: '%.*s'",
+                   (Sint32)token->val_len, token->val_start);
+      return false;
+
+    case push_state_assign:
+      if (punct && *token->val_start == '=') {
+        parser->state = push_state_value;
+        return true;
+      }
+
+      if (punct && *token->val_start == '{') {
+        XYZ_SCFValue value = {0};
+        value.type = XYZ_SCF_VALUE_TYPE_TABLE;
+        value.as_table = XYZ_SCFTableCreateWithArena(parser->arena);
+        if (value.as_table == NULL) {
+          return false;
+        }
+
+        if (XYZ_SCFTableAppend(table, parser->key, parser->key_len, value,
+                               0) == NULL) {
+          if (parser->arena == NULL) {
+            SDL_free(value.as_table);
+          }
+          return false;
+        }
+
+        if (!push_reserve((void**)&parser->stack, &parser->stack_cap,
+                          parser->depth + 1, sizeof(XYZ_SCFTable*))) {
+          return false;
+        }
+
+        parser->stack[parser->depth++] = value.as_table;
+        parser->state = push_state_key;
+        return true;
+      }
+
+      SDL_SetError("was expecting assign '=' or block '{' but found: '%.*s'",
+                   (Sint32)token->val_len, token->val_start);
+      return false;
+
+    case push_state_value:
+      if (punct && *token->val_start == '[') {
+        parser->array_len = 0;
+        parser->state = push_state_array;
+        break;  // kept with the elements
+      }
+
+      // the token is complete, parse it as the only token of its own input
+      return push_value(parser, table, token, token->val_len);
+
+    case push_state_array:
+      break;
+
+    default:
+      SDL_SetError("invalid parser state: %d", parser->state);
+      return false;
+  }
+
+  // the elements of an array may come in different chunks, they are copied
+  // until the ']' or anything that cannot be an element
+  bool first = parser->array_len == 0;
+  size_t len = parser->array_len + token->val_len + 1;
+  if (!push_reserve((void**)&parser->array, &parser->array_cap, len, 1)) {
+    return false;
+  }
+  SDL_memcpy(parser->array + parser->array_len, token->val_start,
+             token->val_len);
+  parser->array[len - 1] = ' ';
+  parser->array_len = len;
+
+  if (first || parse_array_type(token) != XYZ_SCF_VALUE_TYPE_NIL) {
+    return true;
+  }
+
+  XYZ_SCFToken array = {0};
+  XYZ_SCFStartToken(&array, parser->array, parser->array_len);
+  XYZ_SCFNextToken(&array);
+  return push_value(parser, table, &array, parser->array_len);
+}
+
+bool push_value(XYZ_SCFPushParser* parser,
+                XYZ_SCFTable* table,
+                const XYZ_SCFToken* token,
+                size_t len) {
+  XYZ_SCFParser value_parser = {0};
+  value_parser.arena = parser->arena;
+  value_parser.cur = *token;
+  value_parser.cur.buf_start = token->val_start;
+  value_parser.cur.buf_len = len;
+  value_parser.cur.line = 0;  // chunks do not know where they are
+
+  XYZ_SCFValue value = {0};
+  if (!parse_value(&value_parser, &value)) {
+    return false;
+  }
+
+  if (XYZ_SCFTableAppend(table, parser->key, parser->key_len, value, 0) ==
+      NULL) {
+    // the pair that would have owned the string or array is never made
+    bool owned = XYZ_SCFIsArrayType(value.type) ||
+                 value.type == XYZ_SCF_VALUE_TYPE_STRING;
+    if (owned && parser->arena == NULL) {
+      SDL_free(value.as_array);
+    }
+    return false;
+  }
+
+  parser->state = push_state_key;
+  return true;
+}
+
+bool push_token_end(XYZ_SCFPushParser* parser,
+                    const char* data,
+                    size_t len,
+                    size_t* take) {
+  // strings end at a quote (or fail at a new line or NUL), anything else at
+  // the first ASCII byte that cannot continue a word or number; that byte is
+  // taken too so the lexer sees the token ended
+  bool string = parser->carry[0] == '"';
+  for (size_t i = 0; i < len; i++) {
+    char c = data[i];
+    bool ends = string ? c == '"' || c == '\n' || c == '\0'
+                       : (Uint8)c < 0x80 && !SDL_isalnum(c) && c != '_' &&
+                             c != '.' && c != '-' && c != '+';
+    if (ends) {
+      *take = i + 1;
+      return true;
+    }
+  }
+
+  *take = len;
+  return false;
+}
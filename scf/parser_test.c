@@ -8,6 +8,9 @@
 
 #include <scf/parser.h>
 #include "scf/table.h"
+#include "test.h"
+
+#include <SDL3/SDL_error.h>
 
 static void parse_single_entry(void** state) {
   (void)state;
@@ -80,11 +83,436 @@ static void parse_subtables(void** state) {
   SDL_free(table);
 }
 
+static void parse_zero_copy(void** state) {
+  (void)state;
+
+  XYZ_SCFParser parser = {.flags = XYZ_SCF_PARSE_ZERO_COPY};
+  const char* src = "title = \"hello world\" sub { name = \"\" }";
+  size_t src_len = SDL_strlen(src);
+  XYZ_SCFParserSetFile(&parser, src, src_len);
+
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  assert_true(XYZ_SCFParseTable(&parser, table));
+
+  // keys and strings point straight into src
+  assert_ptr_equal(table->pairs[0].key, src);
+  assert_int_equal(table->pairs[0].key_len, 5);
+
+  const char* view = NULL;
+  size_t view_len = 0;
+  assert_true(XYZ_SCFTableGetStringView(table, "title", &view, &view_len));
+  assert_ptr_equal(view, src + 9);
+  assert_int_equal(view_len, 11);
+
+  // views are not null terminated
+  char* string = NULL;
+  assert_false(XYZ_SCFTableGetString(table, "title", &string));
+
+  XYZ_SCFTable* sub = NULL;
+  assert_true(XYZ_SCFTableGetTable(table, "sub", &sub));
+  assert_true(XYZ_SCFTableGetStringView(sub, "name", &view, &view_len));
+  assert_int_equal(view_len, 0);
+
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+}
+
+static void parse_lazy(void** state) {
+  (void)state;
+
+  const char* src =
+      "name = \"hero\"\n"
+      "video {\n  title = \"{ not a block\"\n  display { vsync = true }\n}\n"
+      "sizes = [1 2] audio {} last = 1";
+  XYZ_SCFParser setup = {.flags = XYZ_SCF_PARSE_LAZY};
+  XYZ_SCFTable* eager = test_parse_with(NULL, src, SDL_strlen(src));
+  XYZ_SCFTable* lazy = test_parse_with(&setup, src, SDL_strlen(src));
+  assert_non_null(eager);
+  assert_non_null(lazy);
+  assert_int_equal(XYZ_SCFTableCount(lazy), 5);
+
+  // blocks are parsed one level at a time, as they are looked into
+  XYZ_SCFValue value = {0};
+  assert_true(XYZ_SCFTableGet(lazy, "video", &value));
+  assert_non_null(value.as_table->lazy);
+
+  XYZ_SCFTable* video = NULL;
+  XYZ_SCFTable* display = NULL;
+  assert_true(XYZ_SCFTableGetTable(lazy, "video", &video));
+  assert_null(video->lazy);
+  assert_true(XYZ_SCFTableGet(video, "display", &value));
+  assert_non_null(value.as_table->lazy);
+
+  char* title = NULL;
+  bool vsync = false;
+  assert_true(XYZ_SCFTableGetString(video, "title", &title));
+  assert_string_equal(title, "{ not a block");
+  assert_true(XYZ_SCFTableGetTable(video, "display", &display));
+  assert_true(XYZ_SCFTableGetBool(display, "vsync", &vsync));
+  assert_true(vsync);
+
+  // cursors and comparisons parse what they walk
+  assert_true(XYZ_SCFTableEqual(lazy, eager));
+  XYZ_SCFTableDestroy(lazy);
+  SDL_free(lazy);
+
+  lazy = test_parse_with(&setup, src, SDL_strlen(src));
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(lazy);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    if (cursor.pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+      assert_non_null(cursor.pair->value.as_table->lazy);
+      XYZ_SCFCursor inner = XYZ_SCFTableCursor(cursor.pair->value.as_table);
+      assert_null(inner.table->lazy);
+    }
+  }
+  assert_true(XYZ_SCFTableEqual(eager, lazy));
+
+  XYZ_SCFTableDestroy(eager);
+  SDL_free(eager);
+  XYZ_SCFTableDestroy(lazy);
+  SDL_free(lazy);
+}
+
+static void parse_lazy_errors(void** state) {
+  (void)state;
+
+  // errors inside a block come up when it is parsed, where eager parsing
+  // would have stopped
+  const char* src = "a = 1\nvideo {\n  width = }\nb = 2";
+  XYZ_SCFParser parser = {0};
+  XYZ_SCFParserSetFile(&parser, src, SDL_strlen(src));
+  XYZ_SCFTable* eager = XYZ_SCFTableCreate();
+  assert_false(XYZ_SCFParseTable(&parser, eager));
+  char expected[XYZ_SCF_ERROR_MAX + 32];
+  SDL_strlcpy(expected, SDL_GetError(), sizeof(expected));
+  XYZ_SCFTableDestroy(eager);
+  SDL_free(eager);
+
+  parser.flags = XYZ_SCF_PARSE_LAZY;
+  XYZ_SCFTable* lazy = test_parse_with(&parser, src, SDL_strlen(src));
+  assert_non_null(lazy);
+  XYZ_SCFTable* video = NULL;
+  assert_false(XYZ_SCFTableGetTable(lazy, "video", &video));
+  assert_string_equal(SDL_GetError(), expected);
+  assert_string_equal(SDL_GetError(),
+                      "line 3, column 11: was expecting a value but found "
+                      "'}'");
+
+  // the failed block keeps failing instead of looking empty, the rest of the
+  // table is there
+  XYZ_SCFValue value = {0};
+  Sint32 b = 0;
+  assert_true(XYZ_SCFTableGet(lazy, "video", &value));
+  assert_int_equal(XYZ_SCFTableCount(value.as_table), 0);
+  assert_non_null(value.as_table->lazy);
+  SDL_SetError("none");
+  assert_false(XYZ_SCFTableGetI32(value.as_table, "width", &b));
+  assert_string_equal(SDL_GetError(), expected);
+  XYZ_SCFKey key = {0};
+  assert_false(XYZ_SCFTableResolve(value.as_table, "width", &key));
+  assert_string_equal(SDL_GetError(), expected);
+  assert_false(XYZ_SCFTableGetTable(lazy, "video", &video));
+  assert_string_equal(SDL_GetError(), expected);
+  assert_true(XYZ_SCFTableGetI32(lazy, "b", &b));
+  assert_int_equal(b, 2);
+  XYZ_SCFTableDestroy(lazy);
+  SDL_free(lazy);
+
+  // anything the brace matching sees fails right away, like eager parsing
+  const struct {
+    const char* src;
+    size_t len;
+  } bad[] = {
+      {"a { b = 1", 9},
+      {"a { b = 1 }@", 12},
+      {"a { b = \"x\0\" }", 14},
+      {"a { b = 1 }}", 12},
+  };
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    size_t len = bad[i].len;
+    XYZ_SCFParser expected_parser = {0};
+    XYZ_SCFParserSetFile(&expected_parser, bad[i].src, len);
+    eager = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTable(&expected_parser, eager));
+    XYZ_SCFTableDestroy(eager);
+    SDL_free(eager);
+
+    parser = (XYZ_SCFParser){.flags = XYZ_SCF_PARSE_LAZY};
+    XYZ_SCFParserSetFile(&parser, bad[i].src, len);
+    lazy = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTable(&parser, lazy));
+    assert_string_equal(parser.error.message, expected_parser.error.message);
+    assert_int_equal(parser.error.offset, expected_parser.error.offset);
+    assert_int_equal(parser.error.line, expected_parser.error.line);
+    assert_int_equal(parser.error.col, expected_parser.error.col);
+    XYZ_SCFTableDestroy(lazy);
+    SDL_free(lazy);
+  }
+}
+
+static void parse_numbers(void** state) {
+  (void)state;
+
+  XYZ_SCFParser parser = {0};
+  const char* src = "min = -2147483648 far = 1.5e3 near = -25E-4";
+  XYZ_SCFParserSetFile(&parser, src, SDL_strlen(src));
+
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  assert_true(XYZ_SCFParseTable(&parser, table));
+
+  Sint32 min = 0;
+  float far = 0.0f;
+  float near = 0.0f;
+  assert_true(XYZ_SCFTableGetI32(table, "min", &min));
+  assert_int_equal(min, SDL_MIN_SINT32);
+  assert_true(XYZ_SCFTableGetF32(table, "far", &far));
+  assert_float_equal(far, 1500.0f, 0.0f);
+  assert_true(XYZ_SCFTableGetF32(table, "near", &near));
+  assert_float_equal(near, -0.0025f, 0.0f);
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+
+  // numbers that do not fit are errors instead of wrapping around
+  const char* bad[] = {"big = 2147483648", "huge = 1e39", "cut = 1e"};
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    XYZ_SCFParserSetFile(&parser, bad[i], SDL_strlen(bad[i]));
+    table = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTable(&parser, table));
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+  }
+}
+
+static void parse_arrays(void** state) {
+  (void)state;
+
+  const char* src =
+      "sizes = [1 2 -3] scales = [1 0.5 2] flags = [true false true]\n"
+      "names = [\"low\" \"\" \"high\"] empty = [] nested { ids = [7] }";
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  for (Sint32 round = 0; round < 2; round++) {
+    // zero copy and from an arena, string elements are still copied
+    XYZ_SCFParser parser = {0};
+    XYZ_SCFParserSetFile(&parser, src, SDL_strlen(src));
+    parser.flags = round == 0 ? 0 : XYZ_SCF_PARSE_ZERO_COPY;
+    parser.arena = round == 0 ? NULL : &arena;
+    XYZ_SCFTable* table = round == 0 ? XYZ_SCFTableCreate()
+                                     : XYZ_SCFTableCreateWithArena(&arena);
+    assert_true(XYZ_SCFParseTable(&parser, table));
+
+    const Sint32* i32s = NULL;
+    size_t count = 0;
+    assert_true(XYZ_SCFTableGetI32Array(table, "sizes", &i32s, &count));
+    assert_int_equal(count, 3);
+    assert_int_equal(i32s[0], 1);
+    assert_int_equal(i32s[2], -3);
+
+    // integers among floats are floats
+    const float* f32s = NULL;
+    assert_true(XYZ_SCFTableGetF32Array(table, "scales", &f32s, &count));
+    assert_int_equal(count, 3);
+    assert_float_equal(f32s[0], 1.0f, 0.0f);
+    assert_float_equal(f32s[1], 0.5f, 0.0f);
+    assert_false(XYZ_SCFTableGetI32Array(table, "scales", &i32s, &count));
+
+    const bool* bools = NULL;
+    assert_true(XYZ_SCFTableGetBoolArray(table, "flags", &bools, &count));
+    assert_int_equal(count, 3);
+    assert_true(bools[0] && !bools[1] && bools[2]);
+
+    const char* const* names = NULL;
+    assert_true(XYZ_SCFTableGetStringArray(table, "names", &names, &count));
+    assert_int_equal(count, 3);
+    assert_string_equal(names[0], "low");
+    assert_string_equal(names[1], "");
+    assert_string_equal(names[2], "high");
+
+    // empty arrays have no elements of any type
+    assert_true(XYZ_SCFTableGetF32Array(table, "empty", &f32s, &count));
+    assert_int_equal(count, 0);
+    assert_null(f32s);
+    assert_true(XYZ_SCFTableGetStringArray(table, "empty", &names, &count));
+
+    XYZ_SCFTable* nested = NULL;
+    assert_true(XYZ_SCFTableGetTable(table, "nested", &nested));
+    assert_true(XYZ_SCFTableGetI32Array(nested, "ids", &i32s, &count));
+    assert_int_equal(count, 1);
+    assert_int_equal(i32s[0], 7);
+
+    if (round == 0) {
+      XYZ_SCFTableDestroy(table);
+      SDL_free(table);
+    }
+  }
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+static const char* push_src =
+    "name = \"h\xc3\xa9ro \xe2\x9c\x93\" lives = 3 floor = -12 "
+    "speed = 12.75 god = false none = nil\n"
+    "video {\n  width = 1280\n  display { index = 2 title = \"\" }\n}\n"
+    "audio {} tail = true sizes = [1 2.5 -3] tags = [\"a\" \"b c\"] "
+    "flags = [true false] empty = []";
+
+static bool push_all(XYZ_SCFTable* table,
+                     const char* src,
+                     size_t len,
+                     size_t chunk_len) {
+  XYZ_SCFPushParser parser = {0};
+  XYZ_SCFPushParserInit(&parser, table, NULL);
+  bool parsed = true;
+  for (size_t at = 0; parsed && at < len; at += chunk_len) {
+    // copy each chunk so nothing can point back into previous ones
+    size_t cur_len = SDL_min(chunk_len, len - at);
+    char* chunk = SDL_malloc(cur_len);
+    SDL_memcpy(chunk, src + at, cur_len);
+    parsed = XYZ_SCFPushParserFeed(&parser, chunk, cur_len);
+    SDL_free(chunk);
+  }
+
+  parsed = parsed && XYZ_SCFPushParserFinish(&parser);
+  XYZ_SCFPushParserDestroy(&parser);
+  return parsed;
+}
+
+static void parse_push_chunks(void** state) {
+  (void)state;
+
+  size_t len = SDL_strlen(push_src);
+  XYZ_SCFParser parser = {0};
+  XYZ_SCFParserSetFile(&parser, push_src, len);
+  XYZ_SCFTable* expected = XYZ_SCFTableCreate();
+  assert_true(XYZ_SCFParseTable(&parser, expected));
+
+  // every chunk size, from one byte at a time (splitting every token and
+  // UTF-8 sequence) to the whole input at once
+  for (size_t chunk_len = 1; chunk_len <= len; chunk_len++) {
+    XYZ_SCFTable* table = XYZ_SCFTableCreate();
+    assert_true(push_all(table, push_src, len, chunk_len));
+    assert_true(XYZ_SCFTableEqual(expected, table));
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+  }
+
+  const char* name = NULL;
+  size_t name_len = 0;
+  assert_true(XYZ_SCFTableGetStringView(expected, "name", &name, &name_len));
+  assert_int_equal(name_len, 9);
+
+  XYZ_SCFTableDestroy(expected);
+  SDL_free(expected);
+}
+
+static void parse_push_errors(void** state) {
+  (void)state;
+
+  const char* bad[] = {
+      "key = \"never ends", "video { width = 1", "key =",    "key",
+      "key = 1 }",          "key = {",           "= 1",      "a = 1 b 2",
+      "key = \"new\nline\"",
+      "key = [1 2",         "key = [1 { }]",     "key = [1 \"a\"]",
+  };
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    for (size_t chunk_len = 1; chunk_len <= SDL_strlen(bad[i]); chunk_len++) {
+      XYZ_SCFTable* table = XYZ_SCFTableCreate();
+      assert_false(push_all(table, bad[i], SDL_strlen(bad[i]), chunk_len));
+      XYZ_SCFTableDestroy(table);
+      SDL_free(table);
+    }
+  }
+
+  // nothing is accepted after an error
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  XYZ_SCFPushParser parser = {0};
+  XYZ_SCFPushParserInit(&parser, table, NULL);
+  assert_false(XYZ_SCFPushParserFeed(&parser, "= ", 2));
+  assert_false(XYZ_SCFPushParserFeed(&parser, "a = 1 ", 6));
+  assert_false(XYZ_SCFPushParserFinish(&parser));
+  XYZ_SCFPushParserDestroy(&parser);
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+}
+
+static void parse_errors(void** state) {
+  (void)state;
+
+  const struct {
+    const char* src;
+    size_t offset;
+    Uint32 line;
+    Uint32 col;
+    Uint32 expected;
+    const char* message;
+  } cases[] = {
+      {"a = 1\nvideo {\n  width = }", 24, 3, 11, XYZ_SCF_EXPECT_VALUE,
+       "line 3, column 11: was expecting a value but found '}'"},
+      {"a = 1 b 2", 8, 1, 9, XYZ_SCF_EXPECT_ASSIGN | XYZ_SCF_EXPECT_BLOCK,
+       "line 1, column 9: was expecting assign '=' or block '{' but found: "
+       "'2'"},
+      {"a = 1\n}", 6, 2, 1, XYZ_SCF_EXPECT_KEY | XYZ_SCF_EXPECT_EOF,
+       "line 2, column 1: was expecting identifier but found: '}'"},
+      {"a { b = 1", 9, 1, 10, XYZ_SCF_EXPECT_KEY | XYZ_SCF_EXPECT_BLOCK_END,
+       "line 1, column 10: was expecting identifier but found: ''"},
+      {"a = 1\n\tb = @", 11, 2, 6, 0,
+       "line 2, column 6: unknown character: '@'"},
+      {"a = \"open", 4, 1, 5, 0,
+       "line 1, column 5: unterminated string"},
+      {"a = [1 2 true]", 9, 1, 10, 0,
+       "line 1, column 10: array elements must all be of one type but "
+       "found: 'true'"},
+      {"a = [1\n2", 8, 2, 2, XYZ_SCF_EXPECT_VALUE | XYZ_SCF_EXPECT_ARRAY_END,
+       "line 2, column 2: was expecting a value or end of array ']' but "
+       "found: ''"},
+      {"a = [1 99999999999]", 7, 1, 8, 0,
+       "line 1, column 8: integer out of range: '99999999999'"},
+      {"a = [1]@", 7, 1, 8, 0, "line 1, column 8: unknown character: '@'"},
+  };
+  for (size_t i = 0; i < SDL_arraysize(cases); i++) {
+    XYZ_SCFParser parser = {0};
+    XYZ_SCFParserSetFile(&parser, cases[i].src, SDL_strlen(cases[i].src));
+    XYZ_SCFTable* table = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTable(&parser, table));
+    assert_string_equal(SDL_GetError(), cases[i].message);
+    assert_int_equal(parser.error.offset, cases[i].offset);
+    assert_int_equal(parser.error.line, cases[i].line);
+    assert_int_equal(parser.error.col, cases[i].col);
+    assert_int_equal(parser.error.expected, cases[i].expected);
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+  }
+
+  // the line index agrees with what the lexer counted
+  const char* src = cases[0].src;
+  XYZ_SCFLineIndex index = {0};
+  XYZ_SCFLineIndexInit(&index, src, SDL_strlen(src));
+  Uint32 line = 0;
+  Uint32 col = 0;
+  assert_true(XYZ_SCFLineIndexFind(&index, 24, &line, &col));
+  assert_int_equal(line, 3);
+  assert_int_equal(col, 11);
+  assert_true(XYZ_SCFLineIndexFind(&index, 0, &line, &col));
+  assert_int_equal(line, 1);
+  assert_int_equal(col, 1);
+  assert_true(XYZ_SCFLineIndexFind(&index, 5, &line, &col));
+  assert_int_equal(line, 1);
+  assert_int_equal(col, 6);
+  XYZ_SCFLineIndexDestroy(&index);
+}
+
 int main(void) {
   const struct CMUnitTest tests[] = {
       cmocka_unit_test(parse_single_entry),
       cmocka_unit_test(parse_multiple_entries),
       cmocka_unit_test(parse_subtables),
+      cmocka_unit_test(parse_zero_copy),
+      cmocka_unit_test(parse_lazy),
+      cmocka_unit_test(parse_lazy_errors),
+      cmocka_unit_test(parse_numbers),
+      cmocka_unit_test(parse_arrays),
+      cmocka_unit_test(parse_push_chunks),
+      cmocka_unit_test(parse_push_errors),
+      cmocka_unit_test(parse_errors),
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,252 @@
+#include "scf/path.h"
+#include "scf/table.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+// shared with table.c, handle to a pair of table
+XYZ_SCFKey table_key(XYZ_SCFTable* table, const XYZ_SCFPair* pair);
+// find the pair of a segment in table, by atom if the segment has one
+XYZ_SCFPair* path_find(XYZ_SCFTable* table,
+                       const XYZ_SCFPathSegment* segment);
+// flags for pairs created for a segment
+Uint32 path_flags(const XYZ_SCFPathSegment* segment);
+// find the table holding the last segment, creating missing ones if create
+XYZ_SCFTable* path_parent(XYZ_SCFTable* table,
+                          const XYZ_SCFPath* path,
+                          bool create);
+
+bool XYZ_SCFPathCompile(XYZ_SCFPath* path, const char* str) {
+  SDL_assert(path != NULL && "XYZ_SCFPathCompile: path cannot be NULL");
+  SDL_assert(str != NULL && "XYZ_SCFPathCompile: str cannot be NULL");
+
+  path->count = 0;
+  const char* cur = str;
+  while (true) {
+    const char* start = cur;
+    while (*cur != '\0' && *cur != '.') {
+      cur++;
+    }
+
+    if (cur == start) {
+      SDL_SetError("empty segment in path: %s", str);
+      return false;
+    }
+
+    if (path->count == XYZ_SCF_PATH_MAX_SEGMENTS) {
+      SDL_SetError("too many segments in path: %s", str);
+      return false;
+    }
+
+    XYZ_SCFPathSegment* segment = &path->segments[path->count++];
+    segment->key = start;
+    segment->key_len = (Uint32)(cur - start);
+    segment->hash = XYZ_SCFHashKey(start, segment->key_len);
+    segment->atom = XYZ_SCF_NO_ATOM;
+    if (*cur == '\0') {
+      return true;
+    }
+    cur++;  // skip the dot
+  }
+}
+
+bool XYZ_SCFPathIntern(XYZ_SCFPath* path) {
+  SDL_assert(path != NULL && "XYZ_SCFPathIntern: path cannot be NULL");
+  for (Uint32 i = 0; i < path->count; i++) {
+    XYZ_SCFPathSegment* segment = &path->segments[i];
+    XYZ_SCFAtom atom =
+        XYZ_SCFAtomIntern(segment->key, segment->key_len, segment->hash);
+    if (atom == XYZ_SCF_NO_ATOM) {
+      return false;
+    }
+    segment->atom = atom;
+  }
+  return true;
+}
+
+bool XYZ_SCFPathResolve(XYZ_SCFTable* table,
+                        const XYZ_SCFPath* path,
+                        XYZ_SCFKey* handle) {
+  SDL_assert(table != NULL && "XYZ_SCFPathResolve: table cannot be NULL");
+  SDL_assert(path != NULL && "XYZ_SCFPathResolve: path cannot be NULL");
+  SDL_assert(handle != NULL && "XYZ_SCFPathResolve: handle cannot be NULL");
+
+  XYZ_SCFTable* parent = path_parent(table, path, false);
+  if (parent == NULL) {
+    return false;
+  }
+
+  const XYZ_SCFPathSegment* last = &path->segments[path->count - 1];
+  XYZ_SCFPair* pair = path_find(parent, last);
+  if (pair == NULL) {
+    // a lazy block that failed to parse keeps its parse error
+    if (parent->lazy == NULL) {
+      SDL_SetError("key not found: %.*s", (Sint32)last->key_len, last->key);
+    }
+    return false;
+  }
+
+  *handle = table_key(parent, pair);
+  return true;
+}
+
+bool XYZ_SCFPathGet(XYZ_SCFTable* table,
+                    const XYZ_SCFPath* path,
+                    XYZ_SCFValue* value) {
+  SDL_assert(value != NULL && "XYZ_SCFPathGet: value cannot be NULL");
+  XYZ_SCFKey key = {0};
+  if (!XYZ_SCFPathResolve(table, path, &key)) {
+    return false;
+  }
+
+  *value = *XYZ_SCFKeyValue(key);
+  return true;
+}
+
+bool XYZ_SCFPathSet(XYZ_SCFTable* table,
+                    const XYZ_SCFPath* path,
+                    XYZ_SCFValue value) {
+  SDL_assert(table != NULL && "XYZ_SCFPathSet: table cannot be NULL");
+  SDL_assert(path != NULL && "XYZ_SCFPathSet: path cannot be NULL");
+
+  XYZ_SCFTable* parent = path_parent(table, path, true);
+  if (parent == NULL) {
+    return false;
+  }
+
+  const XYZ_SCFPathSegment* last = &path->segments[path->count - 1];
+  XYZ_SCFPair* pair = path_find(parent, last);
+  if (pair != NULL) {
+    XYZ_SCFKeySet(table_key(parent, pair), value);
+    return true;
+  }
+
+  return XYZ_SCFTableAppend(parent, last->key, last->key_len, value,
+                            path_flags(last)) != NULL;
+}
+
+bool XYZ_SCFTableResolvePath(XYZ_SCFTable* table,
+                             const char* path,
+                             XYZ_SCFKey* handle) {
+  XYZ_SCFPath compiled = {0};
+  return XYZ_SCFPathCompile(&compiled, path) &&
+         XYZ_SCFPathResolve(table, &compiled, handle);
+}
+
+bool XYZ_SCFTableGetPath(XYZ_SCFTable* table,
+                         const char* path,
+                         XYZ_SCFValue* value) {
+  XYZ_SCFPath compiled = {0};
+  return XYZ_SCFPathCompile(&compiled, path) &&
+         XYZ_SCFPathGet(table, &compiled, value);
+}
+
+bool XYZ_SCFTableGetPathBool(XYZ_SCFTable* table,
+                             const char* path,
+                             bool* value) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFTableResolvePath(table, path, &key) &&
+         XYZ_SCFKeyGetBool(key, value);
+}
+
+bool XYZ_SCFTableGetPathI32(XYZ_SCFTable* table,
+                            const char* path,
+                            Sint32* value) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFTableResolvePath(table, path, &key) &&
+         XYZ_SCFKeyGetI32(key, value);
+}
+
+bool XYZ_SCFTableGetPathF32(XYZ_SCFTable* table,
+                            const char* path,
+                            float* value) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFTableResolvePath(table, path, &key) &&
+         XYZ_SCFKeyGetF32(key, value);
+}
+
+bool XYZ_SCFTableGetPathStringView(XYZ_SCFTable* table,
+                                   const char* path,
+                                   const char** value,
+                                   size_t* value_len) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFTableResolvePath(table, path, &key) &&
+         XYZ_SCFKeyGetStringView(key, value, value_len);
+}
+
+bool XYZ_SCFTableGetPathTable(XYZ_SCFTable* table,
+                              const char* path,
+                              XYZ_SCFTable** value) {
+  XYZ_SCFKey key = {0};
+  return XYZ_SCFTableResolvePath(table, path, &key) &&
+         XYZ_SCFKeyGetTable(key, value);
+}
+
+bool XYZ_SCFTableSetPath(XYZ_SCFTable* table,
+                         const char* path,
+                         XYZ_SCFValue value) {
+  XYZ_SCFPath compiled = {0};
+  return XYZ_SCFPathCompile(&compiled, path) &&
+         XYZ_SCFPathSet(table, &compiled, value);
+}
+
+XYZ_SCFTable* path_parent(XYZ_SCFTable* table,
+                          const XYZ_SCFPath* path,
+                          bool create) {
+  SDL_assert(path->count > 0 && "XYZ_SCFPath: path is not compiled");
+  for (Uint32 i = 0; i + 1 < path->count; i++) {
+    const XYZ_SCFPathSegment* segment = &path->segments[i];
+    XYZ_SCFPair* pair = path_find(table, segment);
+    if (pair == NULL && create) {
+      XYZ_SCFValue value = {0};
+      value.type = XYZ_SCF_VALUE_TYPE_TABLE;
+      value.as_table = XYZ_SCFTableCreateWithArena(table->arena);
+      if (value.as_table == NULL) {
+        return NULL;
+      }
+
+      pair = XYZ_SCFTableAppend(table, segment->key, segment->key_len, value,
+                                path_flags(segment));
+      if (pair == NULL) {
+        if (table->arena == NULL) {
+          XYZ_SCFTableDestroy(value.as_table);
+          SDL_free(value.as_table);
+        }
+        return NULL;
+      }
+    }
+
+    if (pair == NULL) {
+      if (table->lazy == NULL) {
+        SDL_SetError("key not found: %.*s", (Sint32)segment->key_len,
+                     segment->key);
+      }
+      return NULL;
+    }
+
+    if (pair->value.type != XYZ_SCF_VALUE_TYPE_TABLE) {
+      SDL_SetError("incompatible type for key: %.*s",
+                   (Sint32)segment->key_len, segment->key);
+      return NULL;
+    }
+    table = pair->value.as_table;
+  }
+  return table;
+}
+
+XYZ_SCFPair* path_find(XYZ_SCFTable* table,
+                       const XYZ_SCFPathSegment* segment) {
+  if (segment->atom != XYZ_SCF_NO_ATOM) {
+    return XYZ_SCFTableFindAtom(table, segment->atom);
+  }
+  return XYZ_SCFTableFind(table, segment->key, segment->key_len,
+                          segment->hash);
+}
+
+Uint32 path_flags(const XYZ_SCFPathSegment* segment) {
+  if (segment->atom != XYZ_SCF_NO_ATOM) {
+    return XYZ_SCF_PAIR_FLAG_KEY_ATOM;
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/parser.h>
+#include <scf/path.h>
+
+#include "test.h"
+
+static void path_get(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* root = test_parse(
+      "name = \"hero\" video { display { width = 1280 gamma = 2.2 "
+      "vsync = true mode = \"full\" } }");
+
+  Sint32 width = 0;
+  float gamma = 0.0f;
+  bool vsync = false;
+  const char* mode = NULL;
+  size_t mode_len = 0;
+  XYZ_SCFTable* display = NULL;
+  assert_true(XYZ_SCFTableGetPathI32(root, "video.display.width", &width));
+  assert_int_equal(width, 1280);
+  assert_true(XYZ_SCFTableGetPathF32(root, "video.display.gamma", &gamma));
+  assert_float_equal(gamma, 2.2f, 0.0f);
+  assert_true(XYZ_SCFTableGetPathBool(root, "video.display.vsync", &vsync));
+  assert_true(vsync);
+  assert_true(XYZ_SCFTableGetPathStringView(root, "video.display.mode", &mode,
+                                            &mode_len));
+  assert_int_equal(mode_len, 4);
+  assert_true(XYZ_SCFTableGetPathTable(root, "video.display", &display));
+  assert_true(XYZ_SCFTableHas(display, "width"));
+  assert_true(XYZ_SCFTableGetPathStringView(root, "name", &mode, &mode_len));
+
+  // missing keys, wrong types and tables in the middle that are not tables
+  assert_false(XYZ_SCFTableGetPathI32(root, "video.display.height", &width));
+  assert_false(XYZ_SCFTableGetPathI32(root, "video.display.gamma", &width));
+  assert_false(XYZ_SCFTableGetPathI32(root, "name.width", &width));
+  assert_false(XYZ_SCFTableGetPathI32(root, "audio.volume", &width));
+
+  // malformed paths
+  XYZ_SCFPath path = {0};
+  assert_false(XYZ_SCFPathCompile(&path, ""));
+  assert_false(XYZ_SCFPathCompile(&path, "video..width"));
+  assert_false(XYZ_SCFPathCompile(&path, ".video"));
+  assert_false(XYZ_SCFPathCompile(&path, "video."));
+  assert_false(XYZ_SCFPathCompile(&path, "a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q"));
+
+  XYZ_SCFTableDestroy(root);
+  SDL_free(root);
+}
+
+static void path_compiled(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* root = test_parse("video { display { width = 1280 } }");
+
+  XYZ_SCFPath path = {0};
+  assert_true(XYZ_SCFPathCompile(&path, "video.display.width"));
+  assert_int_equal(path.count, 3);
+  assert_int_equal(path.segments[1].key_len, 7);
+  assert_int_equal(path.segments[1].hash, XYZ_SCFHashKey("display", 7));
+
+  XYZ_SCFValue value = {0};
+  assert_true(XYZ_SCFPathGet(root, &path, &value));
+  assert_int_equal(value.as_i32, 1280);
+
+  // handles resolved through a path see later updates
+  XYZ_SCFKey key = {0};
+  Sint32 width = 0;
+  assert_true(XYZ_SCFPathResolve(root, &path, &key));
+  value.as_i32 = 1920;
+  assert_true(XYZ_SCFPathSet(root, &path, value));
+  assert_true(XYZ_SCFKeyGetI32(key, &width));
+  assert_int_equal(width, 1920);
+
+  // interned paths find the same pairs and intern the keys they add
+  assert_true(XYZ_SCFPathIntern(&path));
+  assert_int_not_equal(path.segments[1].atom, XYZ_SCF_NO_ATOM);
+  assert_true(XYZ_SCFPathGet(root, &path, &value));
+  assert_int_equal(value.as_i32, 1920);
+
+  XYZ_SCFPath height = {0};
+  assert_true(XYZ_SCFPathCompile(&height, "video.display.height"));
+  assert_true(XYZ_SCFPathIntern(&height));
+  assert_true(XYZ_SCFPathSet(root, &height, value));
+  XYZ_SCFPair* pair = XYZ_SCFKeyPair(key);
+  XYZ_SCFTable* display = NULL;
+  assert_true(XYZ_SCFTableGetPathTable(root, "video.display", &display));
+  assert_int_equal(display->pairs[1].key_atom, height.segments[2].atom);
+  assert_string_equal(pair->key, "width");
+
+  XYZ_SCFTableDestroy(root);
+  SDL_free(root);
+}
+
+static void path_set(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* root = XYZ_SCFTableCreate();
+  XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = 720};
+
+  // intermediate tables are created as needed
+  assert_true(XYZ_SCFTableSetPath(root, "video.display.height", value));
+  value.as_i32 = 1280;
+  assert_true(XYZ_SCFTableSetPath(root, "video.display.width", value));
+  value.as_i32 = 3;
+  assert_true(XYZ_SCFTableSetPath(root, "lives", value));
+
+  XYZ_SCFTable* expected = test_parse(
+      "video { display { height = 720 width = 1280 } } lives = 3");
+  assert_true(XYZ_SCFTableEqual(root, expected));
+
+  // cannot go through a value that is not a table
+  assert_false(XYZ_SCFTableSetPath(root, "lives.count", value));
+  assert_false(XYZ_SCFTableSetPath(root, "video..width", value));
+
+  XYZ_SCFTableDestroy(expected);
+  SDL_free(expected);
+  XYZ_SCFTableDestroy(root);
+  SDL_free(root);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(path_get),
+      cmocka_unit_test(path_compiled),
+      cmocka_unit_test(path_set),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
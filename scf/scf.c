@@ -1 +1,786 @@
 #include "scf/scf.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_cpuinfo.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_thread.h>
+
+#if defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define XYZ_SCF_HAS_MMAP 1
+#endif
+
+#ifdef SDL_PLATFORM_LINUX
+#include <sys/inotify.h>
+#define XYZ_SCF_HAS_INOTIFY 1
+#else
+#include <SDL3/SDL_filesystem.h>
+#endif
+
+// rough bytes of tree per byte of source, sizes the first arena block so most
+// documents fit in a single allocation
+#define XYZ_SCF_DOCUMENT_GROWTH 8
+// bytes read from a stream per XYZ_SCFPushParserFeed
+#define XYZ_SCF_STREAM_CHUNK 16384
+// inputs below this are not worth splitting
+#define XYZ_SCF_PARALLEL_MIN_LEN (256 * 1024)
+// pieces per thread, so threads finishing early can take more
+#define XYZ_SCF_PARALLEL_SPLIT 4
+#define XYZ_SCF_PARALLEL_MAX_THREADS 64
+
+typedef struct {
+  const char* data;
+  size_t len;
+  XYZ_SCFArena arena;
+  XYZ_SCFTable* table;
+  bool parsed;
+  XYZ_SCFError error;  // positioned within the piece when line is not zero
+} parallel_piece;
+
+typedef struct {
+  parallel_piece* pieces;
+  Sint32 piece_count;
+  SDL_AtomicInt next;  // next piece to take
+  Uint32 flags;
+} parallel_work;
+
+// shared with error.c, pieces know where their errors are within themselves
+bool error_locate(XYZ_SCFError* error, const char* data, size_t len);
+// shared with table.c, copy pair to the end of table
+XYZ_SCFPair* table_push(XYZ_SCFTable* table, const XYZ_SCFPair* pair);
+// parse data into the (empty) root of doc
+bool document_parse(XYZ_SCFDocument* doc,
+                    const char* data,
+                    size_t len,
+                    Uint32 flags);
+// map path read only, returns false if the file cannot be mapped
+bool file_map(const char* path, const char** data, size_t* len);
+void file_unmap(const char* data, size_t len);
+// read path through SDL_IOStream into a buffer from arena, or the heap if
+// arena is NULL
+bool file_read(const char* path,
+               XYZ_SCFArena* arena,
+               char** data,
+               size_t* len);
+// split data after top level blocks into pieces of about piece_len bytes,
+// returns 0 if it cannot be split safely
+Sint32 parallel_split(const char* data,
+                      size_t len,
+                      size_t piece_len,
+                      parallel_piece* pieces,
+                      Sint32 piece_cap);
+// thread function parsing pieces until none are left
+int parallel_worker(void* data);
+// point table and the blocks below it at arena, the one their piece arena was
+// merged into
+void parallel_adopt(XYZ_SCFTable* table, XYZ_SCFArena* arena);
+// start watching the file of watcher
+bool watch_start(XYZ_SCFWatcher* watcher);
+// true if the file changed since the last call
+bool watch_changed(XYZ_SCFWatcher* watcher);
+void watch_stop(XYZ_SCFWatcher* watcher);
+// XYZ_SCFChangeCallback passing changes on to the matching subscriptions
+void watch_dispatch(void* userdata,
+                    XYZ_SCFChangeKind kind,
+                    const char* path,
+                    const XYZ_SCFPair* old_pair,
+                    const XYZ_SCFPair* new_pair);
+
+XYZ_SCFDocument* XYZ_SCFDocumentCreate(size_t size_hint) {
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, size_hint);
+
+  // the document lives in the first block of its own arena
+  XYZ_SCFDocument* doc = XYZ_SCFArenaAlloc(&arena, sizeof(XYZ_SCFDocument));
+  if (doc == NULL) {
+    return NULL;
+  }
+
+  doc->arena = arena;
+  doc->root = XYZ_SCFTableCreateWithArena(&doc->arena);
+  if (doc->root == NULL) {
+    XYZ_SCFDocumentDestroy(doc);
+    return NULL;
+  }
+  return doc;
+}
+
+void XYZ_SCFDocumentDestroy(XYZ_SCFDocument* doc) {
+  SDL_assert(doc != NULL && "XYZ_SCFDocumentDestroy: doc cannot be NULL");
+  if (doc->source_mapped) {
+    file_unmap(doc->source, doc->source_len);
+  }
+
+  // copy the arena out first, doc is freed along with it
+  XYZ_SCFArena arena = doc->arena;
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+XYZ_SCFDocument* XYZ_SCFParseDocument(const char* data,
+                                      size_t len,
+                                      Uint32 flags) {
+  SDL_assert(data != NULL && "XYZ_SCFParseDocument: data cannot be NULL");
+  XYZ_SCFDocument* doc = XYZ_SCFDocumentCreate(len * XYZ_SCF_DOCUMENT_GROWTH);
+  if (doc == NULL) {
+    return NULL;
+  }
+
+  if (!document_parse(doc, data, len, flags)) {
+    XYZ_SCFDocumentDestroy(doc);
+    return NULL;
+  }
+  return doc;
+}
+
+XYZ_SCFDocument* XYZ_SCFParseDocumentWithSchema(const char* data,
+                                                size_t len,
+                                                Uint32 flags,
+                                                const XYZ_SCFSchema* schema) {
+  SDL_assert(data != NULL &&
+             "XYZ_SCFParseDocumentWithSchema: data cannot be NULL");
+  SDL_assert(schema != NULL &&
+             "XYZ_SCFParseDocumentWithSchema: schema cannot be NULL");
+  XYZ_SCFDocument* doc = XYZ_SCFDocumentCreate(len * XYZ_SCF_DOCUMENT_GROWTH);
+  if (doc == NULL) {
+    return NULL;
+  }
+
+  // an empty file still gets the defaults and has to have required keys
+  if (len == 0) {
+    data = "\n";
+    len = 1;
+  }
+
+  XYZ_SCFParser parser = {
+      .arena = &doc->arena,
+      .flags = flags & ~XYZ_SCF_PARSE_INDEXED,
+      .schema = schema,
+  };
+  XYZ_SCFParserSetFile(&parser, data, len);
+  if (!XYZ_SCFParseTable(&parser, doc->root)) {
+    XYZ_SCFDocumentDestroy(doc);
+    return NULL;
+  }
+  return doc;
+}
+
+XYZ_SCFDocument* XYZ_SCFParseDocumentParallel(const char* data,
+                                              size_t len,
+                                              Uint32 flags,
+                                              Sint32 thread_count) {
+  SDL_assert(data != NULL &&
+             "XYZ_SCFParseDocumentParallel: data cannot be NULL");
+  if (thread_count <= 0) {
+    thread_count = SDL_GetNumLogicalCPUCores();
+  }
+  thread_count = SDL_clamp(thread_count, 1, XYZ_SCF_PARALLEL_MAX_THREADS);
+  // lazy blocks are only brace matched, there is little left to split
+  if (thread_count == 1 || len < XYZ_SCF_PARALLEL_MIN_LEN ||
+      (flags & XYZ_SCF_PARSE_LAZY)) {
+    return XYZ_SCFParseDocument(data, len, flags);
+  }
+
+  Sint32 piece_cap = thread_count * XYZ_SCF_PARALLEL_SPLIT;
+  parallel_piece* pieces = SDL_calloc(piece_cap, sizeof(parallel_piece));
+  if (pieces == NULL) {
+    return NULL;
+  }
+
+  // anything the scan cannot split (one huge block, unbalanced braces, NUL
+  // bytes) is left to the sequential parser to handle or report
+  Sint32 piece_count =
+      parallel_split(data, len, len / piece_cap, pieces, piece_cap);
+  if (piece_count <= 1) {
+    SDL_free(pieces);
+    return XYZ_SCFParseDocument(data, len, flags);
+  }
+
+  parallel_work work = {
+      .pieces = pieces,
+      .piece_count = piece_count,
+      .flags = flags,
+  };
+  SDL_Thread* threads[XYZ_SCF_PARALLEL_MAX_THREADS] = {0};
+  for (Sint32 i = 1; i < SDL_min(thread_count, piece_count); i++) {
+    threads[i] = SDL_CreateThread(parallel_worker, "scf_parse", &work);
+  }
+  parallel_worker(&work);  // the calling thread works too
+  for (Sint32 i = 1; i < thread_count; i++) {
+    if (threads[i] != NULL) {
+      SDL_WaitThread(threads[i], NULL);
+    }
+  }
+
+  // merge in order; the first failed piece holds the error a sequential
+  // parse would have stopped at
+  XYZ_SCFDocument* doc = XYZ_SCFDocumentCreate(0);
+  bool parsed = doc != NULL;
+  for (Sint32 i = 0; i < piece_count; i++) {
+    parallel_piece* piece = &pieces[i];
+    if (parsed && !piece->parsed) {
+      if (piece->error.line != 0) {
+        piece->error.offset += piece->data - data;
+        error_locate(&piece->error, data, len);
+      } else {
+        XYZ_SCFErrorReport(&piece->error);
+      }
+      parsed = false;
+    }
+
+    if (parsed) {
+      // keys and values stay where they are, in the arena merged below
+      XYZ_SCFCursor cursor = XYZ_SCFTableCursor(piece->table);
+      while (parsed && XYZ_SCFCursorNext(&cursor)) {
+        parsed = table_push(doc->root, cursor.pair) != NULL;
+      }
+      // the piece arena goes away with pieces, blocks that grow later have
+      // to allocate from the document
+      parallel_adopt(piece->table, &doc->arena);
+      XYZ_SCFArenaMerge(&doc->arena, &piece->arena);
+    } else {
+      XYZ_SCFArenaDestroy(&piece->arena);
+    }
+  }
+  SDL_free(pieces);
+
+  if (!parsed && doc != NULL) {
+    XYZ_SCFDocumentDestroy(doc);
+    return NULL;
+  }
+  return doc;
+}
+
+XYZ_SCFDocument* XYZ_SCFLoadFile(const char* path, Uint32 flags) {
+  SDL_assert(path != NULL && "XYZ_SCFLoadFile: path cannot be NULL");
+  // lazy blocks are parsed from the contents long after loading
+  bool keep_source =
+      (flags & (XYZ_SCF_PARSE_ZERO_COPY | XYZ_SCF_PARSE_LAZY)) != 0;
+
+  const char* data = NULL;
+  size_t len = 0;
+  if (file_map(path, &data, &len)) {
+    XYZ_SCFDocument* doc = XYZ_SCFDocumentCreate(len * XYZ_SCF_DOCUMENT_GROWTH);
+    if (doc == NULL) {
+      file_unmap(data, len);
+      return NULL;
+    }
+
+    bool parsed = document_parse(doc, data, len, flags);
+    if (parsed && keep_source) {
+      doc->source = data;
+      doc->source_len = len;
+      doc->source_mapped = true;
+      return doc;
+    }
+
+    file_unmap(data, len);
+    if (!parsed) {
+      XYZ_SCFDocumentDestroy(doc);
+      return NULL;
+    }
+    return doc;
+  }
+
+  // no mapping: stream it, straight into the document arena if the document
+  // keeps pointing at it
+  char* buffer = NULL;
+  XYZ_SCFDocument* doc = XYZ_SCFDocumentCreate(0);
+  if (doc == NULL) {
+    return NULL;
+  }
+
+  if (!file_read(path, keep_source ? &doc->arena : NULL, &buffer, &len)) {
+    XYZ_SCFDocumentDestroy(doc);
+    return NULL;
+  }
+
+  bool parsed = document_parse(doc, buffer, len, flags);
+  if (keep_source) {
+    doc->source = buffer;
+    doc->source_len = len;
+  } else {
+    SDL_free(buffer);
+  }
+
+  if (!parsed) {
+    XYZ_SCFDocumentDestroy(doc);
+    return NULL;
+  }
+  return doc;
+}
+
+XYZ_SCFDocument* XYZ_SCFParseStream(SDL_IOStream* io) {
+  SDL_assert(io != NULL && "XYZ_SCFParseStream: io cannot be NULL");
+  char* chunk = SDL_malloc(XYZ_SCF_STREAM_CHUNK);
+  if (chunk == NULL) {
+    return NULL;
+  }
+
+  XYZ_SCFDocument* doc =
+      XYZ_SCFDocumentCreate(XYZ_SCF_STREAM_CHUNK * XYZ_SCF_DOCUMENT_GROWTH);
+  if (doc == NULL) {
+    SDL_free(chunk);
+    return NULL;
+  }
+
+  XYZ_SCFPushParser parser = {0};
+  XYZ_SCFPushParserInit(&parser, doc->root, &doc->arena);
+  bool parsed = true;
+  while (parsed) {
+    size_t got = SDL_ReadIO(io, chunk, XYZ_SCF_STREAM_CHUNK);
+    if (got == 0) {
+      parsed = SDL_GetIOStatus(io) == SDL_IO_STATUS_EOF &&
+               XYZ_SCFPushParserFinish(&parser);
+      break;
+    }
+    parsed = XYZ_SCFPushParserFeed(&parser, chunk, got);
+  }
+
+  XYZ_SCFPushParserDestroy(&parser);
+  SDL_free(chunk);
+  if (!parsed) {
+    XYZ_SCFDocumentDestroy(doc);
+    return NULL;
+  }
+  return doc;
+}
+
+XYZ_SCFBinaryFile* XYZ_SCFLoadBinaryFile(const char* path) {
+  SDL_assert(path != NULL && "XYZ_SCFLoadBinaryFile: path cannot be NULL");
+  XYZ_SCFBinaryFile* file = SDL_malloc(sizeof(XYZ_SCFBinaryFile));
+  if (file == NULL) {
+    return NULL;
+  }
+  SDL_memset(file, 0, sizeof(XYZ_SCFBinaryFile));
+
+  if (file_map(path, &file->source, &file->source_len)) {
+    file->source_mapped = true;
+  } else {
+    char* buffer = NULL;
+    if (!file_read(path, NULL, &buffer, &file->source_len)) {
+      SDL_free(file);
+      return NULL;
+    }
+    file->source = buffer;
+  }
+
+  if (!XYZ_SCFBinaryOpen(&file->binary, file->source, file->source_len)) {
+    XYZ_SCFBinaryFileDestroy(file);
+    return NULL;
+  }
+  return file;
+}
+
+void XYZ_SCFBinaryFileDestroy(XYZ_SCFBinaryFile* file) {
+  SDL_assert(file != NULL && "XYZ_SCFBinaryFileDestroy: file cannot be NULL");
+  if (file->source_mapped) {
+    file_unmap(file->source, file->source_len);
+  } else {
+    SDL_free((void*)file->source);
+  }
+  SDL_free(file);
+}
+
+XYZ_SCFWatcher* XYZ_SCFWatchFile(const char* path) {
+  SDL_assert(path != NULL && "XYZ_SCFWatchFile: path cannot be NULL");
+  XYZ_SCFWatcher* watcher = SDL_malloc(sizeof(XYZ_SCFWatcher));
+  if (watcher == NULL) {
+    return NULL;
+  }
+  SDL_memset(watcher, 0, sizeof(XYZ_SCFWatcher));
+  watcher->notify_fd = -1;
+
+  // watch before the first load so no change falls in between
+  watcher->path = SDL_strdup(path);
+  if (watcher->path == NULL || !watch_start(watcher)) {
+    XYZ_SCFWatcherDestroy(watcher);
+    return NULL;
+  }
+
+  watcher->doc = XYZ_SCFLoadFile(path, 0);
+  if (watcher->doc == NULL) {
+    XYZ_SCFWatcherDestroy(watcher);
+    return NULL;
+  }
+  return watcher;
+}
+
+bool XYZ_SCFWatcherSubscribe(XYZ_SCFWatcher* watcher,
+                             const char* prefix,
+                             XYZ_SCFChangeCallback callback,
+                             void* userdata) {
+  SDL_assert(watcher != NULL &&
+             "XYZ_SCFWatcherSubscribe: watcher cannot be NULL");
+  SDL_assert(prefix != NULL &&
+             "XYZ_SCFWatcherSubscribe: prefix cannot be NULL");
+  SDL_assert(callback != NULL &&
+             "XYZ_SCFWatcherSubscribe: callback cannot be NULL");
+
+  if (watcher->subscription_count == watcher->subscription_cap) {
+    Uint32 cap = SDL_max(watcher->subscription_cap * 2, 4);
+    XYZ_SCFSubscription* subscriptions = SDL_realloc(
+        watcher->subscriptions, cap * sizeof(XYZ_SCFSubscription));
+    if (subscriptions == NULL) {
+      return false;
+    }
+    watcher->subscriptions = subscriptions;
+    watcher->subscription_cap = cap;
+  }
+
+  char* copy = SDL_strdup(prefix);
+  if (copy == NULL) {
+    return false;
+  }
+
+  watcher->subscriptions[watcher->subscription_count++] = (XYZ_SCFSubscription){
+      .prefix = copy,
+      .prefix_len = SDL_strlen(copy),
+      .callback = callback,
+      .userdata = userdata,
+  };
+  return true;
+}
+
+bool XYZ_SCFWatcherPoll(XYZ_SCFWatcher* watcher) {
+  SDL_assert(watcher != NULL && "XYZ_SCFWatcherPoll: watcher cannot be NULL");
+  if (!watch_changed(watcher)) {
+    return true;
+  }
+
+  XYZ_SCFDocument* doc = XYZ_SCFLoadFile(watcher->path, 0);
+  if (doc == NULL) {
+    return false;
+  }
+
+  // callbacks see pairs of both versions, the old one goes after them
+  XYZ_SCFDocument* old = watcher->doc;
+  watcher->doc = doc;
+  bool diffed = XYZ_SCFTableDiff(old->root, doc->root, watch_dispatch, watcher);
+  XYZ_SCFDocumentDestroy(old);
+  return diffed;
+}
+
+void XYZ_SCFWatcherDestroy(XYZ_SCFWatcher* watcher) {
+  SDL_assert(watcher != NULL &&
+             "XYZ_SCFWatcherDestroy: watcher cannot be NULL");
+  watch_stop(watcher);
+  if (watcher->doc != NULL) {
+    XYZ_SCFDocumentDestroy(watcher->doc);
+  }
+
+  for (Uint32 i = 0; i < watcher->subscription_count; i++) {
+    SDL_free(watcher->subscriptions[i].prefix);
+  }
+  SDL_free(watcher->subscriptions);
+  SDL_free(watcher->path);
+  SDL_free(watcher);
+}
+
+bool document_parse(XYZ_SCFDocument* doc,
+                    const char* data,
+                    size_t len,
+                    Uint32 flags) {
+  if (len == 0) {
+    return true;
+  }
+
+  XYZ_SCFParser parser = {.arena = &doc->arena, .flags = flags};
+  XYZ_SCFParserSetFile(&parser, data, len);
+  if ((flags & XYZ_SCF_PARSE_INDEXED) && !(flags & XYZ_SCF_PARSE_LAZY)) {
+    return XYZ_SCFParseTableIndexed(&parser, doc->root);
+  }
+  return XYZ_SCFParseTable(&parser, doc->root);
+}
+
+Sint32 parallel_split(const char* data,
+                      size_t len,
+                      size_t piece_len,
+                      parallel_piece* pieces,
+                      Sint32 piece_cap) {
+  // the text after a block closing at the top level always starts a new
+  // entry, cut there; strings end at a quote or a new line like in the lexer
+  Sint32 piece_count = 0;
+  const char* start = data;
+  const char* end = data + len;
+  Sint32 depth = 0;
+  for (const char* cur = data; cur < end; cur++) {
+    switch (*cur) {
+      case '"':
+        cur++;
+        while (cur < end && *cur != '"' && *cur != '\n' && *cur != '\0') {
+          cur++;
+        }
+        if (cur < end && *cur == '\0') {
+          return 0;
+        }
+        break;
+      case '{':
+        depth++;
+        break;
+      case '}':
+        if (--depth < 0) {
+          return 0;
+        }
+        if (depth == 0 && (size_t)(cur + 1 - start) >= piece_len &&
+            piece_count + 1 < piece_cap) {
+          pieces[piece_count++].data = start;
+          start = cur + 1;
+        }
+        break;
+      case '\0':
+        return 0;
+      default:
+        break;
+    }
+  }
+
+  if (depth != 0) {
+    return 0;
+  }
+
+  pieces[piece_count++].data = start;
+  for (Sint32 i = 0; i < piece_count; i++) {
+    const char* piece_end = i + 1 < piece_count ? pieces[i + 1].data : end;
+    pieces[i].len = piece_end - pieces[i].data;
+  }
+  return piece_count;
+}
+
+int parallel_worker(void* data) {
+  parallel_work* work = data;
+  while (true) {
+    Sint32 index = SDL_AddAtomicInt(&work->next, 1);
+    if (index >= work->piece_count) {
+      return 0;
+    }
+
+    // each piece has its own arena, merged into the document afterwards
+    parallel_piece* piece = &work->pieces[index];
+    XYZ_SCFArenaInit(&piece->arena, piece->len * XYZ_SCF_DOCUMENT_GROWTH);
+    piece->table = XYZ_SCFTableCreateWithArena(&piece->arena);
+    if (piece->table == NULL) {
+      SDL_strlcpy(piece->error.message, "out of memory",
+                  sizeof(piece->error.message));
+      continue;
+    }
+
+    XYZ_SCFParser parser = {.arena = &piece->arena, .flags = work->flags};
+    piece->parsed = true;
+    if (piece->len > 0) {
+      XYZ_SCFParserSetFile(&parser, piece->data, piece->len);
+      piece->parsed = (work->flags & XYZ_SCF_PARSE_INDEXED)
+                          ? XYZ_SCFParseTableIndexed(&parser, piece->table)
+                          : XYZ_SCFParseTable(&parser, piece->table);
+    }
+    if (!piece->parsed) {
+      piece->error = parser.error;
+      if (piece->error.line == 0) {
+        SDL_strlcpy(piece->error.message, SDL_GetError(),
+                    sizeof(piece->error.message));
+      }
+    }
+  }
+}
+
+#ifdef XYZ_SCF_HAS_MMAP
+bool file_map(const char* path, const char** data, size_t* len) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+
+  void* map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  // the lexer reads front to back
+  madvise(map, (size_t)info.st_size, MADV_SEQUENTIAL);
+  *data = map;
+  *len = (size_t)info.st_size;
+  return true;
+}
+
+void file_unmap(const char* data, size_t len) {
+  munmap((void*)data, len);
+}
+#else
+bool file_map(const char* path, const char** data, size_t* len) {
+  (void)path;
+  (void)data;
+  (void)len;
+  return false;
+}
+
+void file_unmap(const char* data, size_t len) {
+  (void)data;
+  (void)len;
+}
+#endif /* XYZ_SCF_HAS_MMAP */
+
+bool file_read(const char* path,
+               XYZ_SCFArena* arena,
+               char** data,
+               size_t* len) {
+  SDL_IOStream* io = SDL_IOFromFile(path, "rb");
+  if (io == NULL) {
+    return false;
+  }
+
+  Sint64 size = SDL_GetIOSize(io);
+  if (size < 0) {
+    SDL_CloseIO(io);
+    return false;
+  }
+
+  // one extra byte so an empty file still gets a buffer
+  char* buffer = arena != NULL ? XYZ_SCFArenaAlloc(arena, (size_t)size + 1)
+                               : SDL_malloc((size_t)size + 1);
+  if (buffer == NULL) {
+    SDL_CloseIO(io);
+    return false;
+  }
+
+  size_t got = SDL_ReadIO(io, buffer, (size_t)size);
+  SDL_CloseIO(io);
+  if (got != (size_t)size) {
+    if (arena == NULL) {
+      SDL_free(buffer);
+    }
+    return false;
+  }
+
+  buffer[size] = '\0';
+  *data = buffer;
+  *len = (size_t)size;
+  return true;
+}
+
+#ifdef XYZ_SCF_HAS_INOTIFY
+bool watch_start(XYZ_SCFWatcher* watcher) {
+  // editors usually save to a temporary file and rename it over the old one,
+  // watch the directory so the new file is seen too
+  const char* slash = SDL_strrchr(watcher->path, '/');
+  watcher->file_name = slash != NULL ? slash + 1 : watcher->path;
+
+  watcher->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watcher->notify_fd < 0) {
+    SDL_SetError("cannot create inotify instance");
+    return false;
+  }
+
+  char* dir = slash == NULL            ? SDL_strdup(".")
+              : slash == watcher->path ? SDL_strdup("/")
+                                       : SDL_strndup(watcher->path,
+                                                     slash - watcher->path);
+  if (dir == NULL) {
+    return false;
+  }
+
+  int watched = inotify_add_watch(watcher->notify_fd, dir,
+                                  IN_CLOSE_WRITE | IN_MOVED_TO);
+  SDL_free(dir);
+  if (watched < 0) {
+    SDL_SetError("cannot watch directory of: %s", watcher->path);
+    return false;
+  }
+  return true;
+}
+
+bool watch_changed(XYZ_SCFWatcher* watcher) {
+  union {
+    struct inotify_event event;  // aligns the buffer for events
+    char data[4096];
+  } events;
+  bool changed = false;
+  while (true) {
+    ssize_t got = read(watcher->notify_fd, events.data, sizeof(events));
+    if (got <= 0) {
+      return changed;
+    }
+
+    for (char* cur = events.data; cur < events.data + got;) {
+      struct inotify_event* event = (struct inotify_event*)cur;
+      if (event->len > 0 &&
+          SDL_strcmp(event->name, watcher->file_name) == 0) {
+        changed = true;
+      }
+      cur += sizeof(struct inotify_event) + event->len;
+    }
+  }
+}
+
+void watch_stop(XYZ_SCFWatcher* watcher) {
+  if (watcher->notify_fd >= 0) {
+    close(watcher->notify_fd);
+    watcher->notify_fd = -1;
+  }
+}
+#else
+bool watch_start(XYZ_SCFWatcher* watcher) {
+  SDL_PathInfo info;
+  if (!SDL_GetPathInfo(watcher->path, &info)) {
+    return false;
+  }
+  watcher->modify_time = info.modify_time;
+  return true;
+}
+
+bool watch_changed(XYZ_SCFWatcher* watcher) {
+  SDL_PathInfo info;
+  if (!SDL_GetPathInfo(watcher->path, &info) ||
+      info.modify_time == watcher->modify_time) {
+    return false;
+  }
+  watcher->modify_time = info.modify_time;
+  return true;
+}
+
+void watch_stop(XYZ_SCFWatcher* watcher) {
+  (void)watcher;
+}
+#endif /* XYZ_SCF_HAS_INOTIFY */
+
+void watch_dispatch(void* userdata,
+                    XYZ_SCFChangeKind kind,
+                    const char* path,
+                    const XYZ_SCFPair* old_pair,
+                    const XYZ_SCFPair* new_pair) {
+  XYZ_SCFWatcher* watcher = userdata;
+  size_t path_len = SDL_strlen(path);
+  for (Uint32 i = 0; i < watcher->subscription_count; i++) {
+    XYZ_SCFSubscription* sub = &watcher->subscriptions[i];
+
+    // the change is below the prefix, or replaces a table holding it
+    size_t len = SDL_min(path_len, sub->prefix_len);
+    bool related = sub->prefix_len == 0 ||
+                   (SDL_strncmp(path, sub->prefix, len) == 0 &&
+                    (path[len] == '\0' || path[len] == '.') &&
+                    (sub->prefix[len] == '\0' || sub->prefix[len] == '.'));
+    if (related) {
+      sub->callback(sub->userdata, kind, path, old_pair, new_pair);
+    }
+  }
+}
+
+void parallel_adopt(XYZ_SCFTable* table, XYZ_SCFArena* arena) {
+  table->arena = arena;
+  for (Uint32 i = 0; i < table->pair_count; i++) {
+    if (table->pairs[i].value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+      parallel_adopt(table->pairs[i].value.as_table, arena);
+    }
+  }
+}
@@ -0,0 +1,43 @@
+#ifndef XYZ_SCF_ARENA_H
+#define XYZ_SCF_ARENA_H
+
+#include <SDL3/SDL_stdinc.h>
+
+#define XYZ_SCF_ARENA_MIN_BLOCK 4096
+#define XYZ_SCF_ARENA_ALIGN 16
+
+typedef struct XYZ_SCFArenaBlock {
+  struct XYZ_SCFArenaBlock* next;
+  size_t size;
+  size_t used;
+} XYZ_SCFArenaBlock;
+
+typedef struct {
+  XYZ_SCFArenaBlock* head;
+  size_t next_size;
+} XYZ_SCFArena;
+
+/**
+ * Initializes an empty arena, the first block will hold at least size_hint
+ * bytes.
+ */
+void XYZ_SCFArenaInit(XYZ_SCFArena* arena, size_t size_hint);
+
+/**
+ * Bump allocates size bytes from the arena, memory is zeroed and aligned to
+ * XYZ_SCF_ARENA_ALIGN. Returns NULL if a new block could not be allocated.
+ */
+void* XYZ_SCFArenaAlloc(XYZ_SCFArena* arena, size_t size);
+
+/**
+ * Moves every block of other into arena, other is left empty. Allocations
+ * from both stay valid and are released with arena.
+ */
+void XYZ_SCFArenaMerge(XYZ_SCFArena* arena, XYZ_SCFArena* other);
+
+/**
+ * Frees every block of the arena at once.
+ */
+void XYZ_SCFArenaDestroy(XYZ_SCFArena* arena);
+
+#endif /* XYZ_SCF_ARENA_H */
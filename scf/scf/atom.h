@@ -0,0 +1,49 @@
+#ifndef XYZ_SCF_ATOM_H
+#define XYZ_SCF_ATOM_H
+
+#include <SDL3/SDL_stdinc.h>
+
+#define XYZ_SCF_NO_ATOM 0
+// atoms are never released before XYZ_SCFAtomsQuit, the table stops here
+#define XYZ_SCF_ATOM_MAX (4096 * 1024)
+
+/**
+ * Id of a key interned in the atom table, shared by every document of the
+ * process. Equal keys get the same id and the same null terminated copy, so
+ * two interned keys are compared by id alone. XYZ_SCF_NO_ATOM is never
+ * handed out.
+ */
+typedef Uint32 XYZ_SCFAtom;
+
+/**
+ * Returns the atom of key, interning it if it was not yet, hash must be
+ * XYZ_SCFHashKey of it. Safe to call from any thread. Returns
+ * XYZ_SCF_NO_ATOM when out of memory or once the table holds
+ * XYZ_SCF_ATOM_MAX atoms; pairs asking for an atom then copy their key.
+ */
+XYZ_SCFAtom XYZ_SCFAtomIntern(const char* key, size_t key_len, Uint32 hash);
+
+/**
+ * Returns the atom of key without interning it, XYZ_SCF_NO_ATOM if no one
+ * interned it so far.
+ */
+XYZ_SCFAtom XYZ_SCFAtomFind(const char* key, size_t key_len, Uint32 hash);
+
+/**
+ * The interned copy of an atom, valid until XYZ_SCFAtomsQuit. key_len and
+ * hash are optional.
+ */
+const char* XYZ_SCFAtomKey(XYZ_SCFAtom atom, Uint32* key_len, Uint32* hash);
+
+/**
+ * Number of atoms interned and bytes held by the atom table.
+ */
+Uint32 XYZ_SCFAtomCount(void);
+size_t XYZ_SCFAtomBytes(void);
+
+/**
+ * Releases every atom, only to be called once no table refers to them.
+ */
+void XYZ_SCFAtomsQuit(void);
+
+#endif /* XYZ_SCF_ATOM_H */
@@ -0,0 +1,132 @@
+#ifndef XYZ_SCF_BINARY_H
+#define XYZ_SCF_BINARY_H
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include "table.h"
+
+#define XYZ_SCF_BINARY_MAGIC SDL_FOURCC('S', 'C', 'F', 'B')
+#define XYZ_SCF_BINARY_VERSION 2
+
+/*
+ * Binary layout, host byte order and 4 byte aligned:
+ *
+ *   header | nodes[node_count] | array pool | string pool
+ *
+ * Every table is a contiguous run of nodes, children of a table node are the
+ * nodes [first, first + count) so the file needs no pointer fix ups. Keys and
+ * strings are offsets into the pool and are null terminated there. The
+ * elements of an array node are packed at a 4 byte aligned offset into the
+ * array pool: one byte per bool, Sint32 and float as they are and a
+ * (string pool offset, length) pair of Uint32 per string.
+ */
+
+typedef struct {
+  Uint32 magic;
+  Uint32 version;
+  Uint32 node_count;
+  Uint32 nodes_offset;
+  Uint32 strings_offset;
+  Uint32 strings_len;
+  Uint32 root_count;  // root table is nodes [0, root_count)
+  Uint32 arrays_offset;
+  Uint32 arrays_len;
+  Uint32 reserved;
+} XYZ_SCFBinaryHeader;
+
+typedef struct {
+  Uint32 key;  // pool offset
+  Uint32 key_len;
+  Uint32 key_hash;  // XYZ_SCFHashKey of the key
+  Uint32 type;      // XYZ_SCFValueType
+  union {
+    Uint32 as_bool;
+    Sint32 as_i32;
+    float as_f32;
+    Uint32 as_string;  // pool offset
+    Uint32 as_first;   // first child node
+    Uint32 as_items;   // array pool offset
+  };
+  Uint32 len;  // string length, child count or array length
+} XYZ_SCFBinaryNode;
+
+typedef struct {
+  const XYZ_SCFBinaryHeader* header;
+  const XYZ_SCFBinaryNode* nodes;
+  const Uint8* arrays;
+  const char* strings;
+} XYZ_SCFBinary;
+
+typedef struct {
+  const XYZ_SCFBinary* binary;
+  Uint32 first;
+  Uint32 count;
+} XYZ_SCFBinaryTable;
+
+/**
+ * Serializes table into a newly allocated binary image, release it with
+ * SDL_free. Returns NULL on error.
+ */
+void* XYZ_SCFTableToBinary(XYZ_SCFTable* table, size_t* out_len);
+
+/**
+ * Serializes table into io with a single write.
+ */
+bool XYZ_SCFTableWriteBinary(XYZ_SCFTable* table, SDL_IOStream* io);
+
+/**
+ * Validates a binary image and prepares it for in place use, data must stay
+ * alive (and mapped) while binary is used.
+ */
+bool XYZ_SCFBinaryOpen(XYZ_SCFBinary* binary, const void* data, size_t len);
+
+XYZ_SCFBinaryTable XYZ_SCFBinaryRoot(const XYZ_SCFBinary* binary);
+const XYZ_SCFBinaryNode* XYZ_SCFBinaryFind(XYZ_SCFBinaryTable table,
+                                           const char* key);
+bool XYZ_SCFBinaryHas(XYZ_SCFBinaryTable table, const char* key);
+bool XYZ_SCFBinaryGetBool(XYZ_SCFBinaryTable table,
+                          const char* key,
+                          bool* value);
+bool XYZ_SCFBinaryGetI32(XYZ_SCFBinaryTable table,
+                         const char* key,
+                         Sint32* value);
+bool XYZ_SCFBinaryGetF32(XYZ_SCFBinaryTable table,
+                         const char* key,
+                         float* value);
+bool XYZ_SCFBinaryGetString(XYZ_SCFBinaryTable table,
+                            const char* key,
+                            const char** value);
+bool XYZ_SCFBinaryGetTable(XYZ_SCFBinaryTable table,
+                           const char* key,
+                           XYZ_SCFBinaryTable* value);
+
+/**
+ * Bulk getters for arrays, values points at the packed elements in the image
+ * (NULL for empty arrays). As with the table getters an empty array is read
+ * by any of them.
+ */
+bool XYZ_SCFBinaryGetBoolArray(XYZ_SCFBinaryTable table,
+                               const char* key,
+                               const bool** values,
+                               size_t* count);
+bool XYZ_SCFBinaryGetI32Array(XYZ_SCFBinaryTable table,
+                              const char* key,
+                              const Sint32** values,
+                              size_t* count);
+bool XYZ_SCFBinaryGetF32Array(XYZ_SCFBinaryTable table,
+                              const char* key,
+                              const float** values,
+                              size_t* count);
+
+/**
+ * Strings are pool offsets in the image, up to cap of them are written to
+ * values as pointers into it. count is the length of the array.
+ */
+bool XYZ_SCFBinaryGetStringArray(XYZ_SCFBinaryTable table,
+                                 const char* key,
+                                 const char** values,
+                                 size_t cap,
+                                 size_t* count);
+
+#endif /* XYZ_SCF_BINARY_H */
@@ -0,0 +1,74 @@
+#ifndef XYZ_SCF_CONFIG_H
+#define XYZ_SCF_CONFIG_H
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include "scf.h"
+
+#define XYZ_SCF_CONFIG_MAX_READERS 64
+
+/**
+ * Published version of a config, immutable once published.
+ */
+typedef struct {
+  XYZ_SCFDocument* doc;
+  Uint64 version;
+} XYZ_SCFSnapshot;
+
+/**
+ * Versioned config shared between threads. Writers publish whole new
+ * documents with an atomic pointer swap; readers pin the current snapshot
+ * through a hazard pointer, without locks, and replaced snapshots are freed
+ * once no reader has them pinned.
+ */
+typedef struct {
+  void* current;  // XYZ_SCFSnapshot*, only accessed atomically
+
+  // snapshot pinned by each reader slot, NULL when idle
+  void* hazards[XYZ_SCF_CONFIG_MAX_READERS];
+  SDL_AtomicInt claimed[XYZ_SCF_CONFIG_MAX_READERS];
+
+  // writer side, serialized by writer_lock
+  SDL_SpinLock writer_lock;
+  Uint64 version;
+  XYZ_SCFSnapshot** retired;
+  Uint32 retired_count;
+  Uint32 retired_cap;
+} XYZ_SCFConfig;
+
+void XYZ_SCFConfigInit(XYZ_SCFConfig* config);
+
+/**
+ * Frees the current and every retired snapshot, no reader can be left.
+ */
+void XYZ_SCFConfigDestroy(XYZ_SCFConfig* config);
+
+/**
+ * Replaces the current snapshot with doc, which the config owns from then on
+ * and nobody may modify. Blocks left unparsed by XYZ_SCF_PARSE_LAZY are
+ * parsed first, so readers never change the tree. Returns false, leaving doc
+ * to the caller, if one of them fails to parse or it is out of memory.
+ */
+bool XYZ_SCFConfigPublish(XYZ_SCFConfig* config, XYZ_SCFDocument* doc);
+
+/**
+ * Parses path with XYZ_SCFLoadFile and publishes the result,
+ * XYZ_SCF_PARSE_LAZY is ignored.
+ */
+bool XYZ_SCFConfigReload(XYZ_SCFConfig* config, const char* path, Uint32 flags);
+
+/**
+ * Claims a reader slot for the calling thread, returns -1 if all are taken.
+ */
+Sint32 XYZ_SCFConfigAcquireReader(XYZ_SCFConfig* config);
+void XYZ_SCFConfigReleaseReader(XYZ_SCFConfig* config, Sint32 reader);
+
+/**
+ * Pins the current snapshot for reader, which stays alive and unchanged until
+ * unpinned or pinned again. NULL if nothing was published yet.
+ */
+const XYZ_SCFSnapshot* XYZ_SCFConfigPin(XYZ_SCFConfig* config, Sint32 reader);
+void XYZ_SCFConfigUnpin(XYZ_SCFConfig* config, Sint32 reader);
+
+#endif /* XYZ_SCF_CONFIG_H */
@@ -0,0 +1,64 @@
+#ifndef XYZ_SCF_ERROR_H
+#define XYZ_SCF_ERROR_H
+
+#include <SDL3/SDL_stdinc.h>
+
+#define XYZ_SCF_ERROR_MAX 256
+
+typedef enum {
+  XYZ_SCF_EXPECT_KEY = 1 << 0,
+  XYZ_SCF_EXPECT_ASSIGN = 1 << 1,     // =
+  XYZ_SCF_EXPECT_BLOCK = 1 << 2,      // {
+  XYZ_SCF_EXPECT_BLOCK_END = 1 << 3,  // }
+  XYZ_SCF_EXPECT_VALUE = 1 << 4,
+  XYZ_SCF_EXPECT_EOF = 1 << 5,
+  XYZ_SCF_EXPECT_ARRAY_END = 1 << 6,  // ]
+} XYZ_SCFExpected;
+
+/**
+ * Where and why parsing failed. offset is in bytes from the start of the
+ * input, line and col are 1-based (columns count bytes) or zero when not
+ * known. expected is the XYZ_SCFExpected set of what could have come
+ * instead, empty for errors the grammar does not explain: bad characters,
+ * numbers out of range or schema violations.
+ */
+typedef struct {
+  size_t offset;
+  Uint32 line;
+  Uint32 col;
+  Uint32 expected;
+  char message[XYZ_SCF_ERROR_MAX];  // without the position
+} XYZ_SCFError;
+
+/**
+ * Offsets of the line starts of a buffer, built on the first lookup so that
+ * only a failed parse pays for it.
+ */
+typedef struct {
+  const char* data;
+  size_t len;
+  size_t* starts;
+  size_t count;
+} XYZ_SCFLineIndex;
+
+void XYZ_SCFLineIndexInit(XYZ_SCFLineIndex* index,
+                          const char* data,
+                          size_t len);
+void XYZ_SCFLineIndexDestroy(XYZ_SCFLineIndex* index);
+
+/**
+ * Line and column of offset, offsets past the end map to the end. Returns
+ * false if the index cannot be built.
+ */
+bool XYZ_SCFLineIndexFind(XYZ_SCFLineIndex* index,
+                          size_t offset,
+                          Uint32* line,
+                          Uint32* col);
+
+/**
+ * Sets the SDL error to the message of error, prefixed with its line and
+ * column when known. Always returns false.
+ */
+bool XYZ_SCFErrorReport(const XYZ_SCFError* error);
+
+#endif /* XYZ_SCF_ERROR_H */
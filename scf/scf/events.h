@@ -0,0 +1,35 @@
+#ifndef XYZ_SCF_EVENTS_H
+#define XYZ_SCF_EVENTS_H
+
+#include "parser.h"
+#include "table.h"
+
+/**
+ * Callbacks of XYZ_SCFParseEvents, any of them may be NULL. Every entry
+ * starts with key, followed by value for "key = value" or by begin_table,
+ * the entries of the block and end_table for "key { ... }". Arrays come as
+ * begin_array with the array type and element count, one value per element
+ * and end_array. Keys and strings point into the parsed data and are not
+ * null terminated, str_len is the length of strings. Returning false stops
+ * parsing, which then fails with the SDL error the callback set.
+ */
+typedef struct {
+  bool (*begin_table)(void* userdata);
+  bool (*end_table)(void* userdata);
+  bool (*key)(void* userdata, const char* key, size_t key_len);
+  bool (*value)(void* userdata, const XYZ_SCFValue* value);
+  bool (*begin_array)(void* userdata, XYZ_SCFValueType type, Uint32 count);
+  bool (*end_array)(void* userdata);
+} XYZ_SCFEvents;
+
+/**
+ * Parses the data the parser was set to with XYZ_SCFParserSetFile, reporting
+ * it to events instead of building tables and without allocating anything.
+ * The grammar and errors are those of XYZ_SCFParseTable; the schema, arena
+ * and flags of the parser are not used.
+ */
+bool XYZ_SCFParseEvents(XYZ_SCFParser* parser,
+                        const XYZ_SCFEvents* events,
+                        void* userdata);
+
+#endif /* XYZ_SCF_EVENTS_H */
@@ -0,0 +1,43 @@
+#ifndef XYZ_SCF_INDEX_H
+#define XYZ_SCF_INDEX_H
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "parser.h"
+#include "table.h"
+
+typedef struct {
+  // offsets of every punctuation byte, quote and start of a word or number,
+  // in order and followed by the length of the input
+  Uint32* positions;
+  size_t count;
+  size_t cap;
+
+  // offset of the opening quote of the unterminated string building failed
+  // on plus one, zero if it did not fail on one
+  Uint32 open_quote;
+} XYZ_SCFStructuralIndex;
+
+/**
+ * Builds the structural index of data, 64 bytes at a time with the kernels
+ * selected by XYZ_SCFSetLexerKernel. Fails on unterminated strings, setting
+ * open_quote. A NUL byte ends the input, as it does for the lexer.
+ */
+bool XYZ_SCFStructuralIndexBuild(XYZ_SCFStructuralIndex* index,
+                                 const char* data,
+                                 size_t len);
+
+/**
+ * Releases the positions of the index.
+ */
+void XYZ_SCFStructuralIndexDestroy(XYZ_SCFStructuralIndex* index);
+
+/**
+ * Same as XYZ_SCFParseTable, but it indexes the whole input first and then
+ * builds tables by walking the index, without using the lexer. It gives the
+ * same tables and fails on the same inputs; it only tracks offsets, lines
+ * and columns of errors are worked out once it has failed.
+ */
+bool XYZ_SCFParseTableIndexed(XYZ_SCFParser* parser, XYZ_SCFTable* table);
+
+#endif /* XYZ_SCF_INDEX_H */
@@ -0,0 +1,101 @@
+#ifndef XYZ_SCF_LAYER_H
+#define XYZ_SCF_LAYER_H
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "arena.h"
+#include "table.h"
+
+/**
+ * Remembered winner of one dotted path, key.table is NULL when no layer has
+ * it.
+ */
+typedef struct {
+  Uint32 hash;
+  Uint32 path_len;
+  const char* path;  // copied into the cache arena
+  XYZ_SCFKey key;
+  Uint32 layer;
+} XYZ_SCFLayerSlot;
+
+/**
+ * Read view over a stack of tables, e.g. defaults, platform, user and command
+ * line, where upper layers override lower ones key by key. Tables merge,
+ * anything else replaces whatever the layers below hold at that path.
+ *
+ * Layers are borrowed, never copied: a lookup walks the stack from the top
+ * and the winning pair is cached per path. Edits go to a table of the view's
+ * own that sits above every pushed layer.
+ */
+typedef struct {
+  XYZ_SCFTable** layers;  // bottom first
+  Uint32 layer_count;
+  Uint32 layer_cap;
+
+  // edits made through the view, NULL until the first one
+  XYZ_SCFTable* top;
+
+  // open addressing cache of resolved paths, slot_count is a power of two
+  XYZ_SCFLayerSlot* slots;
+  Uint32 slot_count;
+  Uint32 path_count;
+  XYZ_SCFArena paths;
+} XYZ_SCFLayers;
+
+void XYZ_SCFLayersInit(XYZ_SCFLayers* layers);
+
+/**
+ * Frees the edits and the cache, the pushed tables are left alone.
+ */
+void XYZ_SCFLayersDestroy(XYZ_SCFLayers* layers);
+
+/**
+ * Pushes table above the current layers, it must outlive the view and only
+ * change through it (or be followed by XYZ_SCFLayersInvalidate).
+ */
+bool XYZ_SCFLayersPush(XYZ_SCFLayers* layers, XYZ_SCFTable* table);
+
+/**
+ * Forgets every cached lookup.
+ */
+void XYZ_SCFLayersInvalidate(XYZ_SCFLayers* layers);
+
+/**
+ * Resolves a dotted path to the pair of the topmost layer that has it. layer,
+ * if not NULL, is set to its index, layer_count for edits made through the
+ * view. Tables are returned as held by the winning layer, not merged, see
+ * XYZ_SCFLayersFlatten.
+ */
+bool XYZ_SCFLayersResolve(XYZ_SCFLayers* layers,
+                          const char* path,
+                          XYZ_SCFKey* handle,
+                          Uint32* layer);
+bool XYZ_SCFLayersGet(XYZ_SCFLayers* layers,
+                      const char* path,
+                      XYZ_SCFValue* value);
+bool XYZ_SCFLayersGetBool(XYZ_SCFLayers* layers, const char* path, bool* value);
+bool XYZ_SCFLayersGetI32(XYZ_SCFLayers* layers,
+                         const char* path,
+                         Sint32* value);
+bool XYZ_SCFLayersGetF32(XYZ_SCFLayers* layers, const char* path, float* value);
+bool XYZ_SCFLayersGetStringView(XYZ_SCFLayers* layers,
+                                const char* path,
+                                const char** value,
+                                size_t* value_len);
+
+/**
+ * Sets the value at path in the edits table, which owns it from then on as
+ * with XYZ_SCFTableSet. The pushed layers are not touched.
+ */
+bool XYZ_SCFLayersSet(XYZ_SCFLayers* layers,
+                      const char* path,
+                      XYZ_SCFValue value);
+
+/**
+ * Merges every layer, edits last, into a new table allocated from arena, or
+ * from the heap when arena is NULL. Strings and tables are copied, so the
+ * result does not depend on the layers.
+ */
+XYZ_SCFTable* XYZ_SCFLayersFlatten(XYZ_SCFLayers* layers, XYZ_SCFArena* arena);
+
+#endif /* XYZ_SCF_LAYER_H */
@@ -11,14 +11,28 @@ typedef enum {
   XYZ_SCF_TOKEN_TYPE_STRING,
   XYZ_SCF_TOKEN_TYPE_PUNCT,
   XYZ_SCF_TOKEN_TYPE_WORD,
+  XYZ_SCF_TOKEN_TYPE_ERROR,  // where scanning failed, see SDL_GetError
 } XYZ_SCFTokenType;
 
+typedef enum {
+  XYZ_SCF_LEXER_KERNEL_AUTO,
+  XYZ_SCF_LEXER_KERNEL_SCALAR,
+  XYZ_SCF_LEXER_KERNEL_SSE2,
+  XYZ_SCF_LEXER_KERNEL_AVX2,
+} XYZ_SCFLexerKernel;
+
 typedef struct {
   const char* buf_start;
   const char* val_start;
   size_t buf_len;
   size_t val_len;
   XYZ_SCFTokenType type;
+
+  // position of val_start, 1-based with columns counting bytes, kept up to
+  // date while skipping blanks as tokens never span lines
+  Uint32 line;
+  Uint32 col;
+  const char* line_start;
 } XYZ_SCFToken;
 
 /**
@@ -27,8 +41,42 @@ typedef struct {
 void XYZ_SCFStartToken(XYZ_SCFToken* token, const char* src, size_t len);
 
 /**
- * Moves the val_start and val_len to the next token available in src.
+ * Moves the val_start and val_len to the next token available in src. On
+ * failure the token is left with type XYZ_SCF_TOKEN_TYPE_ERROR at the
+ * offending byte (or the start of an unterminated string).
  */
 bool XYZ_SCFNextToken(XYZ_SCFToken* token);
 
+/**
+ * Moves a token on a '{' to the '}' closing it, matching braces without
+ * lexing what is in between. Returns false, leaving the token as it is, when
+ * it is not on a '{' or a NUL byte or the end of the buffer comes first.
+ */
+bool XYZ_SCFSkipBlock(XYZ_SCFToken* token);
+
+/**
+ * Same as XYZ_SCFNextToken for input that continues past buf_len: a token cut
+ * by the end of the buffer is not ended there, instead it is returned with
+ * partial set holding the bytes seen so far.
+ */
+bool XYZ_SCFNextTokenPartial(XYZ_SCFToken* token, bool* partial);
+
+/**
+ * Same as XYZ_SCFNextToken but decoding one codepoint at a time, kept as the
+ * reference implementation for tests and benchmarks.
+ */
+bool XYZ_SCFNextTokenReference(XYZ_SCFToken* token);
+
+/**
+ * Selects the kernels XYZ_SCFNextToken uses to skip whitespace and scan
+ * string literals. AUTO (the default) picks the widest one the CPU supports,
+ * returns false if the CPU does not support the requested kernel.
+ */
+bool XYZ_SCFSetLexerKernel(XYZ_SCFLexerKernel kernel);
+
+/**
+ * Kernel currently used by XYZ_SCFNextToken, never AUTO.
+ */
+XYZ_SCFLexerKernel XYZ_SCFGetLexerKernel(void);
+
 #endif /* XYZ_SCF_LEXER_H */
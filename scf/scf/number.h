@@ -0,0 +1,21 @@
+#ifndef XYZ_SCF_NUMBER_H
+#define XYZ_SCF_NUMBER_H
+
+#include <SDL3/SDL_stdinc.h>
+
+/**
+ * Reads the decimal integer in the len bytes at str, an optional '-'
+ * followed by digits. Fails if it is malformed or does not fit in a Sint32.
+ */
+bool XYZ_SCFParseI32(const char* str, size_t len, Sint32* out);
+
+/**
+ * Reads the decimal number in the len bytes at str: an optional '-', digits
+ * with an optional '.' and an optional exponent ('e' or 'E', a sign and
+ * digits). The result is correctly rounded to the nearest float, ties to
+ * even. Fails if it is malformed or too large for a float. Values too small
+ * for a float round to zero.
+ */
+bool XYZ_SCFParseF32(const char* str, size_t len, float* out);
+
+#endif /* XYZ_SCF_NUMBER_H */
@@ -1,23 +1,117 @@
 #ifndef XYZ_SCF_PARSER_H
 #define XYZ_SCF_PARSER_H
 
+#include "error.h"
 #include "lexer.h"
+#include "schema.h"
 #include "table.h"
 
-#define XYZ_SCF_MAX_DIGITS 250
+typedef enum {
+  // keys and strings point into the parsed data instead of being copied, the
+  // data must outlive the resulting table
+  XYZ_SCF_PARSE_ZERO_COPY = 1 << 0,
+  // documents are parsed with XYZ_SCFParseTableIndexed, see index.h
+  XYZ_SCF_PARSE_INDEXED = 1 << 1,
+  // blocks are only brace matched, each one is parsed the first time it is
+  // looked into (see XYZ_SCFTableGetTable and XYZ_SCFTableCursor) and keeps
+  // its entries from then on. The data must outlive the resulting table.
+  // Ignored with a schema and by XYZ_SCFParseTableIndexed, documents use the
+  // recursive parser instead. A block that fails then stays unparsed and
+  // every look into it fails with the SDL error saying where and why. Reads
+  // change lazy tables, they are not safe to read from several threads; see
+  // XYZ_SCFConfigPublish
+  XYZ_SCF_PARSE_LAZY = 1 << 2,
+  // keys are interned in the process wide atom table (see atom.h) instead of
+  // copied into each document, documents with the same keys then share one
+  // copy and compare keys by atom. Keys interned before are looked up
+  // without a lock; a key no one interned yet takes the atom table lock, which
+  // parallel parses of new keys contend for. Ignored with
+  // XYZ_SCF_PARSE_ZERO_COPY; keys are copied once the atom table is full
+  XYZ_SCF_PARSE_INTERN_KEYS = 1 << 3,
+} XYZ_SCFParseFlags;
 
 typedef struct {
   XYZ_SCFToken cur;
+  XYZ_SCFArena* arena;  // tables, pairs and strings come from here if set
+  Uint32 flags;
+
+  // checked while parsing if set, see XYZ_SCFParseTable
+  const XYZ_SCFSchema* schema;
+  Uint32 scope;  // schema block being parsed
+  Uint32* seen;  // bit per schema field, set once the block being parsed has it
+
+  XYZ_SCFError error;  // filled in when parsing fails
 } XYZ_SCFParser;
 
+typedef struct {
+  XYZ_SCFTable* root;
+  XYZ_SCFArena* arena;  // tables, pairs and strings come from here if set
+
+  // blocks opened so far, stack[depth - 1] receives the next entry
+  XYZ_SCFTable** stack;
+  Uint32 depth;
+  size_t stack_cap;
+
+  // token cut by the end of the last chunk, completed by the next one
+  char* carry;
+  size_t carry_len;
+  size_t carry_cap;
+
+  // key of the entry being parsed, copied as its chunk may be gone
+  char* key;
+  size_t key_len;
+  size_t key_cap;
+
+  // tokens of the array being parsed, joined by spaces until its ']'
+  char* array;
+  size_t array_len;
+  size_t array_cap;
+
+  Uint8 state;  // what the next token must be
+  bool failed;
+} XYZ_SCFPushParser;
+
 /**
  * Set the parser state to the begin of given data
  */
 void XYZ_SCFParserSetFile(XYZ_SCFParser* parser, const char* data, size_t len);
 
 /**
- * Parse a file into a table
+ * Parse a file into a table. With a schema, known keys are checked as soon
+ * as their value is read: blocks must be blocks, values must have the field
+ * type and be within its range (integers are turned into floats) and nil is
+ * replaced by the default. Keys missing when their block ends are added with
+ * their default values, or fail if required. Unknown keys are kept as they
+ * are. On failure parser->error tells where and why, and the SDL error is its
+ * message prefixed with the line and column.
  */
 bool XYZ_SCFParseTable(XYZ_SCFParser* parser, XYZ_SCFTable* table);
 
+/**
+ * Starts a push parser that fills table with input given in chunks.
+ */
+void XYZ_SCFPushParserInit(XYZ_SCFPushParser* parser,
+                           XYZ_SCFTable* table,
+                           XYZ_SCFArena* arena);
+
+/**
+ * Parse the next chunk of input, chunks can be cut anywhere, even in the
+ * middle of a string or UTF-8 sequence. Entries are added to the table as
+ * soon as they are complete. Chunks are parsed without knowing where they
+ * are in the input, so push errors have no line or column.
+ */
+bool XYZ_SCFPushParserFeed(XYZ_SCFPushParser* parser,
+                           const char* data,
+                           size_t len);
+
+/**
+ * Ends the input, fails if it stopped in the middle of an entry or block.
+ */
+bool XYZ_SCFPushParserFinish(XYZ_SCFPushParser* parser);
+
+/**
+ * Releases the parser buffers, the table is left as it is.
+ */
+void XYZ_SCFPushParserDestroy(XYZ_SCFPushParser* parser);
+
 #endif /* XYZ_SCF_PARSER_H */
@@ -0,0 +1,89 @@
+#ifndef XYZ_SCF_PATH_H
+#define XYZ_SCF_PATH_H
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "table.h"
+
+#define XYZ_SCF_PATH_MAX_SEGMENTS 16
+
+typedef struct {
+  const char* key;  // points into the compiled path string
+  Uint32 key_len;
+  Uint32 hash;
+  XYZ_SCFAtom atom;  // XYZ_SCF_NO_ATOM until interned by XYZ_SCFPathIntern
+} XYZ_SCFPathSegment;
+
+/**
+ * Dotted path split and hashed once, e.g. "video.display.width". Segments
+ * point into the string it was compiled from, which must outlive it.
+ */
+typedef struct {
+  XYZ_SCFPathSegment segments[XYZ_SCF_PATH_MAX_SEGMENTS];
+  Uint32 count;
+} XYZ_SCFPath;
+
+/**
+ * Splits and hashes path, fails on empty segments or more than
+ * XYZ_SCF_PATH_MAX_SEGMENTS of them.
+ */
+bool XYZ_SCFPathCompile(XYZ_SCFPath* path, const char* str);
+
+/**
+ * Interns the segments of a compiled path, worth it for paths kept around:
+ * lookups then compare atoms against the keys of documents parsed with
+ * XYZ_SCF_PARSE_INTERN_KEYS and keys created through the path are interned
+ * too. Returns false when out of memory or the atom table is full, the path
+ * is left usable as it was.
+ */
+bool XYZ_SCFPathIntern(XYZ_SCFPath* path);
+
+/**
+ * Walks table down the path, one index probe per segment.
+ */
+bool XYZ_SCFPathResolve(XYZ_SCFTable* table,
+                        const XYZ_SCFPath* path,
+                        XYZ_SCFKey* handle);
+bool XYZ_SCFPathGet(XYZ_SCFTable* table,
+                    const XYZ_SCFPath* path,
+                    XYZ_SCFValue* value);
+
+/**
+ * Sets the value at path, creating any missing tables along the way. Fails
+ * if one of the segments before the last holds something else than a table.
+ */
+bool XYZ_SCFPathSet(XYZ_SCFTable* table,
+                    const XYZ_SCFPath* path,
+                    XYZ_SCFValue value);
+
+/**
+ * Same as the XYZ_SCFPath functions for paths given as strings, split on the
+ * fly without allocating.
+ */
+bool XYZ_SCFTableResolvePath(XYZ_SCFTable* table,
+                             const char* path,
+                             XYZ_SCFKey* handle);
+bool XYZ_SCFTableGetPath(XYZ_SCFTable* table,
+                         const char* path,
+                         XYZ_SCFValue* value);
+bool XYZ_SCFTableGetPathBool(XYZ_SCFTable* table,
+                             const char* path,
+                             bool* value);
+bool XYZ_SCFTableGetPathI32(XYZ_SCFTable* table,
+                            const char* path,
+                            Sint32* value);
+bool XYZ_SCFTableGetPathF32(XYZ_SCFTable* table,
+                            const char* path,
+                            float* value);
+bool XYZ_SCFTableGetPathStringView(XYZ_SCFTable* table,
+                                   const char* path,
+                                   const char** value,
+                                   size_t* value_len);
+bool XYZ_SCFTableGetPathTable(XYZ_SCFTable* table,
+                              const char* path,
+                              XYZ_SCFTable** value);
+bool XYZ_SCFTableSetPath(XYZ_SCFTable* table,
+                         const char* path,
+                         XYZ_SCFValue value);
+
+#endif /* XYZ_SCF_PATH_H */
@@ -1,3 +1,154 @@
 #ifndef XYZ_SCF_H
 #define XYZ_SCF_H
+
+#include <SDL3/SDL_iostream.h>
+
+#include "arena.h"
+#include "atom.h"
+#include "binary.h"
+#include "error.h"
+#include "events.h"
+#include "index.h"
+#include "layer.h"
+#include "number.h"
+#include "parser.h"
+#include "path.h"
+#include "schema.h"
+#include "table.h"
+
+typedef struct {
+  XYZ_SCFArena arena;
+  XYZ_SCFTable* root;
+
+  // file contents when loaded with XYZ_SCFLoadFile and XYZ_SCF_PARSE_ZERO_COPY
+  // or XYZ_SCF_PARSE_LAZY, kept alive (and mapped if source_mapped) for as
+  // long as the document
+  const char* source;
+  size_t source_len;
+  bool source_mapped;
+} XYZ_SCFDocument;
+
+/**
+ * Creates an empty document, the document itself, its tables, pairs, keys
+ * and strings are all allocated from the document arena.
+ */
+XYZ_SCFDocument* XYZ_SCFDocumentCreate(size_t size_hint);
+
+/**
+ * Releases the whole document tree at once.
+ */
+void XYZ_SCFDocumentDestroy(XYZ_SCFDocument* doc);
+
+/**
+ * Parse data into a new document, returns NULL on error. flags are
+ * XYZ_SCFParseFlags, with XYZ_SCF_PARSE_ZERO_COPY or XYZ_SCF_PARSE_LAZY data
+ * must outlive the document.
+ */
+XYZ_SCFDocument* XYZ_SCFParseDocument(const char* data,
+                                      size_t len,
+                                      Uint32 flags);
+
+/**
+ * Same as XYZ_SCFParseDocument, checking data against schema and adding the
+ * defaults of missing keys as it is parsed, see XYZ_SCFParseTable. Always
+ * parses sequentially with the recursive parser, XYZ_SCF_PARSE_INDEXED is
+ * ignored.
+ */
+XYZ_SCFDocument* XYZ_SCFParseDocumentWithSchema(const char* data,
+                                                size_t len,
+                                                Uint32 flags,
+                                                const XYZ_SCFSchema* schema);
+
+/**
+ * Same as XYZ_SCFParseDocument, splitting data after each top level block
+ * and parsing the pieces on up to thread_count threads (0 for one per CPU
+ * core). Entries keep their order and errors are the ones a sequential parse
+ * would report first. Small inputs, and any input with XYZ_SCF_PARSE_LAZY,
+ * are parsed sequentially.
+ */
+XYZ_SCFDocument* XYZ_SCFParseDocumentParallel(const char* data,
+                                              size_t len,
+                                              Uint32 flags,
+                                              Sint32 thread_count);
+
+/**
+ * Load and parse a file into a new document, returns NULL on error. The file
+ * is memory mapped where possible and read through SDL_IOStream otherwise.
+ * With XYZ_SCF_PARSE_ZERO_COPY or XYZ_SCF_PARSE_LAZY the contents stay alive
+ * until the document is destroyed, otherwise they are released as soon as
+ * parsing ends.
+ */
+XYZ_SCFDocument* XYZ_SCFLoadFile(const char* path, Uint32 flags);
+
+/**
+ * Parse everything left in io into a new document, returns NULL on error. The
+ * input is parsed a chunk at a time as it is read, without buffering it whole.
+ */
+XYZ_SCFDocument* XYZ_SCFParseStream(SDL_IOStream* io);
+
+typedef struct {
+  XYZ_SCFBinary binary;
+  const char* source;
+  size_t source_len;
+  bool source_mapped;
+} XYZ_SCFBinaryFile;
+
+/**
+ * Load a file written by XYZ_SCFTableWriteBinary for in place use, mapping it
+ * where possible. Returns NULL on error.
+ */
+XYZ_SCFBinaryFile* XYZ_SCFLoadBinaryFile(const char* path);
+
+/**
+ * Unmaps (or frees) the contents of a binary file.
+ */
+void XYZ_SCFBinaryFileDestroy(XYZ_SCFBinaryFile* file);
+
+typedef struct {
+  char* prefix;  // dotted path, changes at or below it are reported
+  size_t prefix_len;
+  XYZ_SCFChangeCallback callback;
+  void* userdata;
+} XYZ_SCFSubscription;
+
+typedef struct {
+  XYZ_SCFDocument* doc;  // last version parsed successfully
+  char* path;
+
+  XYZ_SCFSubscription* subscriptions;
+  Uint32 subscription_count;
+  Uint32 subscription_cap;
+
+  // inotify instance watching the directory of path on Linux, modification
+  // time of path elsewhere
+  int notify_fd;
+  const char* file_name;  // last component of path
+  Sint64 modify_time;
+} XYZ_SCFWatcher;
+
+/**
+ * Loads path and starts watching it for changes, returns NULL on error. The
+ * file is never parsed in zero copy mode, it may be rewritten at any time.
+ */
+XYZ_SCFWatcher* XYZ_SCFWatchFile(const char* path);
+
+/**
+ * Calls callback for keys added, removed or changed at or below the dotted
+ * path prefix on each reload. An empty prefix reports every change.
+ */
+bool XYZ_SCFWatcherSubscribe(XYZ_SCFWatcher* watcher,
+                             const char* prefix,
+                             XYZ_SCFChangeCallback callback,
+                             void* userdata);
+
+/**
+ * Checks for changes without blocking. If the file changed it is parsed
+ * again, subscribers are notified of the differences with the previous
+ * version and doc is replaced. On parse errors returns false and keeps the
+ * previous version.
+ */
+bool XYZ_SCFWatcherPoll(XYZ_SCFWatcher* watcher);
+
+void XYZ_SCFWatcherDestroy(XYZ_SCFWatcher* watcher);
+
 #endif /* XYZ_SCF_H */
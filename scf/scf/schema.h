@@ -0,0 +1,93 @@
+#ifndef XYZ_SCF_SCHEMA_H
+#define XYZ_SCF_SCHEMA_H
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "arena.h"
+#include "table.h"
+
+#define XYZ_SCF_SCHEMA_MAX_DEPTH 16
+
+// scope of blocks the schema does not know, none of its fields are in it
+#define XYZ_SCF_SCHEMA_NO_SCOPE SDL_MAX_UINT32
+
+typedef enum {
+  // the file must set it to something other than nil
+  XYZ_SCF_SCHEMA_FIELD_REQUIRED = 1 << 0,
+  // numbers must be at least min, at most max
+  XYZ_SCF_SCHEMA_FIELD_MIN = 1 << 1,
+  XYZ_SCF_SCHEMA_FIELD_MAX = 1 << 2,
+} XYZ_SCFSchemaFieldFlags;
+
+/**
+ * A key known at build time, generated by scf_schema from a schema file. The
+ * key belongs to the block numbered scope (0 is the top level) and its value
+ * is stored at offset in the settings struct, where the defaults are too.
+ * Blocks are of type TABLE and their own keys use block as scope.
+ */
+typedef struct {
+  const char* key;
+  Uint32 key_len;
+  Uint32 scope;
+  Uint32 block;
+  Uint32 offset;
+  XYZ_SCFValueType type;
+  Uint32 flags;  // XYZ_SCFSchemaFieldFlags
+  double min;
+  double max;
+} XYZ_SCFSchemaField;
+
+/**
+ * Minimal perfect hash over the fields of a settings struct. The bucket of a
+ * key picks a seed, the seed picks its slot in fields.
+ */
+typedef struct {
+  const XYZ_SCFSchemaField* fields;
+  const Uint32* seeds;
+  Uint32 field_count;
+  Uint32 bucket_count;
+  const void* defaults;  // settings struct holding the default values
+  size_t size;           // of the settings struct
+
+  // fields of scope s are fields[scope_fields[scope_starts[s]]] up to
+  // scope_starts[s + 1], there are scope_count + 1 starts
+  const Uint32* scope_fields;
+  const Uint32* scope_starts;
+  Uint32 scope_count;
+} XYZ_SCFSchema;
+
+/**
+ * Hash the perfect hash is built on, key_hash is XYZ_SCFHashKey of the key.
+ * The result is below range, buckets use seed 0.
+ */
+Uint32 XYZ_SCFSchemaHash(Uint32 scope,
+                         Uint32 key_hash,
+                         Uint32 seed,
+                         Uint32 range);
+
+/**
+ * Finds the field of key in the block numbered scope, NULL if it is not part
+ * of the schema. Costs one hash of the key and one string compare.
+ */
+const XYZ_SCFSchemaField* XYZ_SCFSchemaFind(const XYZ_SCFSchema* schema,
+                                            Uint32 scope,
+                                            const char* key,
+                                            size_t key_len);
+
+/**
+ * Fills the settings struct out with defaults, then with the values in data,
+ * straight from the tokens and without building pairs. Strings are
+ * allocated from arena. Keys not in the schema go to overflow, under tables
+ * named like the blocks they were found in. They are checked and dropped if
+ * overflow is NULL. Fails on syntax errors, on values of the wrong type or
+ * out of range and on missing required keys, the error gives the line and
+ * column. Integers are accepted for floats, nil leaves the default.
+ */
+bool XYZ_SCFSchemaLoad(const XYZ_SCFSchema* schema,
+                       void* out,
+                       XYZ_SCFArena* arena,
+                       const char* data,
+                       size_t len,
+                       XYZ_SCFTable* overflow);
+
+#endif /* XYZ_SCF_SCHEMA_H */
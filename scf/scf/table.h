@@ -3,8 +3,12 @@
 
 #include <SDL3/SDL_stdinc.h>
 
+#include "arena.h"
+#include "atom.h"
+
 struct XYZ_SCFTable;
 struct XYZ_SCFPair;
+struct XYZ_SCFLazyBlock;
 
 typedef enum {
   XYZ_SCF_VALUE_TYPE_NIL,
@@ -13,6 +17,12 @@ typedef enum {
   XYZ_SCF_VALUE_TYPE_F32,
   XYZ_SCF_VALUE_TYPE_STRING,
   XYZ_SCF_VALUE_TYPE_TABLE,
+  // elements packed one after the other in a single allocation, see
+  // XYZ_SCFArrayCreate
+  XYZ_SCF_VALUE_TYPE_BOOL_ARRAY,
+  XYZ_SCF_VALUE_TYPE_I32_ARRAY,
+  XYZ_SCF_VALUE_TYPE_F32_ARRAY,
+  XYZ_SCF_VALUE_TYPE_STRING_ARRAY,
 } XYZ_SCFValueType;
 
 typedef struct {
@@ -22,37 +32,288 @@ typedef struct {
     float as_f32;
     char* as_string;
     struct XYZ_SCFTable* as_table;
+    void* as_array;  // NULL for empty arrays
+    bool* as_bools;
+    Sint32* as_i32s;
+    float* as_f32s;
+    char** as_strings;  // null terminated, stored right after the pointers
+  };
+  union {
+    Uint32 str_len;  // length of as_string when set by the parser
+    Uint32 count;    // elements of an array
   };
   XYZ_SCFValueType type;
 } XYZ_SCFValue;
 
+typedef enum {
+  XYZ_SCF_PAIR_FLAG_ARENA = 1 << 0,  // pair, key and value live in an arena
+  // key and/or string value point into a caller owned buffer and are not
+  // null terminated, see key_len and str_len
+  XYZ_SCF_PAIR_FLAG_KEY_VIEW = 1 << 1,
+  XYZ_SCF_PAIR_FLAG_STRING_VIEW = 1 << 2,
+  // key is interned in the atom table instead of copied, see key_atom; left
+  // out (and the key copied) when the atom table is full
+  XYZ_SCF_PAIR_FLAG_KEY_ATOM = 1 << 3,
+} XYZ_SCFPairFlags;
+
 typedef struct XYZ_SCFPair {
-  struct XYZ_SCFPair* next;
-  struct XYZ_SCFPair* prev;
   char* key;
+  Uint32 key_len;
+  Uint32 key_hash;
+  Uint32 flags;
+  // atom of the key with XYZ_SCF_PAIR_FLAG_KEY_ATOM, key is then the interned
+  // copy; XYZ_SCF_NO_ATOM otherwise
+  XYZ_SCFAtom key_atom;
   XYZ_SCFValue value;
 } XYZ_SCFPair;
 
+typedef struct {
+  Uint32 hash;
+  Uint32 index;  // of the pair plus one, zero for an empty slot
+} XYZ_SCFSlot;
+
 typedef struct XYZ_SCFTable {
-  XYZ_SCFPair* head;
-  XYZ_SCFPair* tail;
+  // in insertion order, one after the other; pointers into it move when it
+  // grows, use XYZ_SCFKey to hold on to a pair
+  XYZ_SCFPair* pairs;
+  Uint32 pair_count;
+  Uint32 pair_cap;
+
+  // when not NULL pairs, keys and the index are allocated from here and are
+  // only released when the arena is destroyed
+  XYZ_SCFArena* arena;
+
+  // open addressing index over the pairs above, slot_count is a power of two
+  // (or zero when the index has not been built yet)
+  XYZ_SCFSlot* slots;
+  Uint32 slot_count;
+  Uint32 key_count;
+
+  // block left unparsed by XYZ_SCF_PARSE_LAZY, NULL once it has been parsed
+  struct XYZ_SCFLazyBlock* lazy;
 } XYZ_SCFTable;
 
+/**
+ * Handle to a key resolved once with XYZ_SCFTableResolve, reads and writes
+ * through it do no hashing or string compares. It stays valid across
+ * XYZ_SCFTableSet and keys added later, for as long as the table lives.
+ */
+typedef struct {
+  struct XYZ_SCFTable* table;
+  Uint32 index;
+} XYZ_SCFKey;
+
+/**
+ * Walks the pairs of a table in insertion order:
+ *
+ *   XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+ *   while (XYZ_SCFCursorNext(&cursor)) {
+ *     use(cursor.pair);
+ *   }
+ *
+ * Pairs added while walking are visited too.
+ */
+typedef struct {
+  struct XYZ_SCFTable* table;
+  Uint32 index;       // of the next pair
+  XYZ_SCFPair* pair;  // current pair, valid until the table grows
+} XYZ_SCFCursor;
+
+typedef enum {
+  XYZ_SCF_CHANGE_ADDED,
+  XYZ_SCF_CHANGE_REMOVED,
+  XYZ_SCF_CHANGE_CHANGED,
+} XYZ_SCFChangeKind;
+
+/**
+ * Called by XYZ_SCFTableDiff for each key that differs, path is the dotted
+ * path to it. old_pair is NULL for added keys and new_pair for removed ones.
+ */
+typedef void (*XYZ_SCFChangeCallback)(void* userdata,
+                                      XYZ_SCFChangeKind kind,
+                                      const char* path,
+                                      const XYZ_SCFPair* old_pair,
+                                      const XYZ_SCFPair* new_pair);
+
+/**
+ * True for the XYZ_SCF_VALUE_TYPE_*_ARRAY types.
+ */
+SDL_FORCE_INLINE bool XYZ_SCFIsArrayType(XYZ_SCFValueType type) {
+  return type >= XYZ_SCF_VALUE_TYPE_BOOL_ARRAY &&
+         type <= XYZ_SCF_VALUE_TYPE_STRING_ARRAY;
+}
+
+/**
+ * Hash used by the table index (32-bit FNV-1a).
+ */
+Uint32 XYZ_SCFHashKey(const char* key, size_t key_len);
+
 XYZ_SCFTable* XYZ_SCFTableCreate();
+XYZ_SCFTable* XYZ_SCFTableCreateWithArena(XYZ_SCFArena* arena);
 void XYZ_SCFTableDestroy(XYZ_SCFTable* table);
 XYZ_SCFPair* XYZ_SCFPairCreate(const char* key,
                                size_t key_len,
                                XYZ_SCFValue value);
+XYZ_SCFPair* XYZ_SCFPairCreateWithArena(XYZ_SCFArena* arena,
+                                        const char* key,
+                                        size_t key_len,
+                                        XYZ_SCFValue value);
+XYZ_SCFPair* XYZ_SCFPairCreateWithFlags(XYZ_SCFArena* arena,
+                                        const char* key,
+                                        size_t key_len,
+                                        XYZ_SCFValue value,
+                                        Uint32 flags);
 void XYZ_SCFPairDestroy(XYZ_SCFPair* pair);
+size_t XYZ_SCFPairStringLen(const XYZ_SCFPair* pair);
 bool XYZ_SCFTableHas(XYZ_SCFTable* table, const char* key);
-void XYZ_SCFTableAdd(XYZ_SCFTable* table, XYZ_SCFPair* pair);
+
+/**
+ * Finds the pair of a key that needs not be null terminated, hash must be
+ * XYZ_SCFHashKey of it. Returns NULL if the table does not have it.
+ */
+XYZ_SCFPair* XYZ_SCFTableFind(XYZ_SCFTable* table,
+                              const char* key,
+                              size_t key_len,
+                              Uint32 hash);
+
+/**
+ * Same as XYZ_SCFTableFind for an interned key. Pairs with interned keys are
+ * matched by comparing atoms, without looking at the keys.
+ */
+XYZ_SCFPair* XYZ_SCFTableFindAtom(XYZ_SCFTable* table, XYZ_SCFAtom atom);
+
+/**
+ * Moves pair into the table, the pair itself is freed (or left in its arena)
+ * and its key and value are owned by the table from then on. Returns where
+ * the pair ended up, or NULL when out of memory and pair is left untouched.
+ */
+XYZ_SCFPair* XYZ_SCFTableAdd(XYZ_SCFTable* table, XYZ_SCFPair* pair);
+
+/**
+ * Appends a pair made from key and value, see XYZ_SCFPairCreateWithFlags.
+ * Same as creating the pair and adding it but without allocating the pair
+ * on its own. Returns NULL when out of memory, value is then not taken.
+ */
+XYZ_SCFPair* XYZ_SCFTableAppend(XYZ_SCFTable* table,
+                                const char* key,
+                                size_t key_len,
+                                XYZ_SCFValue value,
+                                Uint32 flags);
+
+/**
+ * Parses table if it is a block left unparsed by XYZ_SCF_PARSE_LAZY, true
+ * when there is nothing left to parse. A block that fails stays unparsed and
+ * fails again with the same parse error on every call.
+ */
+bool XYZ_SCFTableExpand(XYZ_SCFTable* table);
+
+/**
+ * Number of pairs and a cursor over them, both parse a lazy block first. A
+ * block that fails to parse has no pairs to them; walkers that must not
+ * mistake it for an empty block call XYZ_SCFTableExpand first.
+ */
+Uint32 XYZ_SCFTableCount(XYZ_SCFTable* table);
+XYZ_SCFCursor XYZ_SCFTableCursor(XYZ_SCFTable* table);
+XYZ_SCFKey XYZ_SCFCursorKey(const XYZ_SCFCursor* cursor);
+
+/**
+ * Moves to the next pair, returns false past the last one. Inline as it runs
+ * once per pair, a call costs more than the step itself.
+ */
+SDL_FORCE_INLINE bool XYZ_SCFCursorNext(XYZ_SCFCursor* cursor) {
+  if (cursor->index >= cursor->table->pair_count) {
+    cursor->pair = NULL;
+    return false;
+  }
+
+  cursor->pair = &cursor->table->pairs[cursor->index++];
+  return true;
+}
+
 bool XYZ_SCFTableSet(XYZ_SCFTable* table, const char* key, XYZ_SCFValue value);
 bool XYZ_SCFTableGet(XYZ_SCFTable* table, const char* key, XYZ_SCFValue* value);
 bool XYZ_SCFTableGetBool(XYZ_SCFTable* table, const char* key, bool* value);
 bool XYZ_SCFTableGetI32(XYZ_SCFTable* table, const char* key, Sint32* value);
 bool XYZ_SCFTableGetF32(XYZ_SCFTable* table, const char* key, float* value);
 bool XYZ_SCFTableGetString(XYZ_SCFTable* table, const char* key, char** value);
+bool XYZ_SCFTableGetStringView(XYZ_SCFTable* table,
+                               const char* key,
+                               const char** value,
+                               size_t* value_len);
+
+/**
+ * Gets the table at key, parsing it first if it is a block left unparsed by
+ * XYZ_SCF_PARSE_LAZY; fails with the parse error if that does.
+ */
 bool XYZ_SCFTableGetTable(XYZ_SCFTable* table,
                           const char* key,
                           XYZ_SCFTable** value);
+
+/**
+ * Makes an array of type from count items, which are bool, Sint32, float or
+ * const char* to match it. Items are copied into a single allocation from
+ * arena, or the heap when it is NULL, that the table the value ends up in
+ * owns. Returns false when out of memory.
+ */
+bool XYZ_SCFArrayCreate(XYZ_SCFArena* arena,
+                        XYZ_SCFValueType type,
+                        const void* items,
+                        Uint32 count,
+                        XYZ_SCFValue* value);
+
+/**
+ * Bulk getters for arrays, values points at the packed elements in the
+ * table (NULL for empty arrays) and is valid for as long as the pair is. An
+ * empty array "[]" has no element type and is read by any of them.
+ */
+bool XYZ_SCFTableGetBoolArray(XYZ_SCFTable* table,
+                              const char* key,
+                              const bool** values,
+                              size_t* count);
+bool XYZ_SCFTableGetI32Array(XYZ_SCFTable* table,
+                             const char* key,
+                             const Sint32** values,
+                             size_t* count);
+bool XYZ_SCFTableGetF32Array(XYZ_SCFTable* table,
+                             const char* key,
+                             const float** values,
+                             size_t* count);
+bool XYZ_SCFTableGetStringArray(XYZ_SCFTable* table,
+                                const char* key,
+                                const char* const** values,
+                                size_t* count);
+
+/**
+ * Resolves key into a handle, returns false if the table does not have it.
+ */
+bool XYZ_SCFTableResolve(XYZ_SCFTable* table,
+                         const char* key,
+                         XYZ_SCFKey* handle);
+XYZ_SCFPair* XYZ_SCFKeyPair(XYZ_SCFKey key);
+XYZ_SCFValue* XYZ_SCFKeyValue(XYZ_SCFKey key);
+void XYZ_SCFKeySet(XYZ_SCFKey key, XYZ_SCFValue value);
+bool XYZ_SCFKeyGetBool(XYZ_SCFKey key, bool* value);
+bool XYZ_SCFKeyGetI32(XYZ_SCFKey key, Sint32* value);
+bool XYZ_SCFKeyGetF32(XYZ_SCFKey key, float* value);
+bool XYZ_SCFKeyGetStringView(XYZ_SCFKey key,
+                             const char** value,
+                             size_t* value_len);
+bool XYZ_SCFKeyGetTable(XYZ_SCFKey key, XYZ_SCFTable** value);
+
+/**
+ * Deep comparison of two tables: same keys holding equal values, in any order.
+ * Also false, with the parse error, if a lazy block of either fails to parse.
+ */
+bool XYZ_SCFTableEqual(XYZ_SCFTable* a, XYZ_SCFTable* b);
+
+/**
+ * Structural diff of two tables, walking into tables present in both. Keys
+ * whose value is a table on one side only are reported as a whole. Lazy
+ * blocks are all parsed first. Returns false if one of them fails to parse or
+ * it runs out of memory.
+ */
+bool XYZ_SCFTableDiff(XYZ_SCFTable* old_table,
+                      XYZ_SCFTable* new_table,
+                      XYZ_SCFChangeCallback callback,
+                      void* userdata);
 #endif /* XYZ_SCF_TABLE_H */
@@ -0,0 +1,23 @@
+#ifndef XYZ_SCF_WRITER_H
+#define XYZ_SCF_WRITER_H
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include "table.h"
+
+#define XYZ_SCF_WRITER_INDENT 2
+
+/**
+ * Serializes table as text XYZ_SCFParseTable accepts into a newly allocated
+ * null terminated string, release it with SDL_free. Returns NULL on error,
+ * e.g. keys that are not identifiers or strings holding quotes or new lines.
+ */
+char* XYZ_SCFTableToString(XYZ_SCFTable* table, size_t* out_len);
+
+/**
+ * Serializes table as text into io, buffered into a single write.
+ */
+bool XYZ_SCFTableWrite(XYZ_SCFTable* table, SDL_IOStream* io);
+
+#endif /* XYZ_SCF_WRITER_H */
@@ -1,3 +1,355 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
 #include <cmocka.h>
+// clang-format on
 
-int main() {}
+#include <scf/scf.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_iostream.h>
+
+#define TEST_FILE "scf_test_load.scf"
+
+static void write_file(const char* path, const char* data) {
+  SDL_IOStream* io = SDL_IOFromFile(path, "wb");
+  assert_non_null(io);
+  size_t len = SDL_strlen(data);
+  assert_int_equal(SDL_WriteIO(io, data, len), len);
+  assert_true(SDL_CloseIO(io));
+}
+
+static void document_parse(void** state) {
+  (void)state;
+
+  const char* src = "name = \"player\" video { width = 1280 height = 720 }";
+  XYZ_SCFDocument* doc = XYZ_SCFParseDocument(src, SDL_strlen(src), 0);
+  assert_non_null(doc);
+  assert_non_null(doc->root);
+
+  char* name = NULL;
+  assert_true(XYZ_SCFTableGetString(doc->root, "name", &name));
+  assert_string_equal(name, "player");
+
+  XYZ_SCFTable* video = NULL;
+  Sint32 width = 0;
+  assert_true(XYZ_SCFTableGetTable(doc->root, "video", &video));
+  assert_true(XYZ_SCFTableGetI32(video, "width", &width));
+  assert_int_equal(width, 1280);
+
+  // a small document fits in the first arena block
+  assert_non_null(doc->arena.head);
+  assert_null(doc->arena.head->next);
+
+  XYZ_SCFDocumentDestroy(doc);
+}
+
+static void document_parse_error(void** state) {
+  (void)state;
+
+  const char* src = "video { width = }";
+  assert_null(XYZ_SCFParseDocument(src, SDL_strlen(src), 0));
+}
+
+static void document_zero_copy(void** state) {
+  (void)state;
+
+  const char* src = "name = \"player\" video { width = 1280 }";
+  XYZ_SCFDocument* doc =
+      XYZ_SCFParseDocument(src, SDL_strlen(src), XYZ_SCF_PARSE_ZERO_COPY);
+  assert_non_null(doc);
+
+  const char* name = NULL;
+  size_t name_len = 0;
+  assert_true(XYZ_SCFTableGetStringView(doc->root, "name", &name, &name_len));
+  assert_memory_equal(name, "player", name_len);
+  assert_ptr_equal(name, src + 8);
+
+  XYZ_SCFDocumentDestroy(doc);
+}
+
+static void document_set(void** state) {
+  (void)state;
+
+  XYZ_SCFDocument* doc = XYZ_SCFDocumentCreate(0);
+  assert_non_null(doc);
+
+  char key[32] = {0};
+  for (Sint32 i = 0; i < 1000; i++) {
+    SDL_snprintf(key, sizeof(key), "key%d", i);
+    XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = i};
+    assert_true(XYZ_SCFTableSet(doc->root, key, value));
+  }
+
+  Sint32 got = 0;
+  assert_true(XYZ_SCFTableGetI32(doc->root, "key999", &got));
+  assert_int_equal(got, 999);
+  assert_true(doc->root->pairs[0].flags & XYZ_SCF_PAIR_FLAG_ARENA);
+
+  XYZ_SCFDocumentDestroy(doc);
+}
+
+static void load_file(void** state) {
+  (void)state;
+
+  write_file(TEST_FILE, "audio {\n  volume = 0.5\n  device = \"default\"\n}\n");
+
+  XYZ_SCFDocument* doc = XYZ_SCFLoadFile(TEST_FILE, 0);
+  assert_non_null(doc);
+  assert_null(doc->source);
+
+  XYZ_SCFTable* audio = NULL;
+  char* device = NULL;
+  assert_true(XYZ_SCFTableGetTable(doc->root, "audio", &audio));
+  assert_true(XYZ_SCFTableGetString(audio, "device", &device));
+  assert_string_equal(device, "default");
+  XYZ_SCFDocumentDestroy(doc);
+
+  // zero copy keeps the contents alive with the document
+  doc = XYZ_SCFLoadFile(TEST_FILE, XYZ_SCF_PARSE_ZERO_COPY);
+  assert_non_null(doc);
+  assert_non_null(doc->source);
+
+  const char* view = NULL;
+  size_t view_len = 0;
+  assert_true(XYZ_SCFTableGetTable(doc->root, "audio", &audio));
+  assert_true(XYZ_SCFTableGetStringView(audio, "device", &view, &view_len));
+  assert_true(view > doc->source && view < doc->source + doc->source_len);
+  assert_memory_equal(view, "default", view_len);
+  XYZ_SCFDocumentDestroy(doc);
+
+  // so do lazy blocks, which are parsed from them on first use
+  doc = XYZ_SCFLoadFile(TEST_FILE, XYZ_SCF_PARSE_LAZY);
+  assert_non_null(doc);
+  assert_non_null(doc->source);
+  assert_true(XYZ_SCFTableGetTable(doc->root, "audio", &audio));
+  assert_true(XYZ_SCFTableGetString(audio, "device", &device));
+  assert_string_equal(device, "default");
+  XYZ_SCFDocumentDestroy(doc);
+
+  write_file(TEST_FILE, "");
+  doc = XYZ_SCFLoadFile(TEST_FILE, 0);
+  assert_non_null(doc);
+  assert_int_equal(XYZ_SCFTableCount(doc->root), 0);
+  XYZ_SCFDocumentDestroy(doc);
+
+  SDL_RemovePath(TEST_FILE);
+  assert_null(XYZ_SCFLoadFile(TEST_FILE, 0));
+}
+
+static void load_binary_file(void** state) {
+  (void)state;
+
+  const char* src = "video { width = 1280 title = \"game\" }";
+  XYZ_SCFDocument* doc = XYZ_SCFParseDocument(src, SDL_strlen(src), 0);
+  assert_non_null(doc);
+
+  SDL_IOStream* io = SDL_IOFromFile(TEST_FILE, "wb");
+  assert_non_null(io);
+  assert_true(XYZ_SCFTableWriteBinary(doc->root, io));
+  assert_true(SDL_CloseIO(io));
+  XYZ_SCFDocumentDestroy(doc);
+
+  XYZ_SCFBinaryFile* file = XYZ_SCFLoadBinaryFile(TEST_FILE);
+  assert_non_null(file);
+
+  XYZ_SCFBinaryTable video = {0};
+  const char* title = NULL;
+  assert_true(
+      XYZ_SCFBinaryGetTable(XYZ_SCFBinaryRoot(&file->binary), "video", &video));
+  assert_true(XYZ_SCFBinaryGetString(video, "title", &title));
+  assert_string_equal(title, "game");
+  XYZ_SCFBinaryFileDestroy(file);
+
+  // text is not a binary config
+  write_file(TEST_FILE, src);
+  assert_null(XYZ_SCFLoadBinaryFile(TEST_FILE));
+  SDL_RemovePath(TEST_FILE);
+}
+
+static char* generate(size_t cap, size_t* len) {
+  char* src = SDL_malloc(cap);
+  assert_non_null(src);
+  *len = 0;
+  for (Sint32 i = 0; *len + 128 < cap; i++) {
+    *len += SDL_snprintf(src + *len, cap - *len,
+                         "entry_%d { value = %d scale = %d.5 "
+                         "name = \"entry {number} %d\" }\n"
+                         "top_%d = %d\n",
+                         i, i, i, i, i, i);
+  }
+  return src;
+}
+
+static void parse_stream(void** state) {
+  (void)state;
+
+  // big enough to span several reads
+  size_t len = 0;
+  char* src = generate(64 * 1024, &len);
+
+  SDL_IOStream* io = SDL_IOFromConstMem(src, len);
+  assert_non_null(io);
+  XYZ_SCFDocument* streamed = XYZ_SCFParseStream(io);
+  assert_true(SDL_CloseIO(io));
+  assert_non_null(streamed);
+
+  XYZ_SCFDocument* doc = XYZ_SCFParseDocument(src, len, 0);
+  assert_non_null(doc);
+  assert_true(XYZ_SCFTableEqual(doc->root, streamed->root));
+
+  XYZ_SCFDocumentDestroy(doc);
+  XYZ_SCFDocumentDestroy(streamed);
+
+  const char* bad = "video { width = 1280";
+  io = SDL_IOFromConstMem(bad, SDL_strlen(bad));
+  assert_null(XYZ_SCFParseStream(io));
+  assert_true(SDL_CloseIO(io));
+  SDL_free(src);
+}
+
+typedef struct {
+  Sint32 calls;
+  char last[64];
+} watch_log;
+
+static void watch_record(void* userdata,
+                         XYZ_SCFChangeKind kind,
+                         const char* path,
+                         const XYZ_SCFPair* old_pair,
+                         const XYZ_SCFPair* new_pair) {
+  (void)kind;
+  (void)old_pair;
+  (void)new_pair;
+  watch_log* log = userdata;
+  log->calls++;
+  SDL_strlcpy(log->last, path, sizeof(log->last));
+}
+
+static void watch_file(void** state) {
+  (void)state;
+
+  write_file(TEST_FILE, "audio { volume = 5 } video { width = 1280 }");
+  XYZ_SCFWatcher* watcher = XYZ_SCFWatchFile(TEST_FILE);
+  assert_non_null(watcher);
+
+  watch_log all = {0};
+  watch_log audio = {0};
+  watch_log video = {0};
+  assert_true(XYZ_SCFWatcherSubscribe(watcher, "", watch_record, &all));
+  assert_true(XYZ_SCFWatcherSubscribe(watcher, "audio", watch_record, &audio));
+  assert_true(
+      XYZ_SCFWatcherSubscribe(watcher, "video.width", watch_record, &video));
+
+  // nothing changed yet
+  assert_true(XYZ_SCFWatcherPoll(watcher));
+  assert_int_equal(all.calls, 0);
+
+  write_file(TEST_FILE, "audio { volume = 7 } video { width = 1280 }");
+  assert_true(XYZ_SCFWatcherPoll(watcher));
+  assert_int_equal(all.calls, 1);
+  assert_int_equal(audio.calls, 1);
+  assert_string_equal(audio.last, "audio.volume");
+  assert_int_equal(video.calls, 0);
+
+  Sint32 volume = 0;
+  assert_true(XYZ_SCFTableGetPathI32(watcher->doc->root, "audio.volume",
+                                     &volume));
+  assert_int_equal(volume, 7);
+
+  // replacing the whole table reaches subscribers below it
+  write_file(TEST_FILE, "audio { volume = 7 } video = nil");
+  assert_true(XYZ_SCFWatcherPoll(watcher));
+  assert_int_equal(video.calls, 1);
+  assert_string_equal(video.last, "video");
+
+  // broken files keep the last good version
+  write_file(TEST_FILE, "audio { volume = }");
+  assert_false(XYZ_SCFWatcherPoll(watcher));
+  assert_true(XYZ_SCFTableGetPathI32(watcher->doc->root, "audio.volume",
+                                     &volume));
+  assert_int_equal(all.calls, 2);
+
+  XYZ_SCFWatcherDestroy(watcher);
+  SDL_RemovePath(TEST_FILE);
+}
+
+static void document_parallel(void** state) {
+  (void)state;
+
+  size_t len = 0;
+  char* src = generate(1024 * 1024, &len);
+  XYZ_SCFDocument* expected = XYZ_SCFParseDocument(src, len, 0);
+  assert_non_null(expected);
+
+  const Sint32 threads[] = {0, 1, 2, 3, 8};
+  for (size_t i = 0; i < SDL_arraysize(threads); i++) {
+    XYZ_SCFDocument* doc = XYZ_SCFParseDocumentParallel(
+        src, len, XYZ_SCF_PARSE_ZERO_COPY, threads[i]);
+    assert_non_null(doc);
+    assert_true(XYZ_SCFTableEqual(expected->root, doc->root));
+
+    // in the same order too
+    assert_int_equal(XYZ_SCFTableCount(expected->root),
+                     XYZ_SCFTableCount(doc->root));
+    for (Uint32 j = 0; j < doc->root->pair_count; j++) {
+      XYZ_SCFPair* want = &expected->root->pairs[j];
+      XYZ_SCFPair* got = &doc->root->pairs[j];
+      assert_int_equal(want->key_len, got->key_len);
+      assert_memory_equal(want->key, got->key, want->key_len);
+    }
+
+    // blocks of every piece can still grow once the pieces are gone
+    const char* blocks[] = {"entry_0", "entry_4000", "entry_8000"};
+    for (size_t j = 0; j < SDL_arraysize(blocks); j++) {
+      XYZ_SCFTable* entry = NULL;
+      assert_true(XYZ_SCFTableGetTable(doc->root, blocks[j], &entry));
+      for (Sint32 k = 0; k < 32; k++) {
+        char key[32];
+        SDL_snprintf(key, sizeof(key), "extra_%d", k);
+        XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = k};
+        assert_true(XYZ_SCFTableSet(entry, key, value));
+      }
+      Sint32 extra = 0;
+      assert_true(XYZ_SCFTableGetI32(entry, "extra_31", &extra));
+      assert_int_equal(extra, 31);
+    }
+    XYZ_SCFDocumentDestroy(doc);
+  }
+  XYZ_SCFDocumentDestroy(expected);
+
+  // the error reported is the first one, as in a sequential parse
+  char* first = SDL_strstr(src + len / 3, "value = ");
+  char* second = SDL_strstr(src + 2 * len / 3, "value = ");
+  first[6] = '{';
+  second[0] = '=';
+  assert_null(XYZ_SCFParseDocument(src, len, 0));
+  char error[256] = {0};
+  SDL_strlcpy(error, SDL_GetError(), sizeof(error));
+  for (size_t i = 0; i < SDL_arraysize(threads); i++) {
+    SDL_SetError("none");
+    assert_null(XYZ_SCFParseDocumentParallel(src, len, 0, threads[i]));
+    assert_string_equal(SDL_GetError(), error);
+  }
+
+  SDL_free(src);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(document_parse),
+      cmocka_unit_test(document_parse_error),
+      cmocka_unit_test(document_zero_copy),
+      cmocka_unit_test(document_set),
+      cmocka_unit_test(load_file),
+      cmocka_unit_test(load_binary_file),
+      cmocka_unit_test(parse_stream),
+      cmocka_unit_test(watch_file),
+      cmocka_unit_test(document_parallel),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,459 @@
+#include "scf/schema.h"
+#include "scf/lexer.h"
+#include "scf/parser.h"
+#include "scf/table.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+
+// shared with parser.c so unknown entries and values read the same as they
+// would in a table
+XYZ_SCFPair* parse_entry(XYZ_SCFParser* parser, XYZ_SCFTable* table);
+bool parse_value(XYZ_SCFParser* parser, XYZ_SCFValue* value);
+// store value in the struct member of field
+void schema_store(const XYZ_SCFSchemaField* field,
+                  void* out,
+                  const XYZ_SCFValue* value);
+// overflow table of the blocks open at depth, created on first use
+XYZ_SCFTable* schema_spill(XYZ_SCFTable** spill,
+                           const XYZ_SCFSchemaField** blocks,
+                           Uint32 depth,
+                           XYZ_SCFArena* arena);
+
+// shared with error.c, records where parsing failed
+bool error_at(XYZ_SCFError* error,
+              const XYZ_SCFToken* token,
+              Uint32 expected,
+              const char* fmt,
+              ...);
+
+// shared with parser.c, which checks tables with the same rules
+//
+// check the type and range of a value read at token, integers are turned
+// into floats; nil passes unless the field is required
+bool schema_check(const XYZ_SCFSchemaField* field,
+                  XYZ_SCFValue* value,
+                  const XYZ_SCFToken* token,
+                  XYZ_SCFError* error);
+// default value of field, strings are copied and blocks are empty tables
+bool schema_default(const XYZ_SCFSchema* schema,
+                    const XYZ_SCFSchemaField* field,
+                    XYZ_SCFArena* arena,
+                    XYZ_SCFValue* value);
+// forget the fields of scope seen so far, as a block of it starts
+void schema_clear(const XYZ_SCFSchema* schema, Uint32* seen, Uint32 scope);
+void schema_mark(const XYZ_SCFSchema* schema,
+                 Uint32* seen,
+                 const XYZ_SCFSchemaField* field);
+// a block of scope ended at token: fail if it misses required fields, add
+// the defaults of the others to table if not NULL
+bool schema_complete(const XYZ_SCFSchema* schema,
+                     Uint32* seen,
+                     Uint32 scope,
+                     XYZ_SCFTable* table,
+                     XYZ_SCFArena* arena,
+                     const XYZ_SCFToken* token,
+                     XYZ_SCFError* error);
+
+static const char* schema_type_names[] = {
+    [XYZ_SCF_VALUE_TYPE_NIL] = "nil",
+    [XYZ_SCF_VALUE_TYPE_BOOL] = "a bool",
+    [XYZ_SCF_VALUE_TYPE_I32] = "an integer",
+    [XYZ_SCF_VALUE_TYPE_F32] = "a float",
+    [XYZ_SCF_VALUE_TYPE_STRING] = "a string",
+    [XYZ_SCF_VALUE_TYPE_TABLE] = "a block",
+    [XYZ_SCF_VALUE_TYPE_BOOL_ARRAY] = "an array of bools",
+    [XYZ_SCF_VALUE_TYPE_I32_ARRAY] = "an array of integers",
+    [XYZ_SCF_VALUE_TYPE_F32_ARRAY] = "an array of floats",
+    [XYZ_SCF_VALUE_TYPE_STRING_ARRAY] = "an array of strings",
+};
+
+Uint32 XYZ_SCFSchemaHash(Uint32 scope,
+                         Uint32 key_hash,
+                         Uint32 seed,
+                         Uint32 range) {
+  // murmur3 finalizer, so nearby scopes and seeds land far apart
+  Uint32 h = key_hash ^ (scope * 0x9e3779b9u) ^ (seed * 0x85ebca6bu);
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+
+  // scaled down with a multiply instead of a division
+  return (Uint32)(((Uint64)h * range) >> 32);
+}
+
+const XYZ_SCFSchemaField* XYZ_SCFSchemaFind(const XYZ_SCFSchema* schema,
+                                            Uint32 scope,
+                                            const char* key,
+                                            size_t key_len) {
+  SDL_assert(schema != NULL && "XYZ_SCFSchemaFind: schema cannot be NULL");
+  SDL_assert((key != NULL || key_len == 0) &&
+             "XYZ_SCFSchemaFind: key cannot be NULL");
+
+  if (schema->field_count == 0) {
+    return NULL;
+  }
+
+  Uint32 key_hash = XYZ_SCFHashKey(key, key_len);
+  Uint32 bucket = XYZ_SCFSchemaHash(scope, key_hash, 0, schema->bucket_count);
+  Uint32 slot = XYZ_SCFSchemaHash(scope, key_hash, schema->seeds[bucket],
+                                  schema->field_count);
+
+  // every key lands somewhere, only the one stored there is known
+  const XYZ_SCFSchemaField* field = &schema->fields[slot];
+  if (field->scope != scope || field->key_len != key_len ||
+      SDL_memcmp(field->key, key, key_len) != 0) {
+    return NULL;
+  }
+  return field;
+}
+
+bool XYZ_SCFSchemaLoad(const XYZ_SCFSchema* schema,
+                       void* out,
+                       XYZ_SCFArena* arena,
+                       const char* data,
+                       size_t len,
+                       XYZ_SCFTable* overflow) {
+  SDL_assert(schema != NULL && "XYZ_SCFSchemaLoad: schema cannot be NULL");
+  SDL_assert(out != NULL && "XYZ_SCFSchemaLoad: out cannot be NULL");
+  SDL_assert(arena != NULL && "XYZ_SCFSchemaLoad: arena cannot be NULL");
+  SDL_assert((data != NULL || len == 0) &&
+             "XYZ_SCFSchemaLoad: data cannot be NULL");
+
+  SDL_memcpy(out, schema->defaults, schema->size);
+  Uint32* seen = XYZ_SCFArenaAlloc(
+      arena, (schema->field_count / 32 + 1) * sizeof(Uint32));
+  if (seen == NULL) {
+    return false;
+  }
+  schema_clear(schema, seen, 0);
+
+  // an empty file still has to have the required keys
+  XYZ_SCFParser parser = {.arena = arena};
+  if (len == 0) {
+    XYZ_SCFToken eof = {.buf_start = "", .val_start = "", .line = 1, .col = 1};
+    return schema_complete(schema, seen, 0, NULL, arena, &eof, &parser.error);
+  }
+
+  // the lexer leaves an error token where it fails, which error_at reports
+  XYZ_SCFParserSetFile(&parser, data, len);
+  if (!XYZ_SCFNextToken(&parser.cur)) {
+    return error_at(&parser.error, &parser.cur, 0, "%s", SDL_GetError());
+  }
+
+  // known blocks open so far and the overflow tables of each depth, NULL
+  // until an unknown key shows up in them
+  const XYZ_SCFSchemaField* blocks[XYZ_SCF_SCHEMA_MAX_DEPTH] = {0};
+  XYZ_SCFTable* spill[XYZ_SCF_SCHEMA_MAX_DEPTH + 1] = {overflow};
+  Uint32 depth = 0;
+  while (true) {
+    XYZ_SCFToken key = parser.cur;
+    Uint32 scope = depth > 0 ? blocks[depth - 1]->block : 0;
+    if (key.type == XYZ_SCF_TOKEN_TYPE_EOF) {
+      if (depth > 0) {
+        return error_at(&parser.error, &key,
+                        XYZ_SCF_EXPECT_KEY | XYZ_SCF_EXPECT_BLOCK_END,
+                        "was expecting end of block '}' but found end of "
+                        "file");
+      }
+      return schema_complete(schema, seen, 0, NULL, arena, &key,
+                             &parser.error);
+    }
+
+    if (depth > 0 && key.type == XYZ_SCF_TOKEN_TYPE_PUNCT &&
+        *key.val_start == '}') {
+      if (!schema_complete(schema, seen, scope, NULL, arena, &key,
+                           &parser.error)) {
+        return false;
+      }
+
+      depth--;
+      if (!XYZ_SCFNextToken(&parser.cur)) {
+        return error_at(&parser.error, &parser.cur, 0, "%s",
+                        SDL_GetError());
+      }
+      continue;
+    }
+
+    if (key.type != XYZ_SCF_TOKEN_TYPE_WORD) {
+      Uint32 expected = XYZ_SCF_EXPECT_KEY;
+      expected |= depth > 0 ? XYZ_SCF_EXPECT_BLOCK_END : XYZ_SCF_EXPECT_EOF;
+      return error_at(&parser.error, &key, expected,
+                      "was expecting identifier but found: '%.*s'",
+                      (Sint32)key.val_len, key.val_start);
+    }
+
+    const XYZ_SCFSchemaField* field =
+        XYZ_SCFSchemaFind(schema, scope, key.val_start, key.val_len);
+    if (field == NULL) {
+      // without an overflow table the entry is parsed into one that is
+      // dropped, its pairs stay behind in the arena
+      XYZ_SCFTable skipped = {.arena = arena};
+      XYZ_SCFTable* table = &skipped;
+      if (overflow != NULL) {
+        table = schema_spill(spill, blocks, depth, arena);
+        if (table == NULL) {
+          return false;
+        }
+      }
+
+      if (parse_entry(&parser, table) == NULL) {
+        return false;
+      }
+      continue;
+    }
+
+    if (!XYZ_SCFNextToken(&parser.cur)) {
+      return error_at(&parser.error, &parser.cur, 0, "%s", SDL_GetError());
+    }
+
+    XYZ_SCFToken op = parser.cur;
+    bool punct = op.type == XYZ_SCF_TOKEN_TYPE_PUNCT;
+    if (!punct || (*op.val_start != '{' && *op.val_start != '=')) {
+      return error_at(&parser.error, &op,
+                      XYZ_SCF_EXPECT_ASSIGN | XYZ_SCF_EXPECT_BLOCK,
+                      "was expecting assign '=' or block '{' but found: '%.*s'",
+                      (Sint32)op.val_len, op.val_start);
+    }
+
+    if (!XYZ_SCFNextToken(&parser.cur)) {
+      return error_at(&parser.error, &parser.cur, 0, "%s", SDL_GetError());
+    }
+
+    if (*op.val_start == '{') {
+      if (field->type != XYZ_SCF_VALUE_TYPE_TABLE) {
+        return error_at(&parser.error, &op, 0,
+                        "key '%.*s' expects %s but found a block",
+                        (Sint32)field->key_len, field->key,
+                        schema_type_names[field->type]);
+      }
+
+      // scf_schema rejects schemas nested deeper than this
+      SDL_assert(depth < XYZ_SCF_SCHEMA_MAX_DEPTH &&
+                 "XYZ_SCFSchemaLoad: schema nested too deep");
+      schema_mark(schema, seen, field);
+      schema_clear(schema, seen, field->block);
+      blocks[depth] = field;
+      spill[++depth] = NULL;
+      continue;
+    }
+
+    XYZ_SCFToken value_token = parser.cur;
+    XYZ_SCFValue value = {0};
+    if (!parse_value(&parser, &value)) {
+      return false;
+    }
+
+    if (!schema_check(field, &value, &value_token, &parser.error)) {
+      return false;
+    }
+
+    // nil keeps the default
+    if (value.type != XYZ_SCF_VALUE_TYPE_NIL) {
+      schema_mark(schema, seen, field);
+      schema_store(field, out, &value);
+    }
+  }
+}
+
+bool schema_check(const XYZ_SCFSchemaField* field,
+                  XYZ_SCFValue* value,
+                  const XYZ_SCFToken* token,
+                  XYZ_SCFError* error) {
+  if (value->type == XYZ_SCF_VALUE_TYPE_NIL) {
+    if (field->flags & XYZ_SCF_SCHEMA_FIELD_REQUIRED) {
+      return error_at(error, token, 0,
+                      "key '%.*s' is required and cannot be nil",
+                      (Sint32)field->key_len, field->key);
+    }
+    return true;
+  }
+
+  if (field->type == XYZ_SCF_VALUE_TYPE_F32 &&
+      value->type == XYZ_SCF_VALUE_TYPE_I32) {
+    value->type = XYZ_SCF_VALUE_TYPE_F32;
+    value->as_f32 = (float)value->as_i32;
+  }
+
+  if (value->type != field->type) {
+    return error_at(error, token, 0, "key '%.*s' expects %s but found %s",
+                    (Sint32)field->key_len, field->key,
+                    schema_type_names[field->type],
+                    schema_type_names[value->type]);
+  }
+
+  double number = value->type == XYZ_SCF_VALUE_TYPE_I32
+                      ? (double)value->as_i32
+                      : (double)value->as_f32;
+  if ((field->flags & XYZ_SCF_SCHEMA_FIELD_MIN) && number < field->min) {
+    return error_at(error, token, 0, "key '%.*s' must be at least %.9g",
+                    (Sint32)field->key_len, field->key, field->min);
+  }
+  if ((field->flags & XYZ_SCF_SCHEMA_FIELD_MAX) && number > field->max) {
+    return error_at(error, token, 0, "key '%.*s' must be at most %.9g",
+                    (Sint32)field->key_len, field->key, field->max);
+  }
+  return true;
+}
+
+bool schema_default(const XYZ_SCFSchema* schema,
+                    const XYZ_SCFSchemaField* field,
+                    XYZ_SCFArena* arena,
+                    XYZ_SCFValue* value) {
+  const Uint8* member = (const Uint8*)schema->defaults + field->offset;
+  value->type = field->type;
+  switch (field->type) {
+    case XYZ_SCF_VALUE_TYPE_BOOL:
+      SDL_memcpy(&value->as_bool, member, sizeof(bool));
+      break;
+    case XYZ_SCF_VALUE_TYPE_I32:
+      SDL_memcpy(&value->as_i32, member, sizeof(Sint32));
+      break;
+    case XYZ_SCF_VALUE_TYPE_F32:
+      SDL_memcpy(&value->as_f32, member, sizeof(float));
+      break;
+    case XYZ_SCF_VALUE_TYPE_STRING: {
+      const char* str = NULL;
+      SDL_memcpy(&str, member, sizeof(str));
+      size_t str_len = SDL_strlen(str);
+      value->as_string = arena != NULL ? XYZ_SCFArenaAlloc(arena, str_len + 1)
+                                       : SDL_malloc(str_len + 1);
+      if (value->as_string == NULL) {
+        return false;
+      }
+      SDL_memcpy(value->as_string, str, str_len + 1);
+      value->str_len = (Uint32)str_len;
+      break;
+    }
+    case XYZ_SCF_VALUE_TYPE_TABLE:
+      value->as_table = XYZ_SCFTableCreateWithArena(arena);
+      return value->as_table != NULL;
+    default:
+      break;
+  }
+  return true;
+}
+
+void schema_clear(const XYZ_SCFSchema* schema, Uint32* seen, Uint32 scope) {
+  for (Uint32 i = schema->scope_starts[scope];
+       i < schema->scope_starts[scope + 1]; i++) {
+    Uint32 slot = schema->scope_fields[i];
+    seen[slot / 32] &= ~(1u << (slot % 32));
+  }
+}
+
+void schema_mark(const XYZ_SCFSchema* schema,
+                 Uint32* seen,
+                 const XYZ_SCFSchemaField* field) {
+  Uint32 slot = (Uint32)(field - schema->fields);
+  seen[slot / 32] |= 1u << (slot % 32);
+}
+
+bool schema_complete(const XYZ_SCFSchema* schema,
+                     Uint32* seen,
+                     Uint32 scope,
+                     XYZ_SCFTable* table,
+                     XYZ_SCFArena* arena,
+                     const XYZ_SCFToken* token,
+                     XYZ_SCFError* error) {
+  if (scope >= schema->scope_count) {
+    return true;  // blocks the schema does not know
+  }
+
+  for (Uint32 i = schema->scope_starts[scope];
+       i < schema->scope_starts[scope + 1]; i++) {
+    Uint32 slot = schema->scope_fields[i];
+    if (seen[slot / 32] & (1u << (slot % 32))) {
+      continue;
+    }
+
+    const XYZ_SCFSchemaField* field = &schema->fields[slot];
+    if (field->flags & XYZ_SCF_SCHEMA_FIELD_REQUIRED) {
+      return error_at(error, token, 0, "missing required key '%.*s'",
+                      (Sint32)field->key_len, field->key);
+    }
+
+    // a missing block is a block with nothing in it
+    XYZ_SCFValue value = {0};
+    if (table != NULL && !schema_default(schema, field, arena, &value)) {
+      return false;
+    }
+    if (field->type == XYZ_SCF_VALUE_TYPE_TABLE) {
+      schema_clear(schema, seen, field->block);
+      if (!schema_complete(schema, seen, field->block, value.as_table, arena,
+                           token, error)) {
+        return false;
+      }
+    }
+
+    if (table != NULL) {
+      // keys are the generated constants, no need to copy them
+      if (XYZ_SCFTableAppend(table, field->key, field->key_len, value,
+                             XYZ_SCF_PAIR_FLAG_KEY_VIEW) == NULL) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void schema_store(const XYZ_SCFSchemaField* field,
+                  void* out,
+                  const XYZ_SCFValue* value) {
+  Uint8* member = (Uint8*)out + field->offset;
+  switch (field->type) {
+    case XYZ_SCF_VALUE_TYPE_BOOL:
+      SDL_memcpy(member, &value->as_bool, sizeof(bool));
+      break;
+    case XYZ_SCF_VALUE_TYPE_I32:
+      SDL_memcpy(member, &value->as_i32, sizeof(Sint32));
+      break;
+    case XYZ_SCF_VALUE_TYPE_F32:
+      SDL_memcpy(member, &value->as_f32, sizeof(float));
+      break;
+    case XYZ_SCF_VALUE_TYPE_STRING: {
+      const char* str = value->as_string;
+      SDL_memcpy(member, &str, sizeof(str));
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+XYZ_SCFTable* schema_spill(XYZ_SCFTable** spill,
+                           const XYZ_SCFSchemaField** blocks,
+                           Uint32 depth,
+                           XYZ_SCFArena* arena) {
+  // a block seen again reuses the table made for it the first time
+  for (Uint32 d = 1; d <= depth; d++) {
+    if (spill[d] != NULL) {
+      continue;
+    }
+
+    const XYZ_SCFSchemaField* block = blocks[d - 1];
+    XYZ_SCFPair* pair =
+        XYZ_SCFTableFind(spill[d - 1], block->key, block->key_len,
+                         XYZ_SCFHashKey(block->key, block->key_len));
+    if (pair != NULL && pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+      spill[d] = pair->value.as_table;
+      continue;
+    }
+
+    XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_TABLE};
+    value.as_table = XYZ_SCFTableCreateWithArena(arena);
+    if (value.as_table == NULL) {
+      return NULL;
+    }
+
+    if (XYZ_SCFTableAppend(spill[d - 1], block->key, block->key_len, value,
+                           0) == NULL) {
+      return NULL;
+    }
+    spill[d] = value.as_table;
+  }
+  return spill[depth];
+}
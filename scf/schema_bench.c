@@ -0,0 +1,122 @@
+#include <scf/scf.h>
+#include <scf/schema.h>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+#include "settings.h"
+
+#define BENCH_LOADS 100000
+#define BENCH_READS 10000000
+#define BENCH_ROUNDS 5
+
+// a settings file touching every key, plus a few the schema does not know
+static const char bench_settings[] =
+    "title = \"SimpleConfig\"\nvolume = 0.5\n"
+    "display {\n  width = 2560\n  height = 1440\n  fullscreen = true\n"
+    "  scale = 1.25\n  monitor = \"left\"\n}\n"
+    "video {\n  vsync = false\n  max_fps = 240\n  gamma = 2.4\n"
+    "  renderer = \"metal\"\n}\n"
+    "audio {\n  device = \"default\"\n  music = 0.3\n  effects = 0.9\n"
+    "  channels = 6\n}\n"
+    "gameplay {\n  difficulty = 3\n  language = \"de\"\n  controls {\n"
+    "    invert_y = true\n    sensitivity = 0.75\n    deadzone = 0.1\n"
+    "  }\n}\n"
+    "mods {\n  enabled = true\n}\n";
+
+int main(void) {
+  size_t len = sizeof(bench_settings) - 1;
+  double times[5] = {0};
+  Sint64 sum = 0;
+  for (Sint32 round = 0; round < BENCH_ROUNDS; round++) {
+    double elapsed[5] = {0};
+
+    // baseline: a document, then one path lookup per setting read
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_LOADS; i++) {
+      XYZ_SCFDocument* doc = XYZ_SCFParseDocument(bench_settings, len, 0);
+      if (doc == NULL) {
+        return 1;
+      }
+      Sint32 width = 0;
+      XYZ_SCFTableGetPathI32(doc->root, "display.width", &width);
+      sum += width;
+      XYZ_SCFDocumentDestroy(doc);
+    }
+    elapsed[0] = bench_elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_LOADS; i++) {
+      XYZ_SCFArena arena = {0};
+      XYZ_SCFArenaInit(&arena, len);
+      XYZ_SCFTable* overflow = XYZ_SCFTableCreateWithArena(&arena);
+      settings out = {0};
+      if (!settings_load(&out, &arena, bench_settings, len, overflow)) {
+        return 1;
+      }
+      sum += out.display.width;
+      XYZ_SCFArenaDestroy(&arena);
+    }
+    elapsed[1] = bench_elapsed(start);
+
+    // tables again, checked and completed with defaults as they are parsed
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_LOADS; i++) {
+      XYZ_SCFDocument* doc = XYZ_SCFParseDocumentWithSchema(
+          bench_settings, len, 0, &settings_schema);
+      if (doc == NULL) {
+        return 1;
+      }
+      Sint32 width = 0;
+      XYZ_SCFTableGetPathI32(doc->root, "display.width", &width);
+      sum += width;
+      XYZ_SCFDocumentDestroy(doc);
+    }
+    elapsed[4] = bench_elapsed(start);
+
+    XYZ_SCFDocument* doc = XYZ_SCFParseDocument(bench_settings, len, 0);
+    XYZ_SCFArena arena = {0};
+    XYZ_SCFArenaInit(&arena, len);
+    settings out = {0};
+    if (doc == NULL ||
+        !settings_load(&out, &arena, bench_settings, len, NULL)) {
+      return 1;
+    }
+
+    // reads as a frame loop does them, volatile so they are not hoisted
+    settings* volatile current = &out;
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_READS; i++) {
+      Sint32 value = 0;
+      XYZ_SCFTableGetPathI32(doc->root,
+                             i & 1 ? "display.width" : "video.max_fps",
+                             &value);
+      sum += value;
+    }
+    elapsed[2] = bench_elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_READS; i++) {
+      settings* cur = current;
+      sum += i & 1 ? cur->display.width : cur->video.max_fps;
+    }
+    elapsed[3] = bench_elapsed(start);
+
+    XYZ_SCFArenaDestroy(&arena);
+    XYZ_SCFDocumentDestroy(doc);
+    for (Sint32 i = 0; i < 5; i++) {
+      times[i] = round == 0 ? elapsed[i] : SDL_min(times[i], elapsed[i]);
+    }
+  }
+
+  SDL_Log("load: document %7.0f ns, checked document %7.0f ns, "
+          "struct %7.0f ns",
+          times[0] * 1e9 / BENCH_LOADS, times[4] * 1e9 / BENCH_LOADS,
+          times[1] * 1e9 / BENCH_LOADS);
+  SDL_Log("read: path     %7.2f ns, field  %7.2f ns (%lld)",
+          times[2] * 1e9 / BENCH_READS, times[3] * 1e9 / BENCH_READS,
+          (long long)sum);
+  return 0;
+}
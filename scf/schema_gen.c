@@ -0,0 +1,640 @@
+// scf_schema: compiles a schema file into a settings struct and the perfect
+// hash XYZ_SCFSchemaLoad fills it with.
+//
+//   scf_schema <schema.scf> <name> <out.h> <out.c>
+//
+// The schema is a config file whose values are the defaults, their types
+// are the types of the fields. Blocks become nested structs, except blocks
+// with a default key which describe one field:
+//
+//   width { default = 1280 min = 320 max = 7680 required = false }
+#include <scf/scf.h>
+#include <scf/schema.h>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+// seeds tried per bucket before giving up on the bucket count
+#define GEN_MAX_SEED 1000000
+
+typedef struct {
+  const XYZ_SCFPair* pair;
+  const XYZ_SCFValue* value;  // the default
+  Uint32 flags;               // XYZ_SCFSchemaFieldFlags
+  double min;
+  double max;
+  char* path;  // dotted member path from the settings struct
+  char* type;  // struct type of blocks
+  Uint32 key_hash;
+  Uint32 scope;
+  Uint32 block;
+  Uint32 slot;
+} gen_field;
+
+typedef struct {
+  gen_field* fields;
+  Uint32 count;
+  Uint32 cap;
+  Uint32 block_count;
+  const char* name;
+} gen_schema;
+
+typedef struct {
+  char* data;
+  size_t len;
+  size_t cap;
+} gen_buffer;
+
+// collect the fields of table and the blocks below it, depth first
+bool gen_collect(gen_schema* schema,
+                 XYZ_SCFTable* table,
+                 Uint32 scope,
+                 Uint32 depth,
+                 const char* path,
+                 const char* type);
+// read a field given as a block of default, min, max and required
+bool gen_spec(gen_field* field, XYZ_SCFTable* spec);
+// find seeds for every bucket and the slot of every field
+bool gen_hash(gen_schema* schema, Uint32 bucket_count, Uint32* seeds);
+bool gen_keyword(const char* key);
+void gen_printf(gen_buffer* buf, const char* fmt, ...);
+void gen_indent(gen_buffer* buf, Uint32 depth);
+// struct definitions, blocks before the structs holding them
+void gen_structs(gen_buffer* buf, gen_schema* schema, Uint32 scope);
+// designated initializers of the fields in scope
+void gen_defaults(gen_buffer* buf,
+                  gen_schema* schema,
+                  Uint32 scope,
+                  Uint32 depth);
+void gen_string(gen_buffer* buf, const char* str, size_t len);
+const char* gen_c_type(const gen_field* field);
+bool gen_write(const char* path, const gen_buffer* buf);
+
+static const char* gen_keywords[] = {
+    "auto",     "bool",     "break",    "case",          "char",
+    "const",    "continue", "default",  "do",            "double",
+    "else",     "enum",     "extern",   "false",         "float",
+    "for",      "goto",     "if",       "inline",        "int",
+    "long",     "register", "restrict", "return",        "short",
+    "signed",   "sizeof",   "static",   "struct",        "switch",
+    "true",     "typedef",  "union",    "unsigned",      "void",
+    "volatile", "while",    "_Bool",    "_Static_assert", "NULL",
+};
+
+static const char* gen_value_types[] = {
+    [XYZ_SCF_VALUE_TYPE_BOOL] = "XYZ_SCF_VALUE_TYPE_BOOL",
+    [XYZ_SCF_VALUE_TYPE_I32] = "XYZ_SCF_VALUE_TYPE_I32",
+    [XYZ_SCF_VALUE_TYPE_F32] = "XYZ_SCF_VALUE_TYPE_F32",
+    [XYZ_SCF_VALUE_TYPE_STRING] = "XYZ_SCF_VALUE_TYPE_STRING",
+    [XYZ_SCF_VALUE_TYPE_TABLE] = "XYZ_SCF_VALUE_TYPE_TABLE",
+};
+
+int main(int argc, char** argv) {
+  if (argc != 5) {
+    SDL_Log("usage: scf_schema <schema.scf> <name> <out.h> <out.c>");
+    return 1;
+  }
+
+  const char* name = argv[2];
+  bool identifier = !SDL_isdigit((unsigned char)name[0]);
+  for (const char* c = name; *c != '\0'; c++) {
+    identifier = identifier && (SDL_isalpha((unsigned char)*c) ||
+                                SDL_isdigit((unsigned char)*c) || *c == '_');
+  }
+  if (!identifier || name[0] == '\0' || gen_keyword(name)) {
+    SDL_Log("scf_schema: '%s' is not a valid C identifier", name);
+    return 1;
+  }
+
+  XYZ_SCFDocument* doc = XYZ_SCFLoadFile(argv[1], 0);
+  if (doc == NULL) {
+    SDL_Log("%s: %s", argv[1], SDL_GetError());
+    return 1;
+  }
+
+  gen_schema schema = {.name = name};
+  if (!gen_collect(&schema, doc->root, 0, 0, "", name)) {
+    SDL_Log("%s: %s", argv[1], SDL_GetError());
+    return 1;
+  }
+
+  // about two keys per bucket, more buckets if some bucket cannot be placed
+  Uint32 bucket_count = schema.count / 2 + 1;
+  Uint32* seeds = NULL;
+  while (true) {
+    seeds = SDL_realloc(seeds, bucket_count * sizeof(Uint32));
+    if (seeds == NULL) {
+      return 1;
+    }
+    if (gen_hash(&schema, bucket_count, seeds)) {
+      break;
+    }
+    bucket_count *= 2;
+  }
+
+  gen_buffer header = {0};
+  gen_printf(&header, "// generated by scf_schema from %s, do not edit\n",
+             argv[1]);
+  char* guard = SDL_strdup(name);
+  if (guard == NULL) {
+    return 1;
+  }
+  for (char* c = guard; *c != '\0'; c++) {
+    *c = (char)SDL_toupper((unsigned char)*c);
+  }
+  gen_printf(&header, "#ifndef %s_H\n#define %s_H\n\n", guard, guard);
+  gen_printf(&header, "#include <scf/schema.h>\n\n");
+  gen_structs(&header, &schema, 0);
+  gen_printf(&header, "extern const XYZ_SCFSchema %s_schema;\n\n", name);
+  gen_printf(&header,
+             "/**\n * Loads data into out, see XYZ_SCFSchemaLoad.\n */\n");
+  gen_printf(&header,
+             "bool %s_load(%s* out,\n    XYZ_SCFArena* arena,\n"
+             "    const char* data,\n    size_t len,\n"
+             "    XYZ_SCFTable* overflow);\n\n",
+             name, name);
+  gen_printf(&header, "#endif /* %s_H */\n", guard);
+  SDL_free(guard);
+
+  const char* header_name = SDL_strrchr(argv[3], '/');
+  header_name = header_name != NULL ? header_name + 1 : argv[3];
+
+  gen_buffer source = {0};
+  gen_printf(&source, "// generated by scf_schema from %s, do not edit\n",
+             argv[1]);
+  gen_printf(&source, "#include \"%s\"\n\n#include <stddef.h>\n\n",
+             header_name);
+  gen_printf(&source, "static const %s %s_defaults = {\n", name, name);
+  gen_defaults(&source, &schema, 0, 1);
+  gen_printf(&source, "};\n\n");
+
+  // fields are stored in the slots the hash sends their keys to
+  gen_printf(&source, "static const XYZ_SCFSchemaField %s_fields[] = {\n",
+             name);
+  for (Uint32 slot = 0; slot < schema.count; slot++) {
+    for (Uint32 i = 0; i < schema.count; i++) {
+      gen_field* field = &schema.fields[i];
+      if (field->slot != slot) {
+        continue;
+      }
+      gen_printf(&source,
+                 "    {\"%s\", %u, %u, %u, offsetof(%s, %s), %s, %u, %.17g, "
+                 "%.17g},\n",
+                 field->pair->key, field->pair->key_len, field->scope,
+                 field->block, name, field->path,
+                 gen_value_types[field->value->type], field->flags,
+                 field->min, field->max);
+    }
+  }
+  if (schema.count == 0) {
+    gen_printf(&source, "    {0},\n");
+  }
+  gen_printf(&source, "};\n\n");
+
+  // slots of each scope in turn, for defaults and required keys
+  gen_printf(&source, "static const Uint32 %s_scope_fields[] = {", name);
+  Uint32 listed = 0;
+  for (Uint32 scope = 0; scope <= schema.block_count; scope++) {
+    for (Uint32 i = 0; i < schema.count; i++) {
+      if (schema.fields[i].scope == scope) {
+        gen_printf(&source, "%s%u,", listed++ % 8 == 0 ? "\n    " : " ",
+                   schema.fields[i].slot);
+      }
+    }
+  }
+  gen_printf(&source, "%s\n};\n\n", schema.count == 0 ? "\n    0," : "");
+
+  gen_printf(&source, "static const Uint32 %s_scope_starts[] = {", name);
+  listed = 0;
+  for (Uint32 scope = 0; scope <= schema.block_count + 1; scope++) {
+    gen_printf(&source, "%s%u,", scope % 8 == 0 ? "\n    " : " ", listed);
+    for (Uint32 i = 0; i < schema.count; i++) {
+      listed += schema.fields[i].scope == scope;
+    }
+  }
+  gen_printf(&source, "\n};\n\n");
+
+  gen_printf(&source, "static const Uint32 %s_seeds[] = {", name);
+  for (Uint32 i = 0; i < bucket_count; i++) {
+    gen_printf(&source, "%s%u,", i % 8 == 0 ? "\n    " : " ", seeds[i]);
+  }
+  gen_printf(&source, "\n};\n\n");
+
+  gen_printf(&source, "const XYZ_SCFSchema %s_schema = {\n", name);
+  gen_printf(&source, "    .fields = %s_fields,\n", name);
+  gen_printf(&source, "    .seeds = %s_seeds,\n", name);
+  gen_printf(&source, "    .field_count = %u,\n", schema.count);
+  gen_printf(&source, "    .bucket_count = %u,\n", bucket_count);
+  gen_printf(&source, "    .defaults = &%s_defaults,\n", name);
+  gen_printf(&source, "    .size = sizeof(%s),\n", name);
+  gen_printf(&source, "    .scope_fields = %s_scope_fields,\n", name);
+  gen_printf(&source, "    .scope_starts = %s_scope_starts,\n", name);
+  gen_printf(&source, "    .scope_count = %u,\n};\n\n",
+             schema.block_count + 1);
+
+  gen_printf(&source,
+             "bool %s_load(%s* out,\n    XYZ_SCFArena* arena,\n"
+             "    const char* data,\n    size_t len,\n"
+             "    XYZ_SCFTable* overflow) {\n",
+             name, name);
+  gen_printf(&source,
+             "  return XYZ_SCFSchemaLoad(&%s_schema, out, arena, data, len, "
+             "overflow);\n}\n",
+             name);
+
+  if (header.data == NULL || source.data == NULL) {
+    SDL_Log("scf_schema: out of memory");
+    return 1;
+  }
+
+  if (!gen_write(argv[3], &header) || !gen_write(argv[4], &source)) {
+    SDL_Log("scf_schema: %s", SDL_GetError());
+    return 1;
+  }
+
+  for (Uint32 i = 0; i < schema.count; i++) {
+    SDL_free(schema.fields[i].path);
+    SDL_free(schema.fields[i].type);
+  }
+  SDL_free(schema.fields);
+  SDL_free(seeds);
+  SDL_free(header.data);
+  SDL_free(source.data);
+  XYZ_SCFDocumentDestroy(doc);
+  return 0;
+}
+
+bool gen_collect(gen_schema* schema,
+                 XYZ_SCFTable* table,
+                 Uint32 scope,
+                 Uint32 depth,
+                 const char* path,
+                 const char* type) {
+  if (depth >= XYZ_SCF_SCHEMA_MAX_DEPTH) {
+    return SDL_SetError("blocks nested deeper than %d",
+                        XYZ_SCF_SCHEMA_MAX_DEPTH);
+  }
+
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    const XYZ_SCFPair* pair = cursor.pair;
+    if (gen_keyword(pair->key)) {
+      return SDL_SetError("key '%s' is a C keyword", pair->key);
+    }
+
+    if (XYZ_SCFTableFind(table, pair->key, pair->key_len, pair->key_hash) !=
+        pair) {
+      return SDL_SetError("key '%s' is defined twice", pair->key);
+    }
+
+    if (pair->value.type == XYZ_SCF_VALUE_TYPE_NIL) {
+      return SDL_SetError("key '%s' has no default to take its type from",
+                          pair->key);
+    }
+
+    // settings structs have no array members, same as in gen_spec
+    if (XYZ_SCFIsArrayType(pair->value.type)) {
+      return SDL_SetError("key '%s' is an array, settings cannot be arrays",
+                          pair->key);
+    }
+
+    if (schema->count == schema->cap) {
+      Uint32 cap = schema->cap == 0 ? 16 : schema->cap * 2;
+      gen_field* fields =
+          SDL_realloc(schema->fields, cap * sizeof(gen_field));
+      if (fields == NULL) {
+        return false;
+      }
+      schema->fields = fields;
+      schema->cap = cap;
+    }
+
+    gen_field* field = &schema->fields[schema->count++];
+    SDL_zerop(field);
+    field->pair = pair;
+    field->value = &pair->value;
+    if (pair->value.type == XYZ_SCF_VALUE_TYPE_TABLE &&
+        XYZ_SCFTableHas(pair->value.as_table, "default") &&
+        !gen_spec(field, pair->value.as_table)) {
+      return false;
+    }
+    field->key_hash = XYZ_SCFHashKey(pair->key, pair->key_len);
+    field->scope = scope;
+    if (SDL_asprintf(&field->path, "%s%s%s", path, depth > 0 ? "." : "",
+                     pair->key) < 0) {
+      return false;
+    }
+
+    if (field->value->type == XYZ_SCF_VALUE_TYPE_TABLE) {
+      Uint32 index = schema->count - 1;
+      field->block = ++schema->block_count;
+      if (SDL_asprintf(&field->type, "%s_%s", type, pair->key) < 0) {
+        return false;
+      }
+
+      // the array moves as it grows, pass copies
+      char* block_path = SDL_strdup(field->path);
+      char* block_type = SDL_strdup(field->type);
+      bool collected = block_path != NULL && block_type != NULL &&
+                       gen_collect(schema, pair->value.as_table,
+                                   schema->fields[index].block, depth + 1,
+                                   block_path, block_type);
+      SDL_free(block_path);
+      SDL_free(block_type);
+      if (!collected) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool gen_spec(gen_field* field, XYZ_SCFTable* spec) {
+  const char* key = field->pair->key;
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(spec);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    const XYZ_SCFPair* pair = cursor.pair;
+    XYZ_SCFValueType type = pair->value.type;
+    if (SDL_strcmp(pair->key, "default") == 0) {
+      // settings structs have no array members
+      if (type == XYZ_SCF_VALUE_TYPE_NIL || type == XYZ_SCF_VALUE_TYPE_TABLE ||
+          XYZ_SCFIsArrayType(type)) {
+        return SDL_SetError("default of key '%s' must be a value", key);
+      }
+      field->value = &pair->value;
+    } else if (SDL_strcmp(pair->key, "required") == 0) {
+      if (type != XYZ_SCF_VALUE_TYPE_BOOL) {
+        return SDL_SetError("required of key '%s' must be a bool", key);
+      }
+      if (pair->value.as_bool) {
+        field->flags |= XYZ_SCF_SCHEMA_FIELD_REQUIRED;
+      }
+    } else if (SDL_strcmp(pair->key, "min") == 0 ||
+               SDL_strcmp(pair->key, "max") == 0) {
+      if (type != XYZ_SCF_VALUE_TYPE_I32 && type != XYZ_SCF_VALUE_TYPE_F32) {
+        return SDL_SetError("%s of key '%s' must be a number", pair->key, key);
+      }
+      double bound = type == XYZ_SCF_VALUE_TYPE_I32 ? pair->value.as_i32
+                                                    : pair->value.as_f32;
+      if (SDL_strcmp(pair->key, "min") == 0) {
+        field->min = bound;
+        field->flags |= XYZ_SCF_SCHEMA_FIELD_MIN;
+      } else {
+        field->max = bound;
+        field->flags |= XYZ_SCF_SCHEMA_FIELD_MAX;
+      }
+    } else {
+      return SDL_SetError("unknown '%s' in key '%s', expected default, min, "
+                          "max or required",
+                          pair->key, key);
+    }
+  }
+
+  Uint32 range = XYZ_SCF_SCHEMA_FIELD_MIN | XYZ_SCF_SCHEMA_FIELD_MAX;
+  if (!(field->flags & range)) {
+    return true;
+  }
+
+  const XYZ_SCFValue* value = field->value;
+  if (value->type != XYZ_SCF_VALUE_TYPE_I32 &&
+      value->type != XYZ_SCF_VALUE_TYPE_F32) {
+    return SDL_SetError("key '%s' has a range but is not a number", key);
+  }
+
+  double number = value->type == XYZ_SCF_VALUE_TYPE_I32 ? value->as_i32
+                                                        : value->as_f32;
+  bool has_min = field->flags & XYZ_SCF_SCHEMA_FIELD_MIN;
+  bool has_max = field->flags & XYZ_SCF_SCHEMA_FIELD_MAX;
+  if ((has_min && number < field->min) || (has_max && number > field->max)) {
+    return SDL_SetError("default of key '%s' is out of its range", key);
+  }
+  return true;
+}
+
+bool gen_hash(gen_schema* schema, Uint32 bucket_count, Uint32* seeds) {
+  Uint32 count = schema->count;
+  Uint32* buckets = SDL_calloc(count + 1, sizeof(Uint32));
+  Uint32* sizes = SDL_calloc(bucket_count, sizeof(Uint32));
+  bool* taken = SDL_calloc(count + 1, sizeof(bool));
+  Uint32* slots = SDL_calloc(count + 1, sizeof(Uint32));
+  bool placed = buckets != NULL && sizes != NULL && taken != NULL &&
+                slots != NULL;
+  for (Uint32 i = 0; placed && i < count; i++) {
+    gen_field* field = &schema->fields[i];
+    buckets[i] =
+        XYZ_SCFSchemaHash(field->scope, field->key_hash, 0, bucket_count);
+    sizes[buckets[i]]++;
+  }
+  SDL_memset(seeds, 0, bucket_count * sizeof(Uint32));
+
+  // largest buckets first, while most slots are still free
+  for (Uint32 size = count; placed && size > 0; size--) {
+    for (Uint32 b = 0; placed && b < bucket_count; b++) {
+      if (sizes[b] != size) {
+        continue;
+      }
+
+      placed = false;
+      for (Uint32 seed = 1; !placed && seed <= GEN_MAX_SEED; seed++) {
+        Uint32 used = 0;
+        placed = true;
+        for (Uint32 i = 0; placed && i < count; i++) {
+          if (buckets[i] != b) {
+            continue;
+          }
+
+          gen_field* field = &schema->fields[i];
+          Uint32 slot =
+              XYZ_SCFSchemaHash(field->scope, field->key_hash, seed, count);
+          placed = !taken[slot];
+          for (Uint32 j = 0; placed && j < used; j++) {
+            placed = slots[j] != slot;
+          }
+          slots[used++] = slot;
+        }
+
+        if (placed) {
+          seeds[b] = seed;
+          for (Uint32 j = 0; j < used; j++) {
+            taken[slots[j]] = true;
+          }
+        }
+      }
+    }
+  }
+
+  for (Uint32 i = 0; placed && i < count; i++) {
+    gen_field* field = &schema->fields[i];
+    field->slot = XYZ_SCFSchemaHash(field->scope, field->key_hash,
+                                    seeds[buckets[i]], count);
+  }
+
+  SDL_free(buckets);
+  SDL_free(sizes);
+  SDL_free(taken);
+  SDL_free(slots);
+  return placed;
+}
+
+bool gen_keyword(const char* key) {
+  for (size_t i = 0; i < SDL_arraysize(gen_keywords); i++) {
+    if (SDL_strcmp(key, gen_keywords[i]) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void gen_printf(gen_buffer* buf, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  char* text = NULL;
+  Sint32 len = SDL_vasprintf(&text, fmt, args);
+  va_end(args);
+  if (len < 0) {
+    return;
+  }
+
+  if (buf->len + len + 1 > buf->cap) {
+    size_t cap = SDL_max(buf->cap * 2, buf->len + len + 1);
+    char* data = SDL_realloc(buf->data, cap);
+    if (data == NULL) {
+      SDL_free(text);
+      return;
+    }
+    buf->data = data;
+    buf->cap = cap;
+  }
+
+  SDL_memcpy(buf->data + buf->len, text, len + 1);
+  buf->len += len;
+  SDL_free(text);
+}
+
+void gen_indent(gen_buffer* buf, Uint32 depth) {
+  for (Uint32 i = 0; i < depth; i++) {
+    gen_printf(buf, "    ");
+  }
+}
+
+void gen_structs(gen_buffer* buf, gen_schema* schema, Uint32 scope) {
+  for (Uint32 i = 0; i < schema->count; i++) {
+    gen_field* field = &schema->fields[i];
+    if (field->scope == scope && field->block != 0) {
+      gen_structs(buf, schema, field->block);
+    }
+  }
+
+  const char* type = schema->name;
+  for (Uint32 i = 0; i < schema->count; i++) {
+    if (schema->fields[i].block == scope && scope != 0) {
+      type = schema->fields[i].type;
+    }
+  }
+
+  gen_printf(buf, "typedef struct {\n");
+  bool empty = true;
+  for (Uint32 i = 0; i < schema->count; i++) {
+    gen_field* field = &schema->fields[i];
+    if (field->scope == scope) {
+      gen_printf(buf, "  %s %s;\n", gen_c_type(field),
+                 field->pair->key);
+      empty = false;
+    }
+  }
+  if (empty) {
+    gen_printf(buf, "  char unused;  // C has no empty structs\n");
+  }
+  gen_printf(buf, "} %s;\n\n", type);
+}
+
+void gen_defaults(gen_buffer* buf,
+                  gen_schema* schema,
+                  Uint32 scope,
+                  Uint32 depth) {
+  for (Uint32 i = 0; i < schema->count; i++) {
+    gen_field* field = &schema->fields[i];
+    if (field->scope != scope) {
+      continue;
+    }
+
+    const XYZ_SCFValue* value = field->value;
+    gen_indent(buf, depth);
+    gen_printf(buf, ".%s = ", field->pair->key);
+    switch (value->type) {
+      case XYZ_SCF_VALUE_TYPE_BOOL:
+        gen_printf(buf, "%s", value->as_bool ? "true" : "false");
+        break;
+      case XYZ_SCF_VALUE_TYPE_I32:
+        // the smallest integer has no literal of its own type
+        if (value->as_i32 == SDL_MIN_SINT32) {
+          gen_printf(buf, "-2147483647 - 1");
+        } else {
+          gen_printf(buf, "%d", value->as_i32);
+        }
+        break;
+      case XYZ_SCF_VALUE_TYPE_F32: {
+        // 9 significant digits always read back as the same float
+        char digits[32];
+        SDL_snprintf(digits, sizeof(digits), "%.9g", value->as_f32);
+        bool point =
+            SDL_strchr(digits, '.') != NULL || SDL_strchr(digits, 'e') != NULL;
+        gen_printf(buf, "%s%sf", digits, point ? "" : ".0");
+        break;
+      }
+      case XYZ_SCF_VALUE_TYPE_STRING:
+        gen_string(buf, value->as_string, value->str_len);
+        break;
+      case XYZ_SCF_VALUE_TYPE_TABLE:
+        gen_printf(buf, "{\n");
+        gen_defaults(buf, schema, field->block, depth + 1);
+        gen_indent(buf, depth);
+        gen_printf(buf, "}");
+        break;
+      default:
+        break;
+    }
+    gen_printf(buf, ",\n");
+  }
+}
+
+void gen_string(gen_buffer* buf, const char* str, size_t len) {
+  // octal escapes for anything that could end the literal or is not ASCII
+  gen_printf(buf, "\"");
+  for (size_t i = 0; i < len; i++) {
+    Uint8 c = (Uint8)str[i];
+    if (c < 0x20 || c >= 0x7f || c == '"' || c == '\\' || c == '?') {
+      gen_printf(buf, "\\%03o", c);
+    } else {
+      gen_printf(buf, "%c", c);
+    }
+  }
+  gen_printf(buf, "\"");
+}
+
+const char* gen_c_type(const gen_field* field) {
+  switch (field->value->type) {
+    case XYZ_SCF_VALUE_TYPE_BOOL:
+      return "bool";
+    case XYZ_SCF_VALUE_TYPE_I32:
+      return "Sint32";
+    case XYZ_SCF_VALUE_TYPE_F32:
+      return "float";
+    case XYZ_SCF_VALUE_TYPE_STRING:
+      return "const char*";
+    default:
+      return field->type;
+  }
+}
+
+bool gen_write(const char* path, const gen_buffer* buf) {
+  SDL_IOStream* io = SDL_IOFromFile(path, "wb");
+  if (io == NULL) {
+    return false;
+  }
+
+  bool written = SDL_WriteIO(io, buf->data, buf->len) == buf->len;
+  return SDL_CloseIO(io) && written;
+}
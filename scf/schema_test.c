@@ -0,0 +1,331 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <scf/parser.h>
+#include <scf/schema.h>
+#include <scf/scf.h>
+#include <scf/table.h>
+
+#include <SDL3/SDL_error.h>
+
+#include "schema_test.h"
+#include "settings.h"
+#include "test.h"
+
+static bool load(settings* out,
+                 XYZ_SCFArena* arena,
+                 const char* src,
+                 XYZ_SCFTable* overflow) {
+  return settings_load(out, arena, src, SDL_strlen(src), overflow);
+}
+
+static void schema_defaults(void** state) {
+  (void)state;
+
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  settings out = {0};
+  assert_true(load(&out, &arena, "", NULL));
+  assert_string_equal(out.title, "SimpleConfig");
+  assert_float_equal(out.volume, 0.8f, 0.0f);
+  assert_int_equal(out.display.width, 1280);
+  assert_int_equal(out.display.height, 720);
+  assert_false(out.display.fullscreen);
+  assert_true(out.video.vsync);
+  assert_string_equal(out.video.renderer, "vulkan");
+  assert_string_equal(out.audio.device, "");
+  assert_int_equal(out.gameplay.difficulty, 2);
+  assert_float_equal(out.gameplay.controls.sensitivity, 1.5f, 0.0f);
+  assert_float_equal(out.gameplay.controls.deadzone, 0.15f, 0.0f);
+
+  // the same defaults whitespace only
+  settings blank = {0};
+  assert_true(load(&blank, &arena, " \n\t", NULL));
+  assert_memory_equal(&blank, &out, sizeof(out));
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+static void schema_load(void** state) {
+  (void)state;
+
+  const char* src =
+      "title = \"h\xc3\xa9ro\"\n"
+      "display { width = 1920 fullscreen = true scale = 2 }\n"
+      "video { max_fps = nil gamma = 1.8 }\n"
+      "gameplay { controls { invert_y = true } language = \"fr\" }\n";
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  settings out = {0};
+  assert_true(load(&out, &arena, src, NULL));
+  assert_string_equal(out.title, "h\xc3\xa9ro");
+  assert_int_equal(out.display.width, 1920);
+  assert_int_equal(out.display.height, 720);
+  assert_true(out.display.fullscreen);
+  assert_float_equal(out.display.scale, 2.0f, 0.0f);  // integer promoted
+  assert_int_equal(out.video.max_fps, 144);           // nil keeps default
+  assert_float_equal(out.video.gamma, 1.8f, 0.0f);
+  assert_true(out.gameplay.controls.invert_y);
+  assert_string_equal(out.gameplay.language, "fr");
+  assert_float_equal(out.volume, 0.8f, 0.0f);
+
+  // the last of repeated keys wins, as with tables
+  assert_true(load(&out, &arena, "volume = 0.1 volume = 0.2", NULL));
+  assert_float_equal(out.volume, 0.2f, 0.0f);
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+static void schema_overflow(void** state) {
+  (void)state;
+
+  const char* src =
+      "mods { enabled = true }\n"
+      "display { width = 800 refresh = 60 }\n"
+      "gameplay { controls { vibration = 0.5 } }\n"
+      "display { monitor = \"left\" }\n"
+      "seed = 42";
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  XYZ_SCFTable* overflow = XYZ_SCFTableCreateWithArena(&arena);
+  settings out = {0};
+  assert_true(load(&out, &arena, src, overflow));
+  assert_int_equal(out.display.width, 800);
+
+  Sint32 i32 = 0;
+  float f32 = 0.0f;
+  bool flag = false;
+  const char* str = NULL;
+  size_t str_len = 0;
+  XYZ_SCFTable* table = NULL;
+  assert_true(XYZ_SCFTableGetI32(overflow, "seed", &i32));
+  assert_int_equal(i32, 42);
+  assert_true(XYZ_SCFTableGetTable(overflow, "mods", &table));
+  assert_true(XYZ_SCFTableGetBool(table, "enabled", &flag));
+  assert_true(flag);
+
+  // both display blocks spill into the same table
+  assert_true(XYZ_SCFTableGetTable(overflow, "display", &table));
+  assert_int_equal(table->key_count, 2);
+  assert_true(XYZ_SCFTableGetI32(table, "refresh", &i32));
+  assert_int_equal(i32, 60);
+  assert_true(XYZ_SCFTableGetStringView(table, "monitor", &str, &str_len));
+  assert_memory_equal(str, "left", str_len);
+  assert_false(XYZ_SCFTableHas(table, "width"));
+
+  assert_true(XYZ_SCFTableGetTable(overflow, "gameplay", &table));
+  assert_true(XYZ_SCFTableGetTable(table, "controls", &table));
+  assert_true(XYZ_SCFTableGetF32(table, "vibration", &f32));
+  assert_float_equal(f32, 0.5f, 0.0f);
+  assert_false(XYZ_SCFTableHas(overflow, "video"));
+
+  // without an overflow table unknown keys are still checked
+  assert_true(load(&out, &arena, src, NULL));
+  assert_false(load(&out, &arena, "mods { enabled = }", NULL));
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+static void schema_errors(void** state) {
+  (void)state;
+
+  const char* bad[] = {
+      "display = 1",          "volume { }",          "title = 5",
+      "display { width = }",  "display { width = 1", "video { vsync = 1 }",
+      "audio { channels = 1.5 }", "display }",       "= 1",
+      "title \"x\"",          "gameplay { controls = true }",
+      "display { width = 99999999999 }",
+      "display { width = 100 }", "volume = 1.5", "gameplay { difficulty = -1 }",
+  };
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    settings out = {0};
+    assert_false(load(&out, &arena, bad[i], NULL));
+  }
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+static void schema_find(void** state) {
+  (void)state;
+
+  const XYZ_SCFSchema* schema = &settings_schema;
+  assert_int_equal(schema->field_count, 24);
+  for (Uint32 i = 0; i < schema->field_count; i++) {
+    const XYZ_SCFSchemaField* field = &schema->fields[i];
+    assert_ptr_equal(XYZ_SCFSchemaFind(schema, field->scope, field->key,
+                                       field->key_len),
+                     field);
+  }
+
+  const XYZ_SCFSchemaField* width =
+      XYZ_SCFSchemaFind(schema, 0, "display", 7);
+  assert_non_null(width);
+  assert_int_equal(width->type, XYZ_SCF_VALUE_TYPE_TABLE);
+  width = XYZ_SCFSchemaFind(schema, width->block, "width", 5);
+  assert_non_null(width);
+  assert_int_equal(width->offset, offsetof(settings, display.width));
+
+  // keys of other blocks and unknown keys
+  assert_null(XYZ_SCFSchemaFind(schema, 0, "width", 5));
+  assert_null(XYZ_SCFSchemaFind(schema, 0, "titles", 6));
+  assert_null(XYZ_SCFSchemaFind(schema, 0, "titl", 4));
+  assert_null(XYZ_SCFSchemaFind(schema, 99, "title", 5));
+  assert_null(XYZ_SCFSchemaFind(schema, 0, "", 0));
+}
+
+static void schema_required(void** state) {
+  (void)state;
+
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  schema_test out = {0};
+  assert_false(schema_test_load(&out, &arena, "", 0, NULL));
+  assert_string_equal(SDL_GetError(),
+                      "line 1, column 1: missing required key 'name'");
+
+  const char* src = "name = \"api\"\nport = 443\nlimits { depth = 2 }";
+  assert_true(schema_test_load(&out, &arena, src, SDL_strlen(src), NULL));
+  assert_string_equal(out.name, "api");
+  assert_int_equal(out.port, 443);
+  assert_int_equal(out.retries, 3);
+  assert_int_equal(out.limits.depth, 2);
+
+  // nil does not count, a missing block misses its required keys too
+  const char* bad[] = {
+      "name = \"api\" port = nil limits { depth = 2 }",
+      "name = \"api\" port = 443",
+      "name = \"api\" port = 443 limits { rate = 2 }",
+      "name = \"api\" port = 70000 limits { depth = 2 }",
+      "name = \"api\" port = 1 limits { depth = 2 } retries = -1",
+  };
+  const char* errors[] = {
+      "line 1, column 21: key 'port' is required and cannot be nil",
+      "line 1, column 24: missing required key 'depth'",
+      "line 1, column 43: missing required key 'depth'",
+      "line 1, column 21: key 'port' must be at most 65535",
+      "line 1, column 54: key 'retries' must be at least 0",
+  };
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    assert_false(schema_test_load(&out, &arena, bad[i], SDL_strlen(bad[i]),
+                                  NULL));
+    assert_string_equal(SDL_GetError(), errors[i]);
+    XYZ_SCFParser setup = {.arena = &arena, .schema = &schema_test_schema};
+    assert_null(test_parse_with(&setup, bad[i], SDL_strlen(bad[i])));
+    assert_string_equal(SDL_GetError(), errors[i]);
+  }
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+static void schema_table(void** state) {
+  (void)state;
+
+  const char* src =
+      "display {\n  width = 1920\n  scale = 2\n}\n"
+      "video = nil\ntitle = nil\n"
+      "mods { width = 1 }\n";
+  XYZ_SCFArena arena = {0};
+  XYZ_SCFArenaInit(&arena, 0);
+  XYZ_SCFParser setup = {.arena = &arena, .schema = &settings_schema};
+  XYZ_SCFTable* table = test_parse_with(&setup, src, SDL_strlen(src));
+  assert_non_null(table);
+
+  // what the file has, checked and with integers turned into floats
+  Sint32 i32 = 0;
+  float f32 = 0.0f;
+  bool flag = false;
+  char* str = NULL;
+  assert_true(XYZ_SCFTableGetPathI32(table, "display.width", &i32));
+  assert_int_equal(i32, 1920);
+  assert_true(XYZ_SCFTableGetPathF32(table, "display.scale", &f32));
+  assert_float_equal(f32, 2.0f, 0.0f);
+
+  // defaults of what it does not have, nested blocks included
+  assert_true(XYZ_SCFTableGetPathI32(table, "display.height", &i32));
+  assert_int_equal(i32, 720);
+  assert_true(XYZ_SCFTableGetPathBool(table, "video.vsync", &flag));
+  assert_true(flag);
+  assert_true(XYZ_SCFTableGetString(table, "title", &str));
+  assert_string_equal(str, "SimpleConfig");
+  assert_true(XYZ_SCFTableGetPathF32(table, "gameplay.controls.deadzone",
+                                     &f32));
+  assert_float_equal(f32, 0.15f, 0.0f);
+  assert_true(XYZ_SCFTableGetF32(table, "volume", &f32));
+  assert_float_equal(f32, 0.8f, 0.0f);
+
+  // blocks the schema does not know are left alone
+  assert_true(XYZ_SCFTableGetPathI32(table, "mods.width", &i32));
+  assert_int_equal(i32, 1);
+  assert_int_equal(table->key_count, 7);
+
+  // same results without an arena, nothing leaks
+  XYZ_SCFParser parser = {.schema = &settings_schema};
+  XYZ_SCFParserSetFile(&parser, src, SDL_strlen(src));
+  XYZ_SCFTable* heap = XYZ_SCFTableCreate();
+  assert_true(XYZ_SCFParseTable(&parser, heap));
+  assert_true(XYZ_SCFTableEqual(table, heap));
+  XYZ_SCFTableDestroy(heap);
+  SDL_free(heap);
+
+  const char* bad[] = {"title = \"a\"\ndisplay {\n  width = 100\n}",
+                       "audio {\n\tdevice { }\n}", "title = 1"};
+  const char* errors[] = {
+      "line 3, column 11: key 'width' must be at least 320",
+      "line 2, column 9: key 'device' expects a value, not a block",
+      "line 1, column 9: key 'title' expects a string but found an integer",
+  };
+  for (size_t i = 0; i < SDL_arraysize(bad); i++) {
+    parser = (XYZ_SCFParser){.schema = &settings_schema};
+    XYZ_SCFParserSetFile(&parser, bad[i], SDL_strlen(bad[i]));
+    heap = XYZ_SCFTableCreate();
+    assert_false(XYZ_SCFParseTable(&parser, heap));
+    assert_string_equal(SDL_GetError(), errors[i]);
+    XYZ_SCFTableDestroy(heap);
+    SDL_free(heap);
+  }
+  XYZ_SCFArenaDestroy(&arena);
+}
+
+static void schema_document(void** state) {
+  (void)state;
+
+  XYZ_SCFDocument* doc =
+      XYZ_SCFParseDocumentWithSchema("", 0, 0, &settings_schema);
+  assert_non_null(doc);
+  Sint32 channels = 0;
+  assert_true(XYZ_SCFTableGetPathI32(doc->root, "audio.channels", &channels));
+  assert_int_equal(channels, 2);
+  XYZ_SCFDocumentDestroy(doc);
+
+  const char* src = "name = \"x\" port = 1 limits { depth = 1 }";
+  Uint32 flags[] = {0, XYZ_SCF_PARSE_ZERO_COPY, XYZ_SCF_PARSE_INDEXED};
+  for (size_t i = 0; i < SDL_arraysize(flags); i++) {
+    doc = XYZ_SCFParseDocumentWithSchema(src, SDL_strlen(src), flags[i],
+                                         &schema_test_schema);
+    assert_non_null(doc);
+    float rate = 0.0f;
+    assert_true(XYZ_SCFTableGetPathF32(doc->root, "limits.rate", &rate));
+    assert_float_equal(rate, 1.5f, 0.0f);
+    XYZ_SCFDocumentDestroy(doc);
+  }
+
+  assert_null(
+      XYZ_SCFParseDocumentWithSchema("", 0, 0, &schema_test_schema));
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(schema_defaults),
+      cmocka_unit_test(schema_load),
+      cmocka_unit_test(schema_overflow),
+      cmocka_unit_test(schema_errors),
+      cmocka_unit_test(schema_find),
+      cmocka_unit_test(schema_required),
+      cmocka_unit_test(schema_table),
+      cmocka_unit_test(schema_document),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -4,114 +4,299 @@
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_stdinc.h>
 
+#define XYZ_SCF_FNV_OFFSET 2166136261u
+#define XYZ_SCF_FNV_PRIME 16777619u
+#define XYZ_SCF_MIN_SLOTS 8
+#define XYZ_SCF_MIN_PAIRS 4
+// pair flags of keys the pair does not own
+#define XYZ_SCF_KEY_BORROWED \
+  (XYZ_SCF_PAIR_FLAG_KEY_VIEW | XYZ_SCF_PAIR_FLAG_KEY_ATOM)
+
+// allocate from arena, or from the heap when arena is NULL
+void* table_alloc(XYZ_SCFArena* arena, size_t size);
+// hash a null terminated key, same result as XYZ_SCFHashKey
+Uint32 table_hash_cstr(const char* key, size_t* key_len);
+// compare a (possibly not null terminated) pair key, by atom alone when
+// both sides are interned
+bool table_key_equal(const XYZ_SCFPair* pair,
+                     const char* key,
+                     size_t key_len,
+                     XYZ_SCFAtom atom);
+// find the pair for key using the index, or walking the pairs without one
+XYZ_SCFPair* table_find(XYZ_SCFTable* table, const char* key);
+// find the pair for a key of known length and hash, atom may be
+// XYZ_SCF_NO_ATOM
+XYZ_SCFPair* table_find_hashed(XYZ_SCFTable* table,
+                               const char* key,
+                               size_t key_len,
+                               Uint32 hash,
+                               XYZ_SCFAtom atom);
+// check the type of the value behind a key handle
+bool table_key_type(XYZ_SCFKey key, XYZ_SCFValueType type);
+// handle to a pair of table
+XYZ_SCFKey table_key(XYZ_SCFTable* table, const XYZ_SCFPair* pair);
+// fill pair, copying key into arena or the heap unless it is a view or
+// interned
+bool table_pair_init(XYZ_SCFArena* arena,
+                     XYZ_SCFPair* pair,
+                     const char* key,
+                     size_t key_len,
+                     XYZ_SCFValue value,
+                     Uint32 flags);
+// free the key and value of a heap pair, not the pair itself
+void table_pair_release(XYZ_SCFPair* pair);
+// make room for count pairs in total
+bool table_reserve(XYZ_SCFTable* table, Uint32 count);
+// copy pair to the end of the pairs and index it
+XYZ_SCFPair* table_push(XYZ_SCFTable* table, const XYZ_SCFPair* pair);
+
+typedef struct {
+  char* data;
+  size_t len;
+  size_t cap;
+  XYZ_SCFChangeCallback callback;
+  void* userdata;
+} table_diff_state;
+
+// diff two tables whose path so far is in state
+bool table_diff(table_diff_state* state,
+                XYZ_SCFTable* old_table,
+                XYZ_SCFTable* new_table);
+// append ".key" to the path in state
+bool table_diff_push(table_diff_state* state, const XYZ_SCFPair* pair);
+// compare two values, strings by their length
+bool table_value_equal(const XYZ_SCFPair* a, const XYZ_SCFPair* b);
+// compare the elements of two arrays of the same type
+bool table_array_equal(const XYZ_SCFValue* a, const XYZ_SCFValue* b);
+// bytes taken by one element of an array type, string pointers for strings
+size_t table_array_item_size(XYZ_SCFValueType type);
+// make value an array of count elements, uninitialized, followed by
+// string_bytes for the strings of a string array
+bool table_array_alloc(XYZ_SCFArena* arena,
+                       XYZ_SCFValueType type,
+                       Uint32 count,
+                       size_t string_bytes,
+                       XYZ_SCFValue* value);
+// elements of the array at key, empty arrays match any type
+bool table_get_array(XYZ_SCFTable* table,
+                     const char* key,
+                     XYZ_SCFValueType type,
+                     const void** values,
+                     size_t* count);
+// parse table if XYZ_SCF_PARSE_LAZY left it unparsed, false if that fails
+bool table_expand(XYZ_SCFTable* table);
+// shared with config.c, same for every block below table too
+bool table_expand_all(XYZ_SCFTable* table);
+// shared with parser.c, parses a block left unparsed into table
+bool parse_lazy_block(XYZ_SCFTable* table);
+// insert the pair at index into the index unless its key is already indexed
+void table_index_insert(XYZ_SCFTable* table, Uint32 index);
+// rebuild the index from the pairs, leaving it at most half full
+bool table_index_rebuild(XYZ_SCFTable* table);
+
+Uint32 XYZ_SCFHashKey(const char* key, size_t key_len) {
+  SDL_assert(key != NULL && "XYZ_SCFHashKey: key cannot be NULL");
+  Uint32 hash = XYZ_SCF_FNV_OFFSET;
+  for (size_t i = 0; i < key_len; i++) {
+    hash ^= (Uint8)key[i];
+    hash *= XYZ_SCF_FNV_PRIME;
+  }
+  return hash;
+}
+
 XYZ_SCFTable* XYZ_SCFTableCreate() {
-  XYZ_SCFTable* table = SDL_malloc(sizeof(XYZ_SCFTable));
+  return XYZ_SCFTableCreateWithArena(NULL);
+}
+
+XYZ_SCFTable* XYZ_SCFTableCreateWithArena(XYZ_SCFArena* arena) {
+  XYZ_SCFTable* table = table_alloc(arena, sizeof(XYZ_SCFTable));
   if (table == NULL) {
     return NULL;
   }
   SDL_memset(table, 0, sizeof(XYZ_SCFTable));
+  table->arena = arena;
   return table;
 }
 
 void XYZ_SCFTableDestroy(XYZ_SCFTable* table) {
   SDL_assert(table != NULL && "XYZ_SCFTableDestroy: table cannot be NULL");
-  XYZ_SCFPair* cur = table->head;
-  XYZ_SCFPair* tmp = NULL;
-  while (cur != NULL) {
-    tmp = cur->next;
-    XYZ_SCFPairDestroy(cur);
-    cur = tmp;
+  if (table->arena != NULL) {
+    // everything goes away together with the arena
+    SDL_memset(table, 0, sizeof(XYZ_SCFTable));
+    return;
+  }
+
+  for (Uint32 i = 0; i < table->pair_count; i++) {
+    table_pair_release(&table->pairs[i]);
+  }
+
+  if (table->pairs != NULL) {
+    SDL_free(table->pairs);
   }
+  if (table->slots != NULL) {
+    SDL_free(table->slots);
+  }
+  if (table->lazy != NULL) {
+    SDL_free(table->lazy);
+  }
+  SDL_memset(table, 0, sizeof(XYZ_SCFTable));
 }
 
 XYZ_SCFPair* XYZ_SCFPairCreate(const char* key,
                                size_t key_len,
                                XYZ_SCFValue value) {
+  return XYZ_SCFPairCreateWithArena(NULL, key, key_len, value);
+}
+
+XYZ_SCFPair* XYZ_SCFPairCreateWithArena(XYZ_SCFArena* arena,
+                                        const char* key,
+                                        size_t key_len,
+                                        XYZ_SCFValue value) {
+  return XYZ_SCFPairCreateWithFlags(arena, key, key_len, value, 0);
+}
+
+XYZ_SCFPair* XYZ_SCFPairCreateWithFlags(XYZ_SCFArena* arena,
+                                        const char* key,
+                                        size_t key_len,
+                                        XYZ_SCFValue value,
+                                        Uint32 flags) {
   SDL_assert(key != NULL && "XYZ_SCFPairCreate: key cannot be NULL");
 
-  XYZ_SCFPair* pair = SDL_malloc(sizeof(XYZ_SCFPair));
+  XYZ_SCFPair* pair = table_alloc(arena, sizeof(XYZ_SCFPair));
   if (pair == NULL) {
     return NULL;
   }
-  SDL_memset(pair, 0, sizeof(XYZ_SCFPair));
 
-  pair->key = SDL_malloc(key_len + 1);
-  if (pair->key == NULL) {
-    SDL_free(pair);
+  if (!table_pair_init(arena, pair, key, key_len, value, flags)) {
+    if (arena == NULL) {
+      SDL_free(pair);
+    }
     return NULL;
   }
-  SDL_memset(pair->key, 0, key_len + 1);
-  SDL_memcpy((void*)pair->key, key, key_len);
-  pair->value = value;
   return pair;
 }
 
 void XYZ_SCFPairDestroy(XYZ_SCFPair* pair) {
-  SDL_assert(pair != NULL && "XYZ_SCFPairCreate: pair cannot be NULL");
-  if (pair->key != NULL) {
-    SDL_free(pair->key);
+  SDL_assert(pair != NULL && "XYZ_SCFPairDestroy: pair cannot be NULL");
+  if (pair->flags & XYZ_SCF_PAIR_FLAG_ARENA) {
+    return;
   }
 
-  XYZ_SCFValue value = pair->value;
-  if (value.type == XYZ_SCF_VALUE_TYPE_STRING) {
-    SDL_free(value.as_string);
-  } else if (value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
-    XYZ_SCFTableDestroy(value.as_table);
-    SDL_free(value.as_table);
+  table_pair_release(pair);
+  SDL_free(pair);
+}
+
+size_t XYZ_SCFPairStringLen(const XYZ_SCFPair* pair) {
+  SDL_assert(pair != NULL && "XYZ_SCFPairStringLen: pair cannot be NULL");
+  SDL_assert(pair->value.type == XYZ_SCF_VALUE_TYPE_STRING &&
+             "XYZ_SCFPairStringLen: pair must hold a string");
+  if (pair->flags & XYZ_SCF_PAIR_FLAG_STRING_VIEW) {
+    return pair->value.str_len;
   }
+  return SDL_strlen(pair->value.as_string);
 }
 
 bool XYZ_SCFTableHas(XYZ_SCFTable* table, const char* key) {
   SDL_assert(table != NULL && "XYZ_SCFTableHas: table cannot be NULL");
   SDL_assert(key != NULL && "XYZ_SCFTableHas: key cannot be NULL");
-  XYZ_SCFPair* cur = table->head;
-  while (cur != NULL) {
-    if (SDL_strcmp(cur->key, key) == 0) {
-      return true;
-    }
-    cur = cur->next;
-  }
+  return table_find(table, key) != NULL;
+}
+
+XYZ_SCFPair* XYZ_SCFTableFind(XYZ_SCFTable* table,
+                              const char* key,
+                              size_t key_len,
+                              Uint32 hash) {
+  SDL_assert(table != NULL && "XYZ_SCFTableFind: table cannot be NULL");
+  SDL_assert(key != NULL && "XYZ_SCFTableFind: key cannot be NULL");
+  return table_find_hashed(table, key, key_len, hash, XYZ_SCF_NO_ATOM);
+}
 
-  return false;
+XYZ_SCFPair* XYZ_SCFTableFindAtom(XYZ_SCFTable* table, XYZ_SCFAtom atom) {
+  SDL_assert(table != NULL && "XYZ_SCFTableFindAtom: table cannot be NULL");
+  SDL_assert(atom != XYZ_SCF_NO_ATOM &&
+             "XYZ_SCFTableFindAtom: atom cannot be none");
+  Uint32 key_len = 0;
+  Uint32 hash = 0;
+  const char* key = XYZ_SCFAtomKey(atom, &key_len, &hash);
+  return table_find_hashed(table, key, key_len, hash, atom);
 }
 
-void XYZ_SCFTableAdd(XYZ_SCFTable* table, XYZ_SCFPair* pair) {
+XYZ_SCFPair* XYZ_SCFTableAdd(XYZ_SCFTable* table, XYZ_SCFPair* pair) {
   SDL_assert(table != NULL && "XYZ_SCFTableAdd: table cannot be NULL");
   SDL_assert(pair != NULL && "XYZ_SCFTableAdd: pair cannot be NULL");
 
-  if (table->head == NULL) {
-    table->head = pair;
+  XYZ_SCFPair* added = table_push(table, pair);
+  if (added == NULL) {
+    return NULL;
   }
 
-  if (table->tail == NULL) {
-    table->tail = pair;
-  } else {
-    table->tail->next = pair;
-    pair->prev = table->tail;
-    table->tail = pair;
+  // arena pairs are left behind, the arena takes them back with the rest
+  if (!(pair->flags & XYZ_SCF_PAIR_FLAG_ARENA)) {
+    SDL_free(pair);
+  }
+  return added;
+}
+
+XYZ_SCFPair* XYZ_SCFTableAppend(XYZ_SCFTable* table,
+                                const char* key,
+                                size_t key_len,
+                                XYZ_SCFValue value,
+                                Uint32 flags) {
+  SDL_assert(table != NULL && "XYZ_SCFTableAppend: table cannot be NULL");
+  SDL_assert(key != NULL && "XYZ_SCFTableAppend: key cannot be NULL");
+
+  XYZ_SCFPair pair = {0};
+  if (!table_pair_init(table->arena, &pair, key, key_len, value, flags)) {
+    return NULL;
+  }
+
+  XYZ_SCFPair* added = table_push(table, &pair);
+  if (added == NULL && table->arena == NULL &&
+      !(pair.flags & XYZ_SCF_KEY_BORROWED)) {
+    SDL_free(pair.key);
+  }
+  return added;
+}
+
+bool XYZ_SCFTableExpand(XYZ_SCFTable* table) {
+  SDL_assert(table != NULL && "XYZ_SCFTableExpand: table cannot be NULL");
+  return table_expand(table);
+}
+
+Uint32 XYZ_SCFTableCount(XYZ_SCFTable* table) {
+  SDL_assert(table != NULL && "XYZ_SCFTableCount: table cannot be NULL");
+  if (!table_expand(table)) {
+    return 0;
   }
+  return table->pair_count;
+}
+
+XYZ_SCFCursor XYZ_SCFTableCursor(XYZ_SCFTable* table) {
+  SDL_assert(table != NULL && "XYZ_SCFTableCursor: table cannot be NULL");
+  // a block that fails to parse is walked as empty, see XYZ_SCFTableExpand
+  table_expand(table);
+  return (XYZ_SCFCursor){.table = table};
+}
+
+XYZ_SCFKey XYZ_SCFCursorKey(const XYZ_SCFCursor* cursor) {
+  SDL_assert(cursor != NULL && "XYZ_SCFCursorKey: cursor cannot be NULL");
+  SDL_assert(cursor->pair != NULL &&
+             "XYZ_SCFCursorKey: cursor is not on a pair");
+  return (XYZ_SCFKey){cursor->table, cursor->index - 1};
 }
 
 bool XYZ_SCFTableSet(XYZ_SCFTable* table, const char* key, XYZ_SCFValue value) {
   SDL_assert(table != NULL && "XYZ_SCFTableSet: table cannot be NULL");
   SDL_assert(key != NULL && "XYZ_SCFTableSet: key cannot be NULL");
-  XYZ_SCFPair* cur = table->head;
-  while (cur != NULL) {
-    if (SDL_strcmp(cur->key, key) == 0) {
-      cur->value = value;
-      return true;
-    }
-    cur = cur->next;
+  XYZ_SCFPair* cur = table_find(table, key);
+  if (cur != NULL) {
+    cur->value = value;
+    cur->flags &= ~XYZ_SCF_PAIR_FLAG_STRING_VIEW;
+    return true;
   }
 
   size_t key_len = SDL_strlen(key);
-  XYZ_SCFPair* pair = XYZ_SCFPairCreate(key, key_len, value);
-  if (pair == NULL) {
-    return false;
-  }
-
-  XYZ_SCFTableAdd(table, pair);
-  return true;
+  return XYZ_SCFTableAppend(table, key, key_len, value, 0) != NULL;
 }
 
 bool XYZ_SCFTableGet(XYZ_SCFTable* table,
@@ -120,16 +305,13 @@ bool XYZ_SCFTableGet(XYZ_SCFTable* table,
   SDL_assert(table != NULL && "XYZ_SCFTableGet: table cannot be NULL");
   SDL_assert(key != NULL && "XYZ_SCFTableGet: key cannot be NULL");
   SDL_assert(value != NULL && "XYZ_SCFTableGet: value cannot be NULL");
-  XYZ_SCFPair* cur = table->head;
-  while (cur != NULL) {
-    if (SDL_strcmp(cur->key, key) == 0) {
-      *value = cur->value;
-      return true;
-    }
-    cur = cur->next;
+  XYZ_SCFPair* cur = table_find(table, key);
+  if (cur == NULL) {
+    return false;
   }
 
-  return false;
+  *value = cur->value;
+  return true;
 }
 
 bool XYZ_SCFTableGetBool(XYZ_SCFTable* table, const char* key, bool* value) {
@@ -194,17 +376,49 @@ bool XYZ_SCFTableGetString(XYZ_SCFTable* table, const char* key, char** value) {
   SDL_assert(key != NULL && "XYZ_SCFTableGetString: key cannot be NULL");
   SDL_assert(value != NULL && "XYZ_SCFTableGetString: value cannot be NULL");
 
-  XYZ_SCFValue any = {0};
-  if (!XYZ_SCFTableGet(table, key, &any)) {
+  XYZ_SCFPair* pair = table_find(table, key);
+  if (pair == NULL) {
     return false;
   }
 
-  if (any.type != XYZ_SCF_VALUE_TYPE_STRING) {
+  if (pair->value.type != XYZ_SCF_VALUE_TYPE_STRING) {
     SDL_SetError("incompatible type for key: %s", key);
     return false;
   }
 
-  *value = any.as_string;
+  if (pair->flags & XYZ_SCF_PAIR_FLAG_STRING_VIEW) {
+    SDL_SetError("string is not null terminated, use a view for key: %s", key);
+    return false;
+  }
+
+  *value = pair->value.as_string;
+  return true;
+}
+
+bool XYZ_SCFTableGetStringView(XYZ_SCFTable* table,
+                               const char* key,
+                               const char** value,
+                               size_t* value_len) {
+  SDL_assert(table != NULL &&
+             "XYZ_SCFTableGetStringView: table cannot be NULL");
+  SDL_assert(key != NULL && "XYZ_SCFTableGetStringView: key cannot be NULL");
+  SDL_assert(value != NULL &&
+             "XYZ_SCFTableGetStringView: value cannot be NULL");
+  SDL_assert(value_len != NULL &&
+             "XYZ_SCFTableGetStringView: value_len cannot be NULL");
+
+  XYZ_SCFPair* pair = table_find(table, key);
+  if (pair == NULL) {
+    return false;
+  }
+
+  if (pair->value.type != XYZ_SCF_VALUE_TYPE_STRING) {
+    SDL_SetError("incompatible type for key: %s", key);
+    return false;
+  }
+
+  *value = pair->value.as_string;
+  *value_len = XYZ_SCFPairStringLen(pair);
   return true;
 }
 
@@ -225,6 +439,678 @@ bool XYZ_SCFTableGetTable(XYZ_SCFTable* table,
     return false;
   }
 
+  if (!table_expand(any.as_table)) {
+    return false;
+  }
   *value = any.as_table;
   return true;
 }
+
+bool XYZ_SCFArrayCreate(XYZ_SCFArena* arena,
+                        XYZ_SCFValueType type,
+                        const void* items,
+                        Uint32 count,
+                        XYZ_SCFValue* value) {
+  SDL_assert(XYZ_SCFIsArrayType(type) &&
+             "XYZ_SCFArrayCreate: type must be an array type");
+  SDL_assert((items != NULL || count == 0) &&
+             "XYZ_SCFArrayCreate: items cannot be NULL");
+  SDL_assert(value != NULL && "XYZ_SCFArrayCreate: value cannot be NULL");
+
+  if (type != XYZ_SCF_VALUE_TYPE_STRING_ARRAY) {
+    if (!table_array_alloc(arena, type, count, 0, value)) {
+      return false;
+    }
+    if (count > 0) {
+      SDL_memcpy(value->as_array, items, count * table_array_item_size(type));
+    }
+    return true;
+  }
+
+  const char* const* strings = items;
+  size_t string_bytes = 0;
+  for (Uint32 i = 0; i < count; i++) {
+    string_bytes += SDL_strlen(strings[i]) + 1;
+  }
+  if (!table_array_alloc(arena, type, count, string_bytes, value)) {
+    return false;
+  }
+
+  char* dst = (char*)(value->as_strings + count);
+  for (Uint32 i = 0; i < count; i++) {
+    size_t len = SDL_strlen(strings[i]) + 1;
+    SDL_memcpy(dst, strings[i], len);
+    value->as_strings[i] = dst;
+    dst += len;
+  }
+  return true;
+}
+
+bool XYZ_SCFTableGetBoolArray(XYZ_SCFTable* table,
+                              const char* key,
+                              const bool** values,
+                              size_t* count) {
+  return table_get_array(table, key, XYZ_SCF_VALUE_TYPE_BOOL_ARRAY,
+                         (const void**)values, count);
+}
+
+bool XYZ_SCFTableGetI32Array(XYZ_SCFTable* table,
+                             const char* key,
+                             const Sint32** values,
+                             size_t* count) {
+  return table_get_array(table, key, XYZ_SCF_VALUE_TYPE_I32_ARRAY,
+                         (const void**)values, count);
+}
+
+bool XYZ_SCFTableGetF32Array(XYZ_SCFTable* table,
+                             const char* key,
+                             const float** values,
+                             size_t* count) {
+  return table_get_array(table, key, XYZ_SCF_VALUE_TYPE_F32_ARRAY,
+                         (const void**)values, count);
+}
+
+bool XYZ_SCFTableGetStringArray(XYZ_SCFTable* table,
+                                const char* key,
+                                const char* const** values,
+                                size_t* count) {
+  return table_get_array(table, key, XYZ_SCF_VALUE_TYPE_STRING_ARRAY,
+                         (const void**)values, count);
+}
+
+bool XYZ_SCFTableResolve(XYZ_SCFTable* table,
+                         const char* key,
+                         XYZ_SCFKey* handle) {
+  SDL_assert(table != NULL && "XYZ_SCFTableResolve: table cannot be NULL");
+  SDL_assert(key != NULL && "XYZ_SCFTableResolve: key cannot be NULL");
+  SDL_assert(handle != NULL && "XYZ_SCFTableResolve: handle cannot be NULL");
+
+  XYZ_SCFPair* pair = table_find(table, key);
+  if (pair == NULL) {
+    // a lazy block that failed to parse keeps its parse error
+    if (table->lazy == NULL) {
+      SDL_SetError("key not found: %s", key);
+    }
+    return false;
+  }
+
+  *handle = table_key(table, pair);
+  return true;
+}
+
+XYZ_SCFPair* XYZ_SCFKeyPair(XYZ_SCFKey key) {
+  SDL_assert(key.table != NULL && "XYZ_SCFKeyPair: key is not resolved");
+  return &key.table->pairs[key.index];
+}
+
+XYZ_SCFValue* XYZ_SCFKeyValue(XYZ_SCFKey key) {
+  return &XYZ_SCFKeyPair(key)->value;
+}
+
+void XYZ_SCFKeySet(XYZ_SCFKey key, XYZ_SCFValue value) {
+  XYZ_SCFPair* pair = XYZ_SCFKeyPair(key);
+  pair->value = value;
+  pair->flags &= ~XYZ_SCF_PAIR_FLAG_STRING_VIEW;
+}
+
+bool XYZ_SCFKeyGetBool(XYZ_SCFKey key, bool* value) {
+  SDL_assert(value != NULL && "XYZ_SCFKeyGetBool: value cannot be NULL");
+  if (!table_key_type(key, XYZ_SCF_VALUE_TYPE_BOOL)) {
+    return false;
+  }
+
+  *value = XYZ_SCFKeyValue(key)->as_bool;
+  return true;
+}
+
+bool XYZ_SCFKeyGetI32(XYZ_SCFKey key, Sint32* value) {
+  SDL_assert(value != NULL && "XYZ_SCFKeyGetI32: value cannot be NULL");
+  if (!table_key_type(key, XYZ_SCF_VALUE_TYPE_I32)) {
+    return false;
+  }
+
+  *value = XYZ_SCFKeyValue(key)->as_i32;
+  return true;
+}
+
+bool XYZ_SCFKeyGetF32(XYZ_SCFKey key, float* value) {
+  SDL_assert(value != NULL && "XYZ_SCFKeyGetF32: value cannot be NULL");
+  if (!table_key_type(key, XYZ_SCF_VALUE_TYPE_F32)) {
+    return false;
+  }
+
+  *value = XYZ_SCFKeyValue(key)->as_f32;
+  return true;
+}
+
+bool XYZ_SCFKeyGetStringView(XYZ_SCFKey key,
+                             const char** value,
+                             size_t* value_len) {
+  SDL_assert(value != NULL &&
+             "XYZ_SCFKeyGetStringView: value cannot be NULL");
+  SDL_assert(value_len != NULL &&
+             "XYZ_SCFKeyGetStringView: value_len cannot be NULL");
+  if (!table_key_type(key, XYZ_SCF_VALUE_TYPE_STRING)) {
+    return false;
+  }
+
+  XYZ_SCFPair* pair = XYZ_SCFKeyPair(key);
+  *value = pair->value.as_string;
+  *value_len = XYZ_SCFPairStringLen(pair);
+  return true;
+}
+
+bool XYZ_SCFKeyGetTable(XYZ_SCFKey key, XYZ_SCFTable** value) {
+  SDL_assert(value != NULL && "XYZ_SCFKeyGetTable: value cannot be NULL");
+  if (!table_key_type(key, XYZ_SCF_VALUE_TYPE_TABLE) ||
+      !table_expand(XYZ_SCFKeyValue(key)->as_table)) {
+    return false;
+  }
+
+  *value = XYZ_SCFKeyValue(key)->as_table;
+  return true;
+}
+
+bool XYZ_SCFTableEqual(XYZ_SCFTable* a, XYZ_SCFTable* b) {
+  SDL_assert(a != NULL && "XYZ_SCFTableEqual: a cannot be NULL");
+  SDL_assert(b != NULL && "XYZ_SCFTableEqual: b cannot be NULL");
+
+  if (!table_expand(a) || !table_expand(b) ||
+      a->pair_count != b->pair_count) {
+    return false;
+  }
+
+  for (Uint32 i = 0; i < a->pair_count; i++) {
+    XYZ_SCFPair* cur = &a->pairs[i];
+    XYZ_SCFPair* other = table_find_hashed(b, cur->key, cur->key_len,
+                                           cur->key_hash, cur->key_atom);
+    if (other == NULL || !table_value_equal(cur, other)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool table_key_type(XYZ_SCFKey key, XYZ_SCFValueType type) {
+  XYZ_SCFPair* pair = XYZ_SCFKeyPair(key);
+  if (pair->value.type != type) {
+    SDL_SetError("incompatible type for key: %.*s", (Sint32)pair->key_len,
+                 pair->key);
+    return false;
+  }
+  return true;
+}
+
+XYZ_SCFKey table_key(XYZ_SCFTable* table, const XYZ_SCFPair* pair) {
+  return (XYZ_SCFKey){table, (Uint32)(pair - table->pairs)};
+}
+
+bool table_pair_init(XYZ_SCFArena* arena,
+                     XYZ_SCFPair* pair,
+                     const char* key,
+                     size_t key_len,
+                     XYZ_SCFValue value,
+                     Uint32 flags) {
+  SDL_memset(pair, 0, sizeof(XYZ_SCFPair));
+  pair->key_hash = XYZ_SCFHashKey(key, key_len);
+  if (flags & XYZ_SCF_PAIR_FLAG_KEY_ATOM) {
+    // the interned copy is shared with every other pair of the same key; a
+    // full atom table leaves the key to be copied like any other
+    pair->key_atom = XYZ_SCFAtomIntern(key, key_len, pair->key_hash);
+    flags &= ~XYZ_SCF_PAIR_FLAG_KEY_VIEW;
+    if (pair->key_atom == XYZ_SCF_NO_ATOM) {
+      flags &= ~XYZ_SCF_PAIR_FLAG_KEY_ATOM;
+    }
+  }
+
+  if (flags & XYZ_SCF_PAIR_FLAG_KEY_ATOM) {
+    pair->key = (char*)XYZ_SCFAtomKey(pair->key_atom, NULL, NULL);
+  } else if (flags & XYZ_SCF_PAIR_FLAG_KEY_VIEW) {
+    pair->key = (char*)key;
+  } else {
+    pair->key = table_alloc(arena, key_len + 1);
+    if (pair->key == NULL) {
+      return false;
+    }
+    SDL_memcpy(pair->key, key, key_len);
+    pair->key[key_len] = '\0';
+  }
+
+  pair->key_len = (Uint32)key_len;
+  pair->flags = flags;
+  if (arena != NULL) {
+    pair->flags |= XYZ_SCF_PAIR_FLAG_ARENA;
+  }
+  pair->value = value;
+  return true;
+}
+
+void table_pair_release(XYZ_SCFPair* pair) {
+  if (pair->flags & XYZ_SCF_PAIR_FLAG_ARENA) {
+    return;
+  }
+
+  if (pair->key != NULL && !(pair->flags & XYZ_SCF_KEY_BORROWED)) {
+    SDL_free(pair->key);
+  }
+
+  XYZ_SCFValue value = pair->value;
+  if (value.type == XYZ_SCF_VALUE_TYPE_STRING &&
+      !(pair->flags & XYZ_SCF_PAIR_FLAG_STRING_VIEW)) {
+    SDL_free(value.as_string);
+  } else if (value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+    XYZ_SCFTableDestroy(value.as_table);
+    SDL_free(value.as_table);
+  } else if (XYZ_SCFIsArrayType(value.type)) {
+    SDL_free(value.as_array);
+  }
+}
+
+bool table_reserve(XYZ_SCFTable* table, Uint32 count) {
+  if (count <= table->pair_cap) {
+    return true;
+  }
+
+  Uint32 cap = SDL_max(table->pair_cap * 2, XYZ_SCF_MIN_PAIRS);
+  while (cap < count) {
+    cap *= 2;
+  }
+
+  // same as the index, with an arena the old pairs are abandoned
+  XYZ_SCFPair* pairs = NULL;
+  if (table->arena != NULL) {
+    pairs = XYZ_SCFArenaAlloc(table->arena, cap * sizeof(XYZ_SCFPair));
+    if (pairs != NULL && table->pair_count > 0) {
+      SDL_memcpy(pairs, table->pairs, table->pair_count * sizeof(XYZ_SCFPair));
+    }
+  } else {
+    pairs = SDL_realloc(table->pairs, cap * sizeof(XYZ_SCFPair));
+  }
+  if (pairs == NULL) {
+    return false;
+  }
+
+  table->pairs = pairs;
+  table->pair_cap = cap;
+  return true;
+}
+
+XYZ_SCFPair* table_push(XYZ_SCFTable* table, const XYZ_SCFPair* pair) {
+  if (!table_expand(table) || !table_reserve(table, table->pair_count + 1)) {
+    return NULL;
+  }
+
+  Uint32 index = table->pair_count++;
+  table->pairs[index] = *pair;
+  table_index_insert(table, index);
+  return &table->pairs[index];
+}
+
+bool XYZ_SCFTableDiff(XYZ_SCFTable* old_table,
+                      XYZ_SCFTable* new_table,
+                      XYZ_SCFChangeCallback callback,
+                      void* userdata) {
+  SDL_assert(old_table != NULL &&
+             "XYZ_SCFTableDiff: old_table cannot be NULL");
+  SDL_assert(new_table != NULL &&
+             "XYZ_SCFTableDiff: new_table cannot be NULL");
+  SDL_assert(callback != NULL && "XYZ_SCFTableDiff: callback cannot be NULL");
+
+  // tables on one side only are handed out whole, with nothing left to fail
+  // when the callback walks them
+  if (!table_expand_all(old_table) || !table_expand_all(new_table)) {
+    return false;
+  }
+
+  table_diff_state state = {.callback = callback, .userdata = userdata};
+  bool diffed = table_diff(&state, old_table, new_table);
+  SDL_free(state.data);
+  return diffed;
+}
+
+void* table_alloc(XYZ_SCFArena* arena, size_t size) {
+  if (arena != NULL) {
+    return XYZ_SCFArenaAlloc(arena, size);
+  }
+  return SDL_malloc(size);
+}
+
+Uint32 table_hash_cstr(const char* key, size_t* key_len) {
+  Uint32 hash = XYZ_SCF_FNV_OFFSET;
+  const char* c = key;
+  for (; *c != '\0'; c++) {
+    hash ^= (Uint8)*c;
+    hash *= XYZ_SCF_FNV_PRIME;
+  }
+  *key_len = c - key;
+  return hash;
+}
+
+bool table_key_equal(const XYZ_SCFPair* pair,
+                     const char* key,
+                     size_t key_len,
+                     XYZ_SCFAtom atom) {
+  if (atom != XYZ_SCF_NO_ATOM && pair->key_atom != XYZ_SCF_NO_ATOM) {
+    return pair->key_atom == atom;
+  }
+  return pair->key_len == key_len &&
+         SDL_memcmp(pair->key, key, key_len) == 0;
+}
+
+XYZ_SCFPair* table_find(XYZ_SCFTable* table, const char* key) {
+  size_t key_len = 0;
+  Uint32 hash = table_hash_cstr(key, &key_len);
+  return table_find_hashed(table, key, key_len, hash, XYZ_SCF_NO_ATOM);
+}
+
+XYZ_SCFPair* table_find_hashed(XYZ_SCFTable* table,
+                               const char* key,
+                               size_t key_len,
+                               Uint32 hash,
+                               XYZ_SCFAtom atom) {
+  if (!table_expand(table)) {
+    return NULL;
+  }
+
+  if (table->slot_count == 0) {
+    for (Uint32 i = 0; i < table->pair_count; i++) {
+      if (table_key_equal(&table->pairs[i], key, key_len, atom)) {
+        return &table->pairs[i];
+      }
+    }
+    return NULL;
+  }
+
+  Uint32 mask = table->slot_count - 1;
+  for (Uint32 i = hash & mask;; i = (i + 1) & mask) {
+    XYZ_SCFSlot* slot = &table->slots[i];
+    if (slot->index == 0) {
+      return NULL;
+    }
+
+    XYZ_SCFPair* pair = &table->pairs[slot->index - 1];
+    if (slot->hash == hash && table_key_equal(pair, key, key_len, atom)) {
+      return pair;
+    }
+  }
+}
+
+bool table_diff(table_diff_state* state,
+                XYZ_SCFTable* old_table,
+                XYZ_SCFTable* new_table) {
+  if (!table_expand(old_table) || !table_expand(new_table)) {
+    return false;
+  }
+
+  size_t base_len = state->len;
+  for (Uint32 i = 0; i < old_table->pair_count; i++) {
+    XYZ_SCFPair* cur = &old_table->pairs[i];
+    XYZ_SCFPair* other = table_find_hashed(new_table, cur->key, cur->key_len,
+                                           cur->key_hash, cur->key_atom);
+    if (other != NULL && table_value_equal(cur, other)) {
+      continue;
+    }
+
+    if (!table_diff_push(state, cur)) {
+      return false;
+    }
+
+    if (other == NULL) {
+      state->callback(state->userdata, XYZ_SCF_CHANGE_REMOVED, state->data,
+                      cur, NULL);
+    } else if (cur->value.type == XYZ_SCF_VALUE_TYPE_TABLE &&
+               other->value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+      if (!table_diff(state, cur->value.as_table, other->value.as_table)) {
+        return false;
+      }
+    } else {
+      state->callback(state->userdata, XYZ_SCF_CHANGE_CHANGED, state->data,
+                      cur, other);
+    }
+    state->len = base_len;
+  }
+
+  for (Uint32 i = 0; i < new_table->pair_count; i++) {
+    XYZ_SCFPair* cur = &new_table->pairs[i];
+    if (table_find_hashed(old_table, cur->key, cur->key_len, cur->key_hash,
+                          cur->key_atom) != NULL) {
+      continue;
+    }
+
+    if (!table_diff_push(state, cur)) {
+      return false;
+    }
+    state->callback(state->userdata, XYZ_SCF_CHANGE_ADDED, state->data, NULL,
+                    cur);
+    state->len = base_len;
+  }
+  return true;
+}
+
+bool table_diff_push(table_diff_state* state, const XYZ_SCFPair* pair) {
+  // dot, key and null terminator
+  size_t len = state->len + 1 + pair->key_len + 1;
+  if (len > state->cap) {
+    size_t cap = SDL_max(state->cap * 2, SDL_max(len, 64));
+    char* data = SDL_realloc(state->data, cap);
+    if (data == NULL) {
+      return false;
+    }
+    state->data = data;
+    state->cap = cap;
+  }
+
+  if (state->len > 0) {
+    state->data[state->len++] = '.';
+  }
+  SDL_memcpy(state->data + state->len, pair->key, pair->key_len);
+  state->len += pair->key_len;
+  state->data[state->len] = '\0';
+  return true;
+}
+
+bool table_value_equal(const XYZ_SCFPair* a, const XYZ_SCFPair* b) {
+  if (XYZ_SCFIsArrayType(a->value.type) &&
+      XYZ_SCFIsArrayType(b->value.type) && a->value.count == 0 &&
+      b->value.count == 0) {
+    return true;
+  }
+
+  if (a->value.type != b->value.type) {
+    return false;
+  }
+
+  switch (a->value.type) {
+    case XYZ_SCF_VALUE_TYPE_NIL:
+      return true;
+    case XYZ_SCF_VALUE_TYPE_BOOL:
+      return a->value.as_bool == b->value.as_bool;
+    case XYZ_SCF_VALUE_TYPE_I32:
+      return a->value.as_i32 == b->value.as_i32;
+    case XYZ_SCF_VALUE_TYPE_F32:
+      return a->value.as_f32 == b->value.as_f32;
+    case XYZ_SCF_VALUE_TYPE_STRING: {
+      size_t len = XYZ_SCFPairStringLen(a);
+      return len == XYZ_SCFPairStringLen(b) &&
+             SDL_memcmp(a->value.as_string, b->value.as_string, len) == 0;
+    }
+    case XYZ_SCF_VALUE_TYPE_TABLE:
+      return XYZ_SCFTableEqual(a->value.as_table, b->value.as_table);
+    case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+    case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+    case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+    case XYZ_SCF_VALUE_TYPE_STRING_ARRAY:
+      return table_array_equal(&a->value, &b->value);
+    default:
+      return false;
+  }
+}
+
+bool table_array_equal(const XYZ_SCFValue* a, const XYZ_SCFValue* b) {
+  if (a->count != b->count) {
+    return false;
+  }
+
+  for (Uint32 i = 0; i < a->count; i++) {
+    bool equal = false;
+    switch (a->type) {
+      case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+        equal = a->as_bools[i] == b->as_bools[i];
+        break;
+      case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+        equal = a->as_i32s[i] == b->as_i32s[i];
+        break;
+      case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+        equal = a->as_f32s[i] == b->as_f32s[i];
+        break;
+      case XYZ_SCF_VALUE_TYPE_STRING_ARRAY:
+        equal = SDL_strcmp(a->as_strings[i], b->as_strings[i]) == 0;
+        break;
+      default:
+        break;
+    }
+    if (!equal) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t table_array_item_size(XYZ_SCFValueType type) {
+  switch (type) {
+    case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+      return sizeof(bool);
+    case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+      return sizeof(Sint32);
+    case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+      return sizeof(float);
+    case XYZ_SCF_VALUE_TYPE_STRING_ARRAY:
+      return sizeof(char*);
+    default:
+      return 0;
+  }
+}
+
+bool table_array_alloc(XYZ_SCFArena* arena,
+                       XYZ_SCFValueType type,
+                       Uint32 count,
+                       size_t string_bytes,
+                       XYZ_SCFValue* value) {
+  *value = (XYZ_SCFValue){.type = type, .count = count};
+  if (count == 0) {
+    return true;
+  }
+
+  value->as_array =
+      table_alloc(arena, count * table_array_item_size(type) + string_bytes);
+  return value->as_array != NULL;
+}
+
+bool table_get_array(XYZ_SCFTable* table,
+                     const char* key,
+                     XYZ_SCFValueType type,
+                     const void** values,
+                     size_t* count) {
+  SDL_assert(table != NULL && "XYZ_SCFTableGetArray: table cannot be NULL");
+  SDL_assert(key != NULL && "XYZ_SCFTableGetArray: key cannot be NULL");
+  SDL_assert(values != NULL && "XYZ_SCFTableGetArray: values cannot be NULL");
+  SDL_assert(count != NULL && "XYZ_SCFTableGetArray: count cannot be NULL");
+
+  XYZ_SCFPair* pair = table_find(table, key);
+  if (pair == NULL) {
+    return false;
+  }
+
+  XYZ_SCFValue* value = &pair->value;
+  bool empty = XYZ_SCFIsArrayType(value->type) && value->count == 0;
+  if (value->type != type && !empty) {
+    SDL_SetError("incompatible type for key: %s", key);
+    return false;
+  }
+
+  *values = value->as_array;
+  *count = value->count;
+  return true;
+}
+
+bool table_expand(XYZ_SCFTable* table) {
+  return table->lazy == NULL || parse_lazy_block(table);
+}
+
+bool table_expand_all(XYZ_SCFTable* table) {
+  if (!table_expand(table)) {
+    return false;
+  }
+
+  for (Uint32 i = 0; i < table->pair_count; i++) {
+    XYZ_SCFValue* value = &table->pairs[i].value;
+    if (value->type == XYZ_SCF_VALUE_TYPE_TABLE &&
+        !table_expand_all(value->as_table)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void table_index_insert(XYZ_SCFTable* table, Uint32 index) {
+  if ((table->key_count + 1) * 4 > table->slot_count * 3) {
+    // the rebuild indexes all the pairs, this one included; if it fails
+    // lookups fall back to walking them
+    table_index_rebuild(table);
+    return;
+  }
+
+  const XYZ_SCFPair* pair = &table->pairs[index];
+  Uint32 mask = table->slot_count - 1;
+  for (Uint32 i = pair->key_hash & mask;; i = (i + 1) & mask) {
+    XYZ_SCFSlot* slot = &table->slots[i];
+    if (slot->index == 0) {
+      slot->hash = pair->key_hash;
+      slot->index = index + 1;
+      table->key_count++;
+      return;
+    }
+
+    // keep the first pair for duplicated keys, same as walking the pairs
+    if (slot->hash == pair->key_hash &&
+        table_key_equal(&table->pairs[slot->index - 1], pair->key,
+                        pair->key_len, pair->key_atom)) {
+      return;
+    }
+  }
+}
+
+bool table_index_rebuild(XYZ_SCFTable* table) {
+  Uint32 pair_count = table->pair_count;
+  Uint32 slot_count = XYZ_SCF_MIN_SLOTS;
+  while (slot_count < pair_count * 2) {
+    slot_count *= 2;
+  }
+
+  // with an arena the old index is simply abandoned, growth is geometric so
+  // that wastes at most as much as the final index takes
+  XYZ_SCFSlot* slots =
+      table_alloc(table->arena, slot_count * sizeof(XYZ_SCFSlot));
+  if (slots == NULL) {
+    if (table->slots != NULL && table->arena == NULL) {
+      SDL_free(table->slots);
+    }
+    table->slots = NULL;
+    table->slot_count = 0;
+    table->key_count = 0;
+    return false;
+  }
+  SDL_memset(slots, 0, slot_count * sizeof(XYZ_SCFSlot));
+
+  if (table->slots != NULL && table->arena == NULL) {
+    SDL_free(table->slots);
+  }
+  table->slots = slots;
+  table->slot_count = slot_count;
+  table->key_count = 0;
+
+  for (Uint32 i = 0; i < pair_count; i++) {
+    table_index_insert(table, i);
+  }
+  return true;
+}
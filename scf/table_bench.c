@@ -0,0 +1,171 @@
+#include <scf/table.h>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "bench.h"
+
+#define BENCH_LOOKUPS 1000000
+#define BENCH_WALKED 10000000
+
+// the pair layout before pairs were stored together: one allocation per
+// pair, another one per key and links in between
+typedef struct list_node {
+  struct list_node* next;
+  struct list_node* prev;
+  char* key;
+  Uint32 key_len;
+  Uint32 key_hash;
+  Uint32 flags;
+  XYZ_SCFValue value;
+} list_node;
+
+// baseline: the plain walk over the pairs the table did before the index
+bool scan_get(XYZ_SCFTable* table, const char* key, XYZ_SCFValue* value);
+// copy the pairs of table into a linked list allocated the way it used to be
+list_node* list_build(XYZ_SCFTable* table);
+void list_free(list_node* head);
+
+bool scan_get(XYZ_SCFTable* table, const char* key, XYZ_SCFValue* value) {
+  for (Uint32 i = 0; i < table->pair_count; i++) {
+    if (SDL_strcmp(table->pairs[i].key, key) == 0) {
+      *value = table->pairs[i].value;
+      return true;
+    }
+  }
+  return false;
+}
+
+list_node* list_build(XYZ_SCFTable* table) {
+  list_node* head = NULL;
+  list_node* tail = NULL;
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    list_node* node = SDL_calloc(1, sizeof(list_node));
+    if (node == NULL) {
+      return head;
+    }
+    node->key = SDL_strdup(cursor.pair->key);
+    node->key_len = cursor.pair->key_len;
+    node->value = cursor.pair->value;
+    node->prev = tail;
+    if (tail != NULL) {
+      tail->next = node;
+    } else {
+      head = node;
+    }
+    tail = node;
+  }
+  return head;
+}
+
+void list_free(list_node* head) {
+  while (head != NULL) {
+    list_node* next = head->next;
+    SDL_free(head->key);
+    SDL_free(head);
+    head = next;
+  }
+}
+
+int main(void) {
+  const Sint32 sizes[] = {10, 100, 1000, 10000};
+
+  for (size_t s = 0; s < SDL_arraysize(sizes); s++) {
+    Sint32 key_count = sizes[s];
+    XYZ_SCFTable* table = XYZ_SCFTableCreate();
+    char** keys = SDL_malloc(key_count * sizeof(char*));
+    if (table == NULL || keys == NULL) {
+      return 1;
+    }
+
+    for (Sint32 i = 0; i < key_count; i++) {
+      keys[i] = SDL_malloc(32);
+      SDL_snprintf(keys[i], 32, "setting_%d", i);
+      XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = i};
+      XYZ_SCFTableSet(table, keys[i], value);
+    }
+
+    // the scan is quadratic overall, keep its run short on big tables
+    Sint32 scan_lookups = SDL_min(BENCH_LOOKUPS, 100000000 / key_count);
+    Sint64 sum = 0;
+    Sint32 cursor = 0;
+    XYZ_SCFValue value = {0};
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_LOOKUPS; i++) {
+      cursor = (cursor + 7919) % key_count;
+      XYZ_SCFTableGet(table, keys[cursor], &value);
+      sum += value.as_i32;
+    }
+    double hashed = bench_elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < scan_lookups; i++) {
+      cursor = (cursor + 7919) % key_count;
+      scan_get(table, keys[cursor], &value);
+      sum += value.as_i32;
+    }
+    double scanned = bench_elapsed(start);
+
+    // handles resolved up front, as hot loops would keep them
+    XYZ_SCFKey* handles = SDL_malloc(key_count * sizeof(XYZ_SCFKey));
+    if (handles == NULL) {
+      return 1;
+    }
+    for (Sint32 i = 0; i < key_count; i++) {
+      XYZ_SCFTableResolve(table, keys[i], &handles[i]);
+    }
+
+    Sint32 got = 0;
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < BENCH_LOOKUPS; i++) {
+      cursor = (cursor + 7919) % key_count;
+      XYZ_SCFKeyGetI32(handles[cursor], &got);
+      sum += got;
+    }
+    double resolved = bench_elapsed(start);
+    SDL_free(handles);
+
+    // a full walk reading each key and value, as writers and diffs do
+    list_node* list = list_build(table);
+    Sint32 walks = SDL_max(BENCH_WALKED / key_count, 1);
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < walks; i++) {
+      XYZ_SCFCursor it = XYZ_SCFTableCursor(table);
+      while (XYZ_SCFCursorNext(&it)) {
+        sum += it.pair->value.as_i32 + it.pair->key[it.pair->key_len - 1];
+      }
+    }
+    double walked = bench_elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    for (Sint32 i = 0; i < walks; i++) {
+      for (list_node* node = list; node != NULL; node = node->next) {
+        sum += node->value.as_i32 + node->key[node->key_len - 1];
+      }
+    }
+    double linked = bench_elapsed(start);
+    list_free(list);
+
+    SDL_Log("%6d keys: handle %6.1f ns/lookup, index %8.1f ns/lookup, "
+            "scan %10.1f ns/lookup (%lld)",
+            key_count, resolved * 1e9 / BENCH_LOOKUPS,
+            hashed * 1e9 / BENCH_LOOKUPS, scanned * 1e9 / scan_lookups,
+            (long long)sum);
+    double walked_pairs = (double)walks * key_count;
+    SDL_Log("%6d keys: cursor %6.2f ns/pair, linked list %6.2f ns/pair",
+            key_count, walked * 1e9 / walked_pairs,
+            linked * 1e9 / walked_pairs);
+
+    for (Sint32 i = 0; i < key_count; i++) {
+      SDL_free(keys[i]);
+    }
+    SDL_free(keys);
+    XYZ_SCFTableDestroy(table);
+    SDL_free(table);
+  }
+
+  return 0;
+}
@@ -18,16 +18,16 @@ static void table_add(void** state) {
   XYZ_SCFPair* pair = XYZ_SCFPairCreate("key1", SDL_strlen("key1"), value);
   assert_non_null(pair);
 
-  XYZ_SCFTableAdd(table, pair);
-  assert_ptr_equal(table->head, pair);
-  assert_ptr_equal(table->tail, pair);
+  XYZ_SCFPair* added = XYZ_SCFTableAdd(table, pair);
+  assert_ptr_equal(added, &table->pairs[0]);
+  assert_int_equal(XYZ_SCFTableCount(table), 1);
 
   pair = XYZ_SCFPairCreate("key2", SDL_strlen("key2"), value);
   assert_non_null(pair);
 
-  XYZ_SCFTableAdd(table, pair);
-  assert_ptr_not_equal(table->head, pair);
-  assert_ptr_equal(table->tail, pair);
+  added = XYZ_SCFTableAdd(table, pair);
+  assert_ptr_equal(added, &table->pairs[1]);
+  assert_int_equal(XYZ_SCFTableCount(table), 2);
 
   XYZ_SCFTableDestroy(table);
   SDL_free(table);
@@ -43,16 +43,16 @@ static void table_has(void** state) {
   XYZ_SCFPair* pair = XYZ_SCFPairCreate("key1", SDL_strlen("key1"), value);
   assert_non_null(pair);
 
-  XYZ_SCFTableAdd(table, pair);
-  assert_ptr_equal(table->head, pair);
-  assert_ptr_equal(table->tail, pair);
+  XYZ_SCFPair* added = XYZ_SCFTableAdd(table, pair);
+  assert_ptr_equal(added, &table->pairs[0]);
+  assert_int_equal(XYZ_SCFTableCount(table), 1);
 
   pair = XYZ_SCFPairCreate("key2", SDL_strlen("key2"), value);
   assert_non_null(pair);
 
-  XYZ_SCFTableAdd(table, pair);
-  assert_ptr_not_equal(table->head, pair);
-  assert_ptr_equal(table->tail, pair);
+  added = XYZ_SCFTableAdd(table, pair);
+  assert_ptr_equal(added, &table->pairs[1]);
+  assert_int_equal(XYZ_SCFTableCount(table), 2);
 
   bool exists = false;
   exists = XYZ_SCFTableHas(table, "key1");
@@ -78,17 +78,17 @@ static void table_get(void** state) {
   XYZ_SCFPair* pair = XYZ_SCFPairCreate("key1", SDL_strlen("key1"), value);
   assert_non_null(pair);
 
-  XYZ_SCFTableAdd(table, pair);
-  assert_ptr_equal(table->head, pair);
-  assert_ptr_equal(table->tail, pair);
+  XYZ_SCFPair* added = XYZ_SCFTableAdd(table, pair);
+  assert_ptr_equal(added, &table->pairs[0]);
+  assert_int_equal(XYZ_SCFTableCount(table), 1);
 
   value = (XYZ_SCFValue){.type = XYZ_SCF_VALUE_TYPE_F32, .as_f32 = 69.0f};
   pair = XYZ_SCFPairCreate("key2", SDL_strlen("key2"), value);
   assert_non_null(pair);
 
-  XYZ_SCFTableAdd(table, pair);
-  assert_ptr_not_equal(table->head, pair);
-  assert_ptr_equal(table->tail, pair);
+  added = XYZ_SCFTableAdd(table, pair);
+  assert_ptr_equal(added, &table->pairs[1]);
+  assert_int_equal(XYZ_SCFTableCount(table), 2);
 
   bool success = false;
   success = XYZ_SCFTableGet(table, "key1", &value);
@@ -105,6 +105,68 @@ static void table_get(void** state) {
   SDL_free(table);
 }
 
+static void table_arrays(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  const Sint32 sizes[] = {1, 2, 3};
+  const char* names[] = {"low", "", "high"};
+  XYZ_SCFValue value = {0};
+  assert_true(XYZ_SCFArrayCreate(NULL, XYZ_SCF_VALUE_TYPE_I32_ARRAY, sizes,
+                                 3, &value));
+  assert_true(XYZ_SCFTableSet(table, "sizes", value));
+  assert_true(XYZ_SCFArrayCreate(NULL, XYZ_SCF_VALUE_TYPE_STRING_ARRAY, names,
+                                 3, &value));
+  assert_true(XYZ_SCFTableSet(table, "names", value));
+  assert_true(XYZ_SCFArrayCreate(NULL, XYZ_SCF_VALUE_TYPE_F32_ARRAY, NULL, 0,
+                                 &value));
+  assert_true(XYZ_SCFTableSet(table, "empty", value));
+
+  // the getters point into the table, which made its own copy
+  const Sint32* i32s = NULL;
+  size_t count = 0;
+  assert_true(XYZ_SCFTableGetI32Array(table, "sizes", &i32s, &count));
+  assert_int_equal(count, 3);
+  assert_ptr_not_equal(i32s, sizes);
+  assert_memory_equal(i32s, sizes, sizeof(sizes));
+
+  const char* const* strings = NULL;
+  assert_true(XYZ_SCFTableGetStringArray(table, "names", &strings, &count));
+  assert_int_equal(count, 3);
+  assert_string_equal(strings[0], "low");
+  assert_string_equal(strings[1], "");
+  assert_string_equal(strings[2], "high");
+
+  const float* f32s = NULL;
+  assert_false(XYZ_SCFTableGetF32Array(table, "sizes", &f32s, &count));
+  assert_false(XYZ_SCFTableGetF32Array(table, "missing", &f32s, &count));
+  assert_true(XYZ_SCFTableGetI32Array(table, "empty", &i32s, &count));
+  assert_int_equal(count, 0);
+
+  // equal arrays compare element by element, empty ones whatever the type
+  XYZ_SCFTable* other = XYZ_SCFTableCreate();
+  assert_true(XYZ_SCFArrayCreate(NULL, XYZ_SCF_VALUE_TYPE_I32_ARRAY, sizes,
+                                 3, &value));
+  assert_true(XYZ_SCFTableSet(other, "sizes", value));
+  assert_true(XYZ_SCFArrayCreate(NULL, XYZ_SCF_VALUE_TYPE_STRING_ARRAY, names,
+                                 3, &value));
+  assert_true(XYZ_SCFTableSet(other, "names", value));
+  assert_true(XYZ_SCFArrayCreate(NULL, XYZ_SCF_VALUE_TYPE_BOOL_ARRAY, NULL, 0,
+                                 &value));
+  assert_true(XYZ_SCFTableSet(other, "empty", value));
+  assert_true(XYZ_SCFTableEqual(table, other));
+
+  XYZ_SCFPair* pair =
+      XYZ_SCFTableFind(other, "sizes", 5, XYZ_SCFHashKey("sizes", 5));
+  pair->value.as_i32s[1] = 5;
+  assert_false(XYZ_SCFTableEqual(table, other));
+
+  XYZ_SCFTableDestroy(other);
+  SDL_free(other);
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+}
+
 static void table_set(void** state) {
   (void)state;
 
@@ -115,17 +177,17 @@ static void table_set(void** state) {
   XYZ_SCFPair* pair = XYZ_SCFPairCreate("key1", SDL_strlen("key1"), value);
   assert_non_null(pair);
 
-  XYZ_SCFTableAdd(table, pair);
-  assert_ptr_equal(table->head, pair);
-  assert_ptr_equal(table->tail, pair);
+  XYZ_SCFPair* added = XYZ_SCFTableAdd(table, pair);
+  assert_ptr_equal(added, &table->pairs[0]);
+  assert_int_equal(XYZ_SCFTableCount(table), 1);
 
   value = (XYZ_SCFValue){.type = XYZ_SCF_VALUE_TYPE_F32, .as_f32 = 69.0f};
   pair = XYZ_SCFPairCreate("key2", SDL_strlen("key2"), value);
   assert_non_null(pair);
 
-  XYZ_SCFTableAdd(table, pair);
-  assert_ptr_not_equal(table->head, pair);
-  assert_ptr_equal(table->tail, pair);
+  added = XYZ_SCFTableAdd(table, pair);
+  assert_ptr_equal(added, &table->pairs[1]);
+  assert_int_equal(XYZ_SCFTableCount(table), 2);
 
   bool success = false;
   value = (XYZ_SCFValue){.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = 4321};
@@ -149,12 +211,219 @@ static void table_set(void** state) {
   SDL_free(table);
 }
 
+static void table_index(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  assert_non_null(table);
+
+  char key[32] = {0};
+  for (Sint32 i = 0; i < 1000; i++) {
+    SDL_snprintf(key, sizeof(key), "key%d", i);
+    XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = i};
+    assert_true(XYZ_SCFTableSet(table, key, value));
+  }
+  assert_int_equal(table->key_count, 1000);
+
+  // duplicated keys keep resolving to the first pair
+  XYZ_SCFValue dup = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = -1};
+  XYZ_SCFTableAdd(table, XYZ_SCFPairCreate("key7", SDL_strlen("key7"), dup));
+  assert_int_equal(table->key_count, 1000);
+
+  XYZ_SCFValue got = {0};
+  for (Sint32 i = 0; i < 1000; i++) {
+    SDL_snprintf(key, sizeof(key), "key%d", i);
+    assert_true(XYZ_SCFTableGet(table, key, &got));
+    assert_int_equal(got.as_i32, i);
+  }
+  assert_false(XYZ_SCFTableHas(table, "key1000"));
+
+  // insertion order is kept by the pairs
+  Sint32 expected = 0;
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    assert_int_equal(cursor.pair->value.as_i32,
+                     expected < 1000 ? expected : -1);
+    expected++;
+  }
+  assert_int_equal(expected, 1001);
+  assert_false(XYZ_SCFCursorNext(&cursor));
+  assert_null(cursor.pair);
+
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+}
+
+static void table_cursor(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+  assert_false(XYZ_SCFCursorNext(&cursor));
+
+  // keys given as views are not copied
+  const char* keys = "widthheight";
+  XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = 1280};
+  XYZ_SCFPair* pair =
+      XYZ_SCFTableAppend(table, keys, 5, value, XYZ_SCF_PAIR_FLAG_KEY_VIEW);
+  assert_non_null(pair);
+  assert_ptr_equal(pair->key, keys);
+  value.as_i32 = 720;
+  pair = XYZ_SCFTableAppend(table, keys + 5, 6, value, 0);
+  assert_non_null(pair);
+  assert_ptr_not_equal(pair->key, keys + 5);
+  assert_string_equal(pair->key, "height");
+
+  // pairs added on the way are walked too, the handle outlives the growth
+  cursor = XYZ_SCFTableCursor(table);
+  assert_true(XYZ_SCFCursorNext(&cursor));
+  assert_int_equal(cursor.pair->value.as_i32, 1280);
+  XYZ_SCFKey key = XYZ_SCFCursorKey(&cursor);
+  char name[32] = {0};
+  for (Sint32 i = 0; i < 10; i++) {
+    SDL_snprintf(name, sizeof(name), "key%d", i);
+    value.as_i32 = i;
+    assert_non_null(XYZ_SCFTableAppend(table, name, SDL_strlen(name), value,
+                                       0));
+  }
+
+  Uint32 count = 1;
+  while (XYZ_SCFCursorNext(&cursor)) {
+    count++;
+  }
+  assert_int_equal(count, XYZ_SCFTableCount(table));
+  assert_int_equal(count, 12);
+
+  Sint32 width = 0;
+  assert_true(XYZ_SCFKeyGetI32(key, &width));
+  assert_int_equal(width, 1280);
+  assert_ptr_equal(XYZ_SCFKeyPair(key), &table->pairs[0]);
+
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+}
+
+static void table_key_handle(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  XYZ_SCFValue speed = {.type = XYZ_SCF_VALUE_TYPE_F32, .as_f32 = 1.5f};
+  assert_true(XYZ_SCFTableSet(table, "speed", speed));
+
+  XYZ_SCFKey key = {0};
+  assert_false(XYZ_SCFTableResolve(table, "missing", &key));
+  assert_true(XYZ_SCFTableResolve(table, "speed", &key));
+
+  float got = 0.0f;
+  assert_true(XYZ_SCFKeyGetF32(key, &got));
+  assert_float_equal(got, 1.5f, 0.0f);
+
+  Sint32 wrong = 0;
+  assert_false(XYZ_SCFKeyGetI32(key, &wrong));
+
+  // growing the table rebuilds the index, the handle keeps working
+  char name[32] = {0};
+  for (Sint32 i = 0; i < 100; i++) {
+    SDL_snprintf(name, sizeof(name), "key%d", i);
+    XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = i};
+    assert_true(XYZ_SCFTableSet(table, name, value));
+  }
+
+  // updates through the table show through the handle and the other way
+  speed.as_f32 = 2.5f;
+  assert_true(XYZ_SCFTableSet(table, "speed", speed));
+  assert_true(XYZ_SCFKeyGetF32(key, &got));
+  assert_float_equal(got, 2.5f, 0.0f);
+
+  XYZ_SCFKeySet(key, (XYZ_SCFValue){.type = XYZ_SCF_VALUE_TYPE_BOOL});
+  bool flag = true;
+  assert_true(XYZ_SCFTableGetBool(table, "speed", &flag));
+  assert_false(flag);
+  assert_int_equal(XYZ_SCFKeyValue(key)->type, XYZ_SCF_VALUE_TYPE_BOOL);
+
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+}
+
+typedef struct {
+  char log[256];
+  size_t len;
+} diff_log;
+
+static void diff_record(void* userdata,
+                        XYZ_SCFChangeKind kind,
+                        const char* path,
+                        const XYZ_SCFPair* old_pair,
+                        const XYZ_SCFPair* new_pair) {
+  diff_log* log = userdata;
+  const char kinds[] = {'+', '-', '~'};
+  assert_true((old_pair == NULL) == (kind == XYZ_SCF_CHANGE_ADDED));
+  assert_true((new_pair == NULL) == (kind == XYZ_SCF_CHANGE_REMOVED));
+  log->len += SDL_snprintf(log->log + log->len, sizeof(log->log) - log->len,
+                           "%c%s ", kinds[kind], path);
+}
+
+static XYZ_SCFTable* diff_table(const char* keys[], Sint32 values[]) {
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  XYZ_SCFTable* video = XYZ_SCFTableCreate();
+  for (Sint32 i = 0; keys[i] != NULL; i++) {
+    XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_I32, .as_i32 = values[i]};
+    assert_true(XYZ_SCFTableSet(i % 2 == 0 ? table : video, keys[i], value));
+  }
+
+  XYZ_SCFValue value = {.type = XYZ_SCF_VALUE_TYPE_TABLE, .as_table = video};
+  assert_true(XYZ_SCFTableSet(table, "video", value));
+  return table;
+}
+
+static void table_diff(void** state) {
+  (void)state;
+
+  const char* old_keys[] = {"lives", "width", "speed", "height", "gone", NULL};
+  Sint32 old_values[] = {3, 1280, 5, 720, 0};
+  const char* new_keys[] = {"lives", "width", "speed", "height", "fresh",
+                            "depth", NULL};
+  Sint32 new_values[] = {3, 1280, 6, 1080, 1, 24};
+  XYZ_SCFTable* old_table = diff_table(old_keys, old_values);
+  XYZ_SCFTable* new_table = diff_table(new_keys, new_values);
+
+  diff_log log = {0};
+  assert_true(XYZ_SCFTableDiff(old_table, new_table, diff_record, &log));
+  assert_string_equal(log.log,
+                      "~speed -gone ~video.height +video.depth +fresh ");
+
+  // no differences, no calls
+  log = (diff_log){0};
+  assert_true(XYZ_SCFTableDiff(new_table, new_table, diff_record, &log));
+  assert_int_equal(log.len, 0);
+
+  // a table replaced by a value is one change
+  XYZ_SCFValue flat = {.type = XYZ_SCF_VALUE_TYPE_BOOL};
+  XYZ_SCFTable* video = NULL;
+  assert_true(XYZ_SCFTableGetTable(new_table, "video", &video));
+  assert_true(XYZ_SCFTableSet(new_table, "video", flat));
+  assert_true(XYZ_SCFTableDiff(old_table, new_table, diff_record, &log));
+  assert_string_equal(log.log, "~speed -gone ~video +fresh ");
+
+  XYZ_SCFTableDestroy(video);
+  SDL_free(video);
+  XYZ_SCFTableDestroy(new_table);
+  SDL_free(new_table);
+  XYZ_SCFTableDestroy(old_table);
+  SDL_free(old_table);
+}
+
 int main(void) {
   const struct CMUnitTest tests[] = {
       cmocka_unit_test(table_add),  // add pair to table
       cmocka_unit_test(table_has),  // table has key
       cmocka_unit_test(table_get),  // get value using key
       cmocka_unit_test(table_set),  // set old and new value using key
+      cmocka_unit_test(table_arrays),  // packed arrays and bulk getters
+      cmocka_unit_test(table_index),  // lookups through the hash index
+      cmocka_unit_test(table_cursor),
+      cmocka_unit_test(table_key_handle),  // get and set through a handle
+      cmocka_unit_test(table_diff),  // structural diff of two tables
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,44 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "test.h"
+
+#include <SDL3/SDL_stdinc.h>
+
+XYZ_SCFTable* test_parse_with(const XYZ_SCFParser* setup,
+                              const char* src,
+                              size_t len) {
+  XYZ_SCFParser parser = {0};
+  if (setup != NULL) {
+    parser.arena = setup->arena;
+    parser.schema = setup->schema;
+    parser.flags = setup->flags;
+  }
+  XYZ_SCFParserSetFile(&parser, src, len);
+
+  XYZ_SCFTable* table = XYZ_SCFTableCreateWithArena(parser.arena);
+  assert_non_null(table);
+  if (!XYZ_SCFParseTable(&parser, table)) {
+    if (parser.arena == NULL) {
+      test_destroy(table);
+    }
+    return NULL;
+  }
+  return table;
+}
+
+XYZ_SCFTable* test_parse(const char* src) {
+  XYZ_SCFTable* table = test_parse_with(NULL, src, SDL_strlen(src));
+  assert_non_null(table);
+  return table;
+}
+
+void test_destroy(XYZ_SCFTable* table) {
+  XYZ_SCFTableDestroy(table);
+  SDL_free(table);
+}
@@ -0,0 +1,27 @@
+#ifndef XYZ_SCF_TEST_H
+#define XYZ_SCF_TEST_H
+
+#include <scf/parser.h>
+#include <scf/table.h>
+
+/**
+ * Parses len bytes of src into a new table with the arena, schema and flags
+ * of setup (NULL for none), the table comes from that arena too. Returns
+ * NULL when parsing fails, with the SDL error set.
+ */
+XYZ_SCFTable* test_parse_with(const XYZ_SCFParser* setup,
+                              const char* src,
+                              size_t len);
+
+/**
+ * Parses src into a new heap table, failing the test if it does not parse.
+ * Release it with test_destroy.
+ */
+XYZ_SCFTable* test_parse(const char* src);
+
+/**
+ * Releases a heap table and everything in it.
+ */
+void test_destroy(XYZ_SCFTable* table);
+
+#endif /* XYZ_SCF_TEST_H */
@@ -0,0 +1,275 @@
+#include "scf/writer.h"
+#include "scf/number.h"
+#include "scf/table.h"
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_stdinc.h>
+
+// longest float written: 39 integer digits, the point and up to 60 decimals
+#define XYZ_SCF_WRITER_FLOAT_MAX 128
+#define XYZ_SCF_WRITER_MIN_CAP 4096
+
+typedef struct {
+  char* data;
+  size_t len;
+  size_t cap;
+} w_buffer;
+
+// make room for len more bytes (plus a null terminator)
+bool w_reserve(w_buffer* buf, size_t len);
+bool w_append(w_buffer* buf, const char* data, size_t len);
+bool w_indent(w_buffer* buf, Uint32 depth);
+bool w_table(w_buffer* buf, XYZ_SCFTable* table, Uint32 depth);
+bool w_pair(w_buffer* buf, XYZ_SCFPair* pair, Uint32 depth);
+bool w_float(w_buffer* buf, float value);
+// "[a b c]", strings are checked the same as string values
+bool w_array(w_buffer* buf, XYZ_SCFPair* pair);
+bool w_is_word(const char* key, size_t key_len);
+
+char* XYZ_SCFTableToString(XYZ_SCFTable* table, size_t* out_len) {
+  SDL_assert(table != NULL && "XYZ_SCFTableToString: table cannot be NULL");
+  w_buffer buf = {0};
+  if (!w_reserve(&buf, XYZ_SCF_WRITER_MIN_CAP) || !w_table(&buf, table, 0)) {
+    SDL_free(buf.data);
+    return NULL;
+  }
+
+  buf.data[buf.len] = '\0';
+  if (out_len != NULL) {
+    *out_len = buf.len;
+  }
+  return buf.data;
+}
+
+bool XYZ_SCFTableWrite(XYZ_SCFTable* table, SDL_IOStream* io) {
+  SDL_assert(table != NULL && "XYZ_SCFTableWrite: table cannot be NULL");
+  SDL_assert(io != NULL && "XYZ_SCFTableWrite: io cannot be NULL");
+
+  size_t len = 0;
+  char* text = XYZ_SCFTableToString(table, &len);
+  if (text == NULL) {
+    return false;
+  }
+
+  bool written = SDL_WriteIO(io, text, len) == len;
+  SDL_free(text);
+  return written;
+}
+
+bool w_reserve(w_buffer* buf, size_t len) {
+  if (buf->len + len + 1 <= buf->cap) {
+    return true;
+  }
+
+  size_t cap = SDL_max(buf->cap * 2, buf->len + len + 1);
+  char* data = SDL_realloc(buf->data, cap);
+  if (data == NULL) {
+    return false;
+  }
+  buf->data = data;
+  buf->cap = cap;
+  return true;
+}
+
+bool w_append(w_buffer* buf, const char* data, size_t len) {
+  if (!w_reserve(buf, len)) {
+    return false;
+  }
+  SDL_memcpy(buf->data + buf->len, data, len);
+  buf->len += len;
+  return true;
+}
+
+bool w_indent(w_buffer* buf, Uint32 depth) {
+  size_t len = (size_t)depth * XYZ_SCF_WRITER_INDENT;
+  if (!w_reserve(buf, len)) {
+    return false;
+  }
+  SDL_memset(buf->data + buf->len, ' ', len);
+  buf->len += len;
+  return true;
+}
+
+bool w_table(w_buffer* buf, XYZ_SCFTable* table, Uint32 depth) {
+  // a lazy block that fails to parse is not written as an empty one
+  if (!XYZ_SCFTableExpand(table)) {
+    return false;
+  }
+
+  XYZ_SCFCursor cursor = XYZ_SCFTableCursor(table);
+  while (XYZ_SCFCursorNext(&cursor)) {
+    if (!w_pair(buf, cursor.pair, depth)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool w_pair(w_buffer* buf, XYZ_SCFPair* pair, Uint32 depth) {
+  if (!w_is_word(pair->key, pair->key_len)) {
+    SDL_SetError("cannot write key that is not an identifier: '%.*s'",
+                 (Sint32)pair->key_len, pair->key);
+    return false;
+  }
+
+  if (!w_indent(buf, depth) || !w_append(buf, pair->key, pair->key_len)) {
+    return false;
+  }
+
+  XYZ_SCFValue value = pair->value;
+  if (value.type == XYZ_SCF_VALUE_TYPE_TABLE) {
+    return w_append(buf, " {\n", 3) &&
+           w_table(buf, value.as_table, depth + 1) && w_indent(buf, depth) &&
+           w_append(buf, "}\n", 2);
+  }
+
+  if (!w_append(buf, " = ", 3)) {
+    return false;
+  }
+
+  bool written = false;
+  switch (value.type) {
+    case XYZ_SCF_VALUE_TYPE_NIL:
+      written = w_append(buf, "nil", 3);
+      break;
+    case XYZ_SCF_VALUE_TYPE_BOOL:
+      written = value.as_bool ? w_append(buf, "true", 4)
+                              : w_append(buf, "false", 5);
+      break;
+    case XYZ_SCF_VALUE_TYPE_I32:
+      if (w_reserve(buf, 12)) {
+        buf->len += SDL_snprintf(buf->data + buf->len, 12, "%d", value.as_i32);
+        written = true;
+      }
+      break;
+    case XYZ_SCF_VALUE_TYPE_F32:
+      written = w_float(buf, value.as_f32);
+      break;
+    case XYZ_SCF_VALUE_TYPE_STRING: {
+      size_t len = XYZ_SCFPairStringLen(pair);
+      for (size_t i = 0; i < len; i++) {
+        if (value.as_string[i] == '"' || value.as_string[i] == '\n' ||
+            value.as_string[i] == '\0') {
+          SDL_SetError("cannot write string with quotes or new lines: '%.*s'",
+                       (Sint32)pair->key_len, pair->key);
+          return false;
+        }
+      }
+      written = w_append(buf, "\"", 1) &&
+                w_append(buf, value.as_string, len) && w_append(buf, "\"", 1);
+      break;
+    }
+    case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+    case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+    case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+    case XYZ_SCF_VALUE_TYPE_STRING_ARRAY:
+      written = w_array(buf, pair);
+      break;
+    default:
+      SDL_SetError("cannot write value of type %d", value.type);
+      return false;
+  }
+
+  return written && w_append(buf, "\n", 1);
+}
+
+bool w_float(w_buffer* buf, float value) {
+  if (value != value || value - value != 0.0f) {
+    SDL_SetError("cannot write non finite float");
+    return false;
+  }
+
+  // shortest %g that the parser reads back to the same float
+  char digits[XYZ_SCF_WRITER_FLOAT_MAX] = {0};
+  Sint32 len = 0;
+  float back = 0.0f;
+  for (Sint32 precision = 1; precision <= 9; precision++) {
+    len = SDL_snprintf(digits, sizeof(digits), "%.*g", precision, value);
+    if (XYZ_SCFParseF32(digits, len, &back) && back == value) {
+      break;
+    }
+  }
+
+  // exponents are read too, but fixed notation is what older versions of
+  // the grammar understand
+  if (SDL_strchr(digits, 'e') != NULL) {
+    for (Sint32 precision = 1; precision <= 60; precision++) {
+      len = SDL_snprintf(digits, sizeof(digits), "%.*f", precision, value);
+      if (XYZ_SCFParseF32(digits, len, &back) && back == value) {
+        break;
+      }
+    }
+  }
+
+  // floats need a point to be lexed as such
+  if (SDL_strchr(digits, '.') == NULL) {
+    digits[len++] = '.';
+    digits[len++] = '0';
+  }
+  return w_append(buf, digits, len);
+}
+
+bool w_array(w_buffer* buf, XYZ_SCFPair* pair) {
+  XYZ_SCFValue value = pair->value;
+  if (!w_append(buf, "[", 1)) {
+    return false;
+  }
+
+  for (Uint32 i = 0; i < value.count; i++) {
+    if (i > 0 && !w_append(buf, " ", 1)) {
+      return false;
+    }
+
+    bool written = false;
+    switch (value.type) {
+      case XYZ_SCF_VALUE_TYPE_BOOL_ARRAY:
+        written = value.as_bools[i] ? w_append(buf, "true", 4)
+                                    : w_append(buf, "false", 5);
+        break;
+      case XYZ_SCF_VALUE_TYPE_I32_ARRAY:
+        if (w_reserve(buf, 12)) {
+          buf->len += SDL_snprintf(buf->data + buf->len, 12, "%d",
+                                   value.as_i32s[i]);
+          written = true;
+        }
+        break;
+      case XYZ_SCF_VALUE_TYPE_F32_ARRAY:
+        written = w_float(buf, value.as_f32s[i]);
+        break;
+      default: {
+        const char* str = value.as_strings[i];
+        size_t len = SDL_strlen(str);
+        if (SDL_strchr(str, '"') != NULL || SDL_strchr(str, '\n') != NULL) {
+          SDL_SetError("cannot write string with quotes or new lines: '%.*s'",
+                       (Sint32)pair->key_len, pair->key);
+          return false;
+        }
+        written = w_append(buf, "\"", 1) && w_append(buf, str, len) &&
+                  w_append(buf, "\"", 1);
+        break;
+      }
+    }
+
+    if (!written) {
+      return false;
+    }
+  }
+  return w_append(buf, "]", 1);
+}
+
+bool w_is_word(const char* key, size_t key_len) {
+  if (key_len == 0 || (key[0] >= '0' && key[0] <= '9')) {
+    return false;
+  }
+
+  for (size_t i = 0; i < key_len; i++) {
+    char c = key[i];
+    if (!(c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          (c >= '0' && c <= '9'))) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,231 @@
+// clang-format off
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_iostream.h>
+#include <scf/scf.h>
+#include <scf/writer.h>
+
+#include "test.h"
+
+#define TEST_FILE "writer_test_write.scf"
+
+static void writer_round_trip(void** state) {
+  (void)state;
+
+  const char* src =
+      "name = \"hero\" lives = 3 floor = -12 speed = 1.5 god = false "
+      "none = nil video { width = 1280 display { index = 2 title = \"\" } } "
+      "audio { }";
+  XYZ_SCFTable* table = test_parse(src);
+
+  size_t len = 0;
+  char* text = XYZ_SCFTableToString(table, &len);
+  assert_non_null(text);
+  assert_int_equal(SDL_strlen(text), len);
+  assert_string_equal(text,
+                      "name = \"hero\"\n"
+                      "lives = 3\n"
+                      "floor = -12\n"
+                      "speed = 1.5\n"
+                      "god = false\n"
+                      "none = nil\n"
+                      "video {\n"
+                      "  width = 1280\n"
+                      "  display {\n"
+                      "    index = 2\n"
+                      "    title = \"\"\n"
+                      "  }\n"
+                      "}\n"
+                      "audio {\n"
+                      "}\n");
+
+  XYZ_SCFTable* copy = test_parse_with(NULL, text, len);
+  assert_true(XYZ_SCFTableEqual(table, copy));
+
+  // values matter as well as keys
+  assert_true(XYZ_SCFTableSet(copy, "lives", (XYZ_SCFValue){
+                                                 .type = XYZ_SCF_VALUE_TYPE_I32,
+                                                 .as_i32 = 4,
+                                             }));
+  assert_false(XYZ_SCFTableEqual(table, copy));
+
+  SDL_free(text);
+  test_destroy(copy);
+  test_destroy(table);
+}
+
+static void writer_arrays(void** state) {
+  (void)state;
+
+  const char* src =
+      "sizes = [ 1 -2 ] scales = [0.1 2] flags = [true false] "
+      "names = [\"a b\" \"\"] empty = []";
+  XYZ_SCFTable* table = test_parse(src);
+
+  size_t len = 0;
+  char* text = XYZ_SCFTableToString(table, &len);
+  assert_non_null(text);
+  assert_string_equal(text,
+                      "sizes = [1 -2]\n"
+                      "scales = [0.1 2.0]\n"
+                      "flags = [true false]\n"
+                      "names = [\"a b\" \"\"]\n"
+                      "empty = []\n");
+
+  XYZ_SCFTable* copy = test_parse_with(NULL, text, len);
+  assert_true(XYZ_SCFTableEqual(table, copy));
+
+  SDL_free(text);
+  test_destroy(copy);
+  test_destroy(table);
+}
+
+static void writer_floats(void** state) {
+  (void)state;
+
+  const float values[] = {0.1f,    -0.5f,      100.0f, 16777216.0f,
+                          1e-20f,  3.4e38f,    -0.0f,  1.17549435e-38f,
+                          1e-45f,  3.14159274f};
+  char key[] = "f0";
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  for (size_t i = 0; i < SDL_arraysize(values); i++) {
+    key[1] = (char)('0' + i);
+    assert_true(XYZ_SCFTableSet(table, key, (XYZ_SCFValue){
+                                                .type = XYZ_SCF_VALUE_TYPE_F32,
+                                                .as_f32 = values[i],
+                                            }));
+  }
+
+  size_t len = 0;
+  char* text = XYZ_SCFTableToString(table, &len);
+  assert_non_null(text);
+
+  // shortest digits that read back, always with a point and no exponent
+  assert_non_null(SDL_strstr(text, "f0 = 0.1\n"));
+  assert_non_null(SDL_strstr(text, "f2 = 100.0\n"));
+  assert_non_null(SDL_strstr(text, "f4 = 0.00000000000000000001\n"));
+  assert_null(SDL_strchr(text, 'e'));
+
+  XYZ_SCFTable* copy = test_parse_with(NULL, text, len);
+  for (size_t i = 0; i < SDL_arraysize(values); i++) {
+    float value = 0.0f;
+    key[1] = (char)('0' + i);
+    assert_true(XYZ_SCFTableGetF32(copy, key, &value));
+    assert_memory_equal(&value, &values[i], sizeof(float));
+  }
+
+  SDL_free(text);
+  test_destroy(copy);
+  test_destroy(table);
+}
+
+static void writer_zero_copy(void** state) {
+  (void)state;
+
+  const char src[] = "title = \"view\" video { mode = \"full\" }";
+  XYZ_SCFDocument* doc = XYZ_SCFParseDocument(src, sizeof(src) - 1,
+                                              XYZ_SCF_PARSE_ZERO_COPY);
+  assert_non_null(doc);
+
+  size_t len = 0;
+  char* text = XYZ_SCFTableToString(doc->root, &len);
+  assert_non_null(text);
+  assert_string_equal(text,
+                      "title = \"view\"\n"
+                      "video {\n"
+                      "  mode = \"full\"\n"
+                      "}\n");
+
+  XYZ_SCFTable* copy = test_parse_with(NULL, text, len);
+  assert_true(XYZ_SCFTableEqual(doc->root, copy));
+
+  SDL_free(text);
+  test_destroy(copy);
+  XYZ_SCFDocumentDestroy(doc);
+}
+
+static void writer_reject(void** state) {
+  (void)state;
+
+  XYZ_SCFTable* table = XYZ_SCFTableCreate();
+  XYZ_SCFValue quote = {
+      .type = XYZ_SCF_VALUE_TYPE_STRING,
+      .as_string = SDL_strdup("say \"hi\""),
+  };
+  assert_true(XYZ_SCFTableSet(table, "quote", quote));
+  assert_null(XYZ_SCFTableToString(table, NULL));
+  test_destroy(table);
+
+  table = XYZ_SCFTableCreate();
+  assert_true(XYZ_SCFTableSet(table, "bad key", (XYZ_SCFValue){0}));
+  assert_null(XYZ_SCFTableToString(table, NULL));
+  test_destroy(table);
+
+  table = XYZ_SCFTableCreate();
+  assert_true(XYZ_SCFTableSet(table, "nan", (XYZ_SCFValue){
+                                                .type = XYZ_SCF_VALUE_TYPE_F32,
+                                                .as_f32 = SDL_sqrtf(-1.0f),
+                                            }));
+  assert_null(XYZ_SCFTableToString(table, NULL));
+  test_destroy(table);
+
+  table = XYZ_SCFTableCreate();
+  const char* names[] = {"fine", "new\nline"};
+  XYZ_SCFValue array = {0};
+  assert_true(XYZ_SCFArrayCreate(NULL, XYZ_SCF_VALUE_TYPE_STRING_ARRAY, names,
+                                 2, &array));
+  assert_true(XYZ_SCFTableSet(table, "names", array));
+  assert_null(XYZ_SCFTableToString(table, NULL));
+  test_destroy(table);
+
+  // a lazy block that does not parse is not written as an empty one
+  const char* src = "a = 1\nb {\n x = = 2\n}\n";
+  XYZ_SCFParser setup = {.flags = XYZ_SCF_PARSE_LAZY};
+  table = test_parse_with(&setup, src, SDL_strlen(src));
+  assert_non_null(table);
+  assert_null(XYZ_SCFTableToString(table, NULL));
+  XYZ_SCFPair* block = XYZ_SCFTableFind(table, "b", 1, XYZ_SCFHashKey("b", 1));
+  assert_non_null(block);
+  assert_false(XYZ_SCFTableExpand(block->value.as_table));
+  assert_int_equal(XYZ_SCFTableCount(block->value.as_table), 0);
+  test_destroy(table);
+}
+
+static void writer_io(void** state) {
+  (void)state;
+
+  const char* src = "width = 640 video { fullscreen = true gamma = 2.2 }";
+  XYZ_SCFTable* table = test_parse(src);
+
+  SDL_IOStream* io = SDL_IOFromFile(TEST_FILE, "wb");
+  assert_non_null(io);
+  assert_true(XYZ_SCFTableWrite(table, io));
+  assert_true(SDL_CloseIO(io));
+
+  XYZ_SCFDocument* doc = XYZ_SCFLoadFile(TEST_FILE, 0);
+  assert_non_null(doc);
+  assert_true(XYZ_SCFTableEqual(table, doc->root));
+
+  XYZ_SCFDocumentDestroy(doc);
+  test_destroy(table);
+  SDL_RemovePath(TEST_FILE);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(writer_round_trip),
+      cmocka_unit_test(writer_arrays),
+      cmocka_unit_test(writer_floats),
+      cmocka_unit_test(writer_zero_copy),
+      cmocka_unit_test(writer_reject),
+      cmocka_unit_test(writer_io),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}